@@ -520,6 +520,117 @@ For example:
 CV_EXPORTS_W void convertScaleAbs(InputArray src, OutputArray dst,
                                   double alpha = 1, double beta = 0);
 
+/** @brief Sequence of per-element operations for cv::transformElementwise
+
+Operations are applied in the order of the calls to the current value `x` of each element.
+Initially `x` is the element of the first input array, other input arrays are referenced by their
+index in the list passed to transformElementwise() (`*Input()` methods). Computations are performed in floating-point
+(CV_64F if any input or output array is CV_64F, CV_32F otherwise), so intermediate results are not
+saturated unless cast() is used.
+
+Scalar operands are applied per channel as in cv::add (`Scalar(5)` affects the first channel only),
+`double` operands of min()/max() are applied to all channels.
+
+@code{.cpp}
+    // dst = saturate_cast<uchar>(min(frame*0.5 + background*0.25 + 10, 200))
+    ElementwiseOps ops;
+    ops.scale(0.5).addInput(1, 0.25).add(Scalar::all(10)).min(200);
+    transformElementwise(std::vector<Mat>{frame, background}, dst, ops, CV_8U);
+@endcode
+@sa transformElementwise
+*/
+class CV_EXPORTS ElementwiseOps
+{
+public:
+    enum OpCode
+    {
+        OP_SCALE,       //!< x = x*alpha + s
+        OP_ADD,         //!< x = x + src_i*alpha
+        OP_MUL,         //!< x = x*src_i*alpha or x = x*s (i < 0)
+        OP_DIV,         //!< x = x*alpha/src_i
+        OP_RECIP,       //!< x = alpha/x
+        OP_MIN,         //!< x = min(x, src_i) or x = min(x, alpha) (i < 0)
+        OP_MAX,         //!< x = max(x, src_i) or x = max(x, alpha) (i < 0)
+        OP_ABSDIFF,     //!< x = |x - src_i| or x = |x - s| (i < 0)
+        OP_CAST         //!< x = saturate_cast<depth>(x), depth is stored in i
+    };
+
+    struct Op
+    {
+        int code;   //!< OpCode
+        int i;      //!< index of input array
+        double alpha;
+        Scalar s;
+    };
+
+    //! x = x*alpha + beta (beta is added to all channels)
+    ElementwiseOps& scale(double alpha, double beta = 0);
+    //! x = x + src_i*alpha
+    ElementwiseOps& addInput(int i, double alpha = 1);
+    //! x = x + s
+    ElementwiseOps& add(const Scalar& s);
+    //! x = x - src_i
+    ElementwiseOps& subtractInput(int i);
+    //! x = x - s
+    ElementwiseOps& subtract(const Scalar& s);
+    //! x = x*src_i*scale
+    ElementwiseOps& multiplyInput(int i, double scale = 1);
+    //! x = x*s
+    ElementwiseOps& multiply(const Scalar& s);
+    //! x = x*scale/src_i
+    ElementwiseOps& divideInput(int i, double scale = 1);
+    //! x = scale/x
+    ElementwiseOps& reciprocal(double scale = 1);
+    //! x = min(x, src_i)
+    ElementwiseOps& minInput(int i);
+    //! x = min(x, value)
+    ElementwiseOps& min(double value);
+    //! x = max(x, src_i)
+    ElementwiseOps& maxInput(int i);
+    //! x = max(x, value)
+    ElementwiseOps& max(double value);
+    //! x = |x - src_i|
+    ElementwiseOps& absdiffInput(int i);
+    //! x = |x - s|
+    ElementwiseOps& absdiff(const Scalar& s);
+    //! x = |x|
+    ElementwiseOps& abs();
+    //! x = saturate_cast<depth>(x), e.g. rounding and saturation of the intermediate value to 8-bit range
+    ElementwiseOps& cast(int depth);
+
+    const std::vector<Op>& getOps() const { return ops_; }
+    bool empty() const { return ops_.empty(); }
+    void clear() { ops_.clear(); }
+
+protected:
+    ElementwiseOps& addOp(int code, int i, double alpha, const Scalar& s = Scalar());
+    std::vector<Op> ops_;
+};
+
+/** @brief Applies a sequence of per-element operations to the arrays in a single pass.
+
+Replaces chains like Mat::convertTo, cv::multiply, cv::add, cv::min, cv::max which make a pass over
+the whole image (and a temporary image) per step: all operations are performed for a block of elements
+while it is in cache. The result is converted to the output depth with saturation.
+@code{.cpp}
+    // same as
+    //   frame.convertTo(t, CV_32F, 0.5);
+    //   cv::scaleAdd(background, 0.25, t, t);
+    //   cv::add(t, Scalar::all(10), t);
+    //   cv::min(t, 200, t);
+    //   t.convertTo(dst, CV_8U);
+    transformElementwise(std::vector<Mat>{frame, background}, dst,
+                         ElementwiseOps().scale(0.5).addInput(1, 0.25).add(Scalar::all(10)).min(200), CV_8U);
+@endcode
+@param src input array or vector of input arrays. Arrays must have the same size and number of channels (up to 4),
+depths may be different.
+@param dst output array of the same size and number of channels as the input arrays.
+@param ops sequence of operations.
+@param dtype depth of the output array; -1 means the depth of the first input array.
+@sa ElementwiseOps
+*/
+CV_EXPORTS void transformElementwise(InputArrayOfArrays src, OutputArray dst, const ElementwiseOps& ops, int dtype = -1);
+
 /** @brief Converts an array to half precision floating number.
 
 This function converts FP32 (single precision floating point) from/to FP16 (half precision floating point). CV_16S format is used to represent FP16 data.
@@ -1963,6 +2074,103 @@ will not do the work. Use SVD::solveZ instead.
 CV_EXPORTS_W bool solve(InputArray src1, InputArray src2,
                         OutputArray dst, int flags = DECOMP_LU);
 
+/** @brief Performs generalized matrix multiplication of a batch of small matrices.
+
+The function computes cv::gemm for each matrix of the batch:
+\f[\texttt{dst}_i =  \texttt{alpha} \cdot \texttt{src1}_i \cdot \texttt{src2}_i + \texttt{beta} \cdot \texttt{src3}_i\f]
+Batches are 3-dimensional single-channel N x rows x cols matrices. A 2-dimensional matrix is used
+as the same operand for all elements of the batch. Small matrices (up to 8x8) are processed with SIMD
+instructions across the batch dimension, batches are processed in parallel.
+
+@param src1 first multiplied batch of matrices (CV_32FC1 or CV_64FC1).
+@param src2 second multiplied batch of matrices of the same type as src1.
+@param alpha weight of the matrix products.
+@param src3 batch of matrices added to the products, can be empty.
+@param beta weight of src3.
+@param dst output N x rows x cols batch.
+@param flags operation flags (cv::GemmFlags)
+@sa gemm
+*/
+CV_EXPORTS_W void gemmBatched(InputArray src1, InputArray src2, double alpha,
+                              InputArray src3, double beta, OutputArray dst, int flags = 0);
+
+/** @brief Solves linear systems for a batch of small matrices.
+
+The function computes cv::solve for each system of the batch (see cv::gemmBatched for batch layout).
+#DECOMP_LU method of small systems (up to 8x8) is vectorized across the batch dimension,
+other methods call cv::solve for each system.
+
+@param src1 batch of left-hand side matrices (CV_32FC1 or CV_64FC1).
+@param src2 batch of right-hand side matrices, or a single matrix used for all systems.
+@param dst output batch of solutions. Solutions of singular systems are set to zero.
+@param flags solution method (#DecompTypes)
+@param status optional output N x 1 CV_8UC1 vector, non-zero for successfully solved systems.
+@returns true if all systems have been solved.
+@sa solve
+*/
+CV_EXPORTS_W bool solveBatched(InputArray src1, InputArray src2, OutputArray dst,
+                               int flags = DECOMP_LU, OutputArray status = noArray());
+
+/** @brief Finds the inverse or pseudo-inverse of each matrix of a batch.
+
+The function computes cv::invert for each matrix of the batch (see cv::gemmBatched for batch layout).
+#DECOMP_LU method of small matrices (up to 8x8) is vectorized across the batch dimension,
+other methods call cv::invert for each matrix.
+
+@param src batch of input matrices (CV_32FC1 or CV_64FC1).
+@param dst output batch of inverted matrices. Inverses of singular matrices are set to zero.
+@param flags inversion method (#DecompTypes)
+@param status optional output N x 1 CV_8UC1 vector, non-zero for successfully inverted matrices.
+@returns true if all matrices have been inverted.
+@sa invert
+*/
+CV_EXPORTS_W bool invertBatched(InputArray src, OutputArray dst,
+                                int flags = DECOMP_LU, OutputArray status = noArray());
+
+/** @overload
+Batch of Matx products: dst[i] = alpha*src1[i]*src2[i]
+*/
+template<typename _Tp, int m, int n, int l> static inline
+void gemmBatched(const std::vector< Matx<_Tp, m, n> >& src1, const std::vector< Matx<_Tp, n, l> >& src2,
+                 std::vector< Matx<_Tp, m, l> >& dst, double alpha = 1)
+{
+    CV_Assert(src1.size() == src2.size());
+    const int N = (int)src1.size();
+    dst.resize(N);
+    if (N == 0)
+        return;
+    Mat d = Mat(dst, false).reshape(1, {N, m, l});
+    gemmBatched(Mat(src1, false).reshape(1, {N, m, n}), Mat(src2, false).reshape(1, {N, n, l}),
+                alpha, noArray(), 0, d);
+}
+
+/** @overload */
+template<typename _Tp, int m, int n> static inline
+bool solveBatched(const std::vector< Matx<_Tp, m, m> >& src1, const std::vector< Matx<_Tp, m, n> >& src2,
+                  std::vector< Matx<_Tp, m, n> >& dst, int flags = DECOMP_LU)
+{
+    CV_Assert(src1.size() == src2.size());
+    const int N = (int)src1.size();
+    dst.resize(N);
+    if (N == 0)
+        return true;
+    Mat d = Mat(dst, false).reshape(1, {N, m, n});
+    return solveBatched(Mat(src1, false).reshape(1, {N, m, m}), Mat(src2, false).reshape(1, {N, m, n}), d, flags);
+}
+
+/** @overload */
+template<typename _Tp, int m> static inline
+bool invertBatched(const std::vector< Matx<_Tp, m, m> >& src, std::vector< Matx<_Tp, m, m> >& dst,
+                   int flags = DECOMP_LU)
+{
+    const int N = (int)src.size();
+    dst.resize(N);
+    if (N == 0)
+        return true;
+    Mat d = Mat(dst, false).reshape(1, {N, m, m});
+    return invertBatched(Mat(src, false).reshape(1, {N, m, m}), d, flags);
+}
+
 /** @brief Sorts each row or each column of a matrix.
 
 The function cv::sort sorts each matrix row or each matrix column in
@@ -2282,6 +2490,62 @@ the convolution sample in dft description.
 */
 CV_EXPORTS_W void idft(InputArray src, OutputArray dst, int flags = 0, int nonzeroRows = 0);
 
+/** @brief Reusable plan of a discrete Fourier transform of fixed size, type and flags.
+
+cv::dft factorizes the transform length, computes the twiddle factors and allocates scratch buffers
+on every call. A plan does this once for the given geometry, so applications that transform
+many arrays of the same size (for example, correlation trackers working on every video frame) only
+pay for the transform itself:
+@code
+    DFTPlan plan(Size(128, 128), CV_32FC1, DFT_COMPLEX_OUTPUT);
+    for (;;)
+    {
+        ...
+        plan.execute(patch, spectrum); // same as dft(patch, spectrum, DFT_COMPLEX_OUTPUT)
+        ...
+    }
+@endcode
+execute() can be called concurrently from several threads on the same plan. Each concurrent call
+uses its own precomputed context; contexts are kept by the plan for the next calls. Copies of a plan
+share the precomputed data.
+@sa dft, idft
+*/
+class CV_EXPORTS DFTPlan
+{
+public:
+    /** @brief Creates an empty plan. */
+    DFTPlan();
+    /** @overload
+    @param size size of the source arrays.
+    @param type type of the source arrays, CV_32FC1, CV_32FC2, CV_64FC1 or CV_64FC2.
+    @param flags transformation flags, see dft and #DftFlags.
+    @param nonzeroRows see dft.
+    */
+    DFTPlan(Size size, int type, int flags = 0, int nonzeroRows = 0);
+
+    /** @brief Precomputes the plan for the given parameters (see the constructor). */
+    void create(Size size, int type, int flags = 0, int nonzeroRows = 0);
+
+    /** @brief Transforms src into dst.
+
+    Equivalent to dft(src, dst, flags, nonzeroRows) with the parameters of the plan.
+    @param src input array of the plan size and type; it may be a ROI of a larger matrix.
+    @param dst output array whose size and type depend on the flags, see dft. It can be the same
+    array as src when the output type matches the input type.
+    */
+    void execute(InputArray src, OutputArray dst) const;
+
+    /** @brief Returns true if the plan has not been created. */
+    bool empty() const;
+    Size size() const;
+    int type() const;
+    int flags() const;
+
+    struct Impl;
+protected:
+    Ptr<Impl> p;
+};
+
 /** @brief Performs a forward or inverse discrete Cosine transform of 1D or 2D array.
 
 The function cv::dct performs a forward or inverse discrete Cosine transform (DCT) of a 1D or 2D
@@ -3076,7 +3340,15 @@ enum KmeansFlags {
         user-supplied labels instead of computing them from the initial centers. For the second and
         further attempts, use the random or semi-random centers. Use one of KMEANS_\*_CENTERS flag
         to specify the exact method.*/
-    KMEANS_USE_INITIAL_LABELS = 1
+    KMEANS_USE_INITIAL_LABELS = 1,
+    /** Mini-batch k-means (D. Sculley, "Web-scale k-means clustering", 2010): every iteration
+        updates the centers from a random subset of the samples (1024 by default, see the
+        OPENCV_KMEANS_MINI_BATCH_SIZE configuration parameter) instead of all of them, and the labels
+        of all samples are computed once at the end. It is much faster on large data sets at the cost
+        of somewhat less compact clusters. The iteration count of the termination criteria is not
+        limited to 100 in this mode. With #KMEANS_PP_CENTERS the centers are seeded on a random
+        subset of 3 batches.*/
+    KMEANS_MINI_BATCH         = 4
 };
 
 /** @example samples/cpp/kmeans.cpp
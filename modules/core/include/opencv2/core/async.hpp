@@ -9,6 +9,7 @@
 
 //#include <future>
 #include <chrono>
+#include <functional>
 
 namespace cv {
 
@@ -96,6 +97,95 @@ protected:
 };
 
 
+class CpuEvent;
+
+/** @brief Queue of CPU operations executed in order by a dedicated worker thread
+
+Operations enqueued into one stream are executed sequentially in the order of submission,
+so each operation may use results written by the previous ones. Operations from different
+streams run concurrently. Cross-stream dependencies are expressed with CpuEvent:
+waitEvent() makes all later work of the stream wait for the work recorded into the event.
+
+Copies of the object refer to the same stream. The destructor of the last copy waits for
+the enqueued operations.
+
+@code
+    Mat frame, blob;
+    CpuStream decode, preprocess;
+    CpuEvent decoded;
+
+    decode.enqueue([&](OutputArray) { frame = imread(path); });
+    decoded.record(decode);
+
+    preprocess.waitEvent(decoded);
+    AsyncArray result = preprocess.enqueue([&](OutputArray dst) {
+        resize(frame, dst, Size(224, 224));
+    });
+    // ... do other work ...
+    result.get(blob);
+@endcode
+
+If an operation throws, the exception is stored into its AsyncArray and the stream proceeds
+with the next operation.
+
+@note In OPENCV_DISABLE_THREAD_SUPPORT builds operations are executed synchronously by enqueue().
+*/
+class CV_EXPORTS CpuStream
+{
+public:
+    //! Operation: fills the (optional) result array
+    typedef std::function<void(OutputArray)> Operation;
+
+    CpuStream();
+
+    /** Enqueues operation
+    @param op operation, executed by the stream worker thread
+    @returns asynchronous result produced by the operation (empty if op doesn't write it)
+    */
+    AsyncArray enqueue(const Operation& op);
+
+    /** Makes all operations enqueued into the stream after this call wait for the work recorded into @p event.
+    Waiting for an event which has never been recorded completes immediately.
+    */
+    void waitEvent(const CpuEvent& event);
+
+    //! Blocks the calling thread until all enqueued operations are done
+    void waitForCompletion();
+
+    //! Returns true if all enqueued operations are done
+    bool queryIfComplete() const;
+
+    struct Impl;
+protected:
+    Ptr<Impl> p;
+    friend class CpuEvent;
+};
+
+/** @brief Synchronization point between CpuStream instances
+
+@sa CpuStream
+*/
+class CV_EXPORTS CpuEvent
+{
+public:
+    CpuEvent();
+
+    //! Captures the work enqueued into @p stream so far. Re-recording replaces the captured state
+    void record(CpuStream& stream);
+
+    //! Blocks the calling thread until the recorded work is done
+    void waitForCompletion() const;
+
+    //! Returns true if the recorded work is done (or nothing has been recorded)
+    bool queryIfComplete() const;
+
+    struct Impl;
+protected:
+    Ptr<Impl> p;
+    friend class CpuStream;
+};
+
+
 //! @}
 } // namespace
 #endif // OPENCV_CORE_ASYNC_HPP
@@ -121,6 +121,7 @@ CV_EXPORTS void add16s( const short* src1, size_t step1, const short* src2, size
 CV_EXPORTS void add32s( const int* src1, size_t step1, const int* src2, size_t step2, int* dst, size_t step, int width, int height, void* );
 CV_EXPORTS void add32f( const float* src1, size_t step1, const float* src2, size_t step2, float* dst, size_t step, int width, int height, void* );
 CV_EXPORTS void add64f( const double* src1, size_t step1, const double* src2, size_t step2, double* dst, size_t step, int width, int height, void* );
+CV_EXPORTS void add16f( const hfloat* src1, size_t step1, const hfloat* src2, size_t step2, hfloat* dst, size_t step, int width, int height, void* );
 
 CV_EXPORTS void sub8u( const uchar* src1, size_t step1, const uchar* src2, size_t step2, uchar* dst, size_t step, int width, int height, void* );
 CV_EXPORTS void sub8s( const schar* src1, size_t step1, const schar* src2, size_t step2, schar* dst, size_t step, int width, int height, void* );
@@ -129,6 +130,7 @@ CV_EXPORTS void sub16s( const short* src1, size_t step1, const short* src2, size
 CV_EXPORTS void sub32s( const int* src1, size_t step1, const int* src2, size_t step2, int* dst, size_t step, int width, int height, void* );
 CV_EXPORTS void sub32f( const float* src1, size_t step1, const float* src2, size_t step2, float* dst, size_t step, int width, int height, void* );
 CV_EXPORTS void sub64f( const double* src1, size_t step1, const double* src2, size_t step2, double* dst, size_t step, int width, int height, void* );
+CV_EXPORTS void sub16f( const hfloat* src1, size_t step1, const hfloat* src2, size_t step2, hfloat* dst, size_t step, int width, int height, void* );
 
 CV_EXPORTS void max8u( const uchar* src1, size_t step1, const uchar* src2, size_t step2, uchar* dst, size_t step, int width, int height, void* );
 CV_EXPORTS void max8s( const schar* src1, size_t step1, const schar* src2, size_t step2, schar* dst, size_t step, int width, int height, void* );
@@ -137,6 +139,7 @@ CV_EXPORTS void max16s( const short* src1, size_t step1, const short* src2, size
 CV_EXPORTS void max32s( const int* src1, size_t step1, const int* src2, size_t step2, int* dst, size_t step, int width, int height, void* );
 CV_EXPORTS void max32f( const float* src1, size_t step1, const float* src2, size_t step2, float* dst, size_t step, int width, int height, void* );
 CV_EXPORTS void max64f( const double* src1, size_t step1, const double* src2, size_t step2, double* dst, size_t step, int width, int height, void* );
+CV_EXPORTS void max16f( const hfloat* src1, size_t step1, const hfloat* src2, size_t step2, hfloat* dst, size_t step, int width, int height, void* );
 
 CV_EXPORTS void min8u( const uchar* src1, size_t step1, const uchar* src2, size_t step2, uchar* dst, size_t step, int width, int height, void* );
 CV_EXPORTS void min8s( const schar* src1, size_t step1, const schar* src2, size_t step2, schar* dst, size_t step, int width, int height, void* );
@@ -145,6 +148,7 @@ CV_EXPORTS void min16s( const short* src1, size_t step1, const short* src2, size
 CV_EXPORTS void min32s( const int* src1, size_t step1, const int* src2, size_t step2, int* dst, size_t step, int width, int height, void* );
 CV_EXPORTS void min32f( const float* src1, size_t step1, const float* src2, size_t step2, float* dst, size_t step, int width, int height, void* );
 CV_EXPORTS void min64f( const double* src1, size_t step1, const double* src2, size_t step2, double* dst, size_t step, int width, int height, void* );
+CV_EXPORTS void min16f( const hfloat* src1, size_t step1, const hfloat* src2, size_t step2, hfloat* dst, size_t step, int width, int height, void* );
 
 CV_EXPORTS void absdiff8u( const uchar* src1, size_t step1, const uchar* src2, size_t step2, uchar* dst, size_t step, int width, int height, void* );
 CV_EXPORTS void absdiff8s( const schar* src1, size_t step1, const schar* src2, size_t step2, schar* dst, size_t step, int width, int height, void* );
@@ -153,6 +157,7 @@ CV_EXPORTS void absdiff16s( const short* src1, size_t step1, const short* src2,
 CV_EXPORTS void absdiff32s( const int* src1, size_t step1, const int* src2, size_t step2, int* dst, size_t step, int width, int height, void* );
 CV_EXPORTS void absdiff32f( const float* src1, size_t step1, const float* src2, size_t step2, float* dst, size_t step, int width, int height, void* );
 CV_EXPORTS void absdiff64f( const double* src1, size_t step1, const double* src2, size_t step2, double* dst, size_t step, int width, int height, void* );
+CV_EXPORTS void absdiff16f( const hfloat* src1, size_t step1, const hfloat* src2, size_t step2, hfloat* dst, size_t step, int width, int height, void* );
 
 CV_EXPORTS void and8u( const uchar* src1, size_t step1, const uchar* src2, size_t step2, uchar* dst, size_t step, int width, int height, void* );
 CV_EXPORTS void or8u( const uchar* src1, size_t step1, const uchar* src2, size_t step2, uchar* dst, size_t step, int width, int height, void* );
@@ -174,6 +179,7 @@ CV_EXPORTS void mul16s( const short* src1, size_t step1, const short* src2, size
 CV_EXPORTS void mul32s( const int* src1, size_t step1, const int* src2, size_t step2, int* dst, size_t step, int width, int height, void* scale);
 CV_EXPORTS void mul32f( const float* src1, size_t step1, const float* src2, size_t step2, float* dst, size_t step, int width, int height, void* scale);
 CV_EXPORTS void mul64f( const double* src1, size_t step1, const double* src2, size_t step2, double* dst, size_t step, int width, int height, void* scale);
+CV_EXPORTS void mul16f( const hfloat* src1, size_t step1, const hfloat* src2, size_t step2, hfloat* dst, size_t step, int width, int height, void* scale);
 
 CV_EXPORTS void div8u( const uchar* src1, size_t step1, const uchar* src2, size_t step2, uchar* dst, size_t step, int width, int height, void* scale);
 CV_EXPORTS void div8s( const schar* src1, size_t step1, const schar* src2, size_t step2, schar* dst, size_t step, int width, int height, void* scale);
@@ -198,6 +204,7 @@ CV_EXPORTS void addWeighted16s( const short* src1, size_t step1, const short* sr
 CV_EXPORTS void addWeighted32s( const int* src1, size_t step1, const int* src2, size_t step2, int* dst, size_t step, int width, int height, void* scalars );
 CV_EXPORTS void addWeighted32f( const float* src1, size_t step1, const float* src2, size_t step2, float* dst, size_t step, int width, int height, void* scalars );
 CV_EXPORTS void addWeighted64f( const double* src1, size_t step1, const double* src2, size_t step2, double* dst, size_t step, int width, int height, void* scalars );
+CV_EXPORTS void addWeighted16f( const hfloat* src1, size_t step1, const hfloat* src2, size_t step2, hfloat* dst, size_t step, int width, int height, void* scalars );
 
 CV_EXPORTS void cvt16f32f( const hfloat* src, float* dst, int len );
 CV_EXPORTS void cvt32f16f( const float* src, hfloat* dst, int len );
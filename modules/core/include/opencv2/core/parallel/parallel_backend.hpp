@@ -39,6 +39,17 @@ namespace cv { namespace parallel {
  *   @snippet parallel_backend/example-openmp.cpp openmp_backend
  * - Configuration of compiler/linker options is responsibility of Application's scripts
  *
+ * #### Builtin work-stealing backend
+ *
+ * OpenCV provides builtin work-stealing scheduler without external dependencies.
+ * Each worker thread has own queue of tasks, idle threads steal tasks from other queues.
+ * Stripes of `parallel_for_()` (see `nstripes` parameter) are the minimal units of work.
+ * Unlike other backends, nested `parallel_for_()` calls are executed in parallel too.
+ *
+ * This backend is not used by default, it should be selected explicitly:
+ * - `cv::parallel::setParallelForBackend("WORKSTEALING")`
+ * - or `OPENCV_PARALLEL_BACKEND=WORKSTEALING` / `OPENCV_PARALLEL_PRIORITY_LIST=WORKSTEALING` environment variables
+ *
  *
  * ### Plugins support
  *
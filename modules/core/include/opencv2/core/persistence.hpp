@@ -56,6 +56,8 @@
 #include "opencv2/core/types.hpp"
 #include "opencv2/core/mat.hpp"
 
+#include <functional>
+
 namespace cv {
 
 /** @addtogroup core_xml
@@ -276,6 +278,9 @@ public:
 
         BASE64      = 64,     //!< flag, write rawdata in Base64 by default. (consider using WRITE_BASE64)
         WRITE_BASE64 = BASE64 | WRITE, //!< flag, enable both WRITE and BASE64
+        MAPPED_DATA = 128,    /**< flag, write data of large matrices into binary "<filename>.bin" file next to the storage.
+                                   On reading such matrices are views of memory-mapped file (data is not parsed and copied).
+                                   Size threshold is controlled by OPENCV_FILESTORAGE_MAPPED_DATA_THRESHOLD (4096 bytes) */
     };
     enum State
     {
@@ -411,6 +416,40 @@ public:
      */
     static String getDefaultObjectName(const String& filename);
 
+    /** @brief Callback of FileStorage::readStreaming()
+    @param node parsed node
+    @param parent collection containing the node. Its elements are not available (only name() and type() are valid).
+    @returns false to stop parsing
+    */
+    typedef std::function<bool(const FileNode& node, const FileNode& parent)> NodeCallback;
+
+    /** @brief Reads the storage incrementally without building the whole tree of nodes in memory.
+
+    Nodes of the specified nesting level are passed to the callback as soon as they are parsed,
+    then memory of each node is reused for the next one. So memory consumption is bounded by the size of
+    the largest reported node (plus the names of keys) instead of the size of the file.
+    Scalar nodes of upper levels are reported too, collections of upper levels are represented
+    by their elements only.
+
+    Example of processing of large annotation file with `annotations` sequence of maps:
+    @code
+    FileStorage::readStreaming("annotations.json", [&](const FileNode& node, const FileNode& parent) {
+        if (parent.name() == "annotations")
+            process((int)node["id"], node["bbox"].mat());
+        return true;
+    }, 2);
+    @endcode
+
+    @param filename Name of the file to read, or the text string with FileStorage::MEMORY flag.
+    @param callback Function which is called for each parsed node, see FileStorage::NodeCallback.
+    @param level Nesting level of reported nodes: 1 - top-level nodes, 2 - elements of top-level collections, etc.
+    @param flags FileStorage::READ with optional FileStorage::MEMORY flag.
+    @param encoding Encoding of the file, see FileStorage::open.
+    @returns true if the whole storage has been processed, false if the file can't be opened or parsing has been stopped by callback.
+    */
+    static bool readStreaming(const String& filename, const NodeCallback& callback, int level = 1,
+                              int flags = READ, const String& encoding = String());
+
     /** @brief Returns the current format.
      * @returns The current format, see FileStorage::Mode
      */
@@ -787,6 +787,8 @@ CV_EXPORTS InstrNode*   getCurrentNode();
 #define CV_INSTRUMENT_REGION_OPENCL_RUN(NAME)      CV_INSTRUMENT_REGION_META(NAME, false, ::cv::instr::TYPE_FUN, ::cv::instr::IMPL_OPENCL)
 // Diagnostic markers
 #define CV_INSTRUMENT_MARK_OPENCL(NAME)            CV_INSTRUMENT_MARK_META(::cv::instr::IMPL_OPENCL, NAME)
+
+#define CV_INSTRUMENT_PROCESSED_BYTES(...)
 #else
 #define CV_INSTRUMENT_REGION_META(...)
 
@@ -802,6 +804,9 @@ CV_EXPORTS InstrNode*   getCurrentNode();
 #define CV_INSTRUMENT_REGION_OPENCL_COMPILE(...)
 #define CV_INSTRUMENT_REGION_OPENCL_RUN(...)
 #define CV_INSTRUMENT_MARK_OPENCL(...)
+
+// Size of data processed by function with CV_INSTRUMENT_REGION() (see cv::utils::metrics)
+#define CV_INSTRUMENT_PROCESSED_BYTES(bytes)                CV_TRACE_PROCESSED_BYTES(bytes)
 #endif
 
 #ifdef __CV_AVX_GUARD
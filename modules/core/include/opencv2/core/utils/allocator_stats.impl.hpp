@@ -55,7 +55,7 @@ protected:
     typedef OPENCV_ALLOCATOR_STATS_COUNTER_TYPE counter_t;
     std::atomic<counter_t> curr, total, total_allocs, peak;
 public:
-    AllocatorStatistics() {}
+    AllocatorStatistics() : curr(0), total(0), total_allocs(0), peak(0) {}
     ~AllocatorStatistics() CV_OVERRIDE {}
 
     uint64_t getCurrentUsage() const CV_OVERRIDE { return (uint64_t)curr.load(); }
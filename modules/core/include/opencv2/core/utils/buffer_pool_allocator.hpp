@@ -0,0 +1,98 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_UTILS_BUFFER_POOL_ALLOCATOR_HPP
+#define OPENCV_CORE_UTILS_BUFFER_POOL_ALLOCATOR_HPP
+
+#include "opencv2/core/mat.hpp"
+#include "opencv2/core/bufferpool.hpp"
+#include "opencv2/core/utils/allocator_stats.hpp"
+
+namespace cv { namespace utils {
+
+//! @addtogroup core_utils
+//! @{
+
+/** @brief Host memory Mat allocator which keeps released buffers for reuse
+
+Released buffers are kept in the pool (up to getMaxReservedSize() bytes, LRU order) and returned
+by next allocations of the similar size. Per-frame processing allocates temporary buffers
+of the same sizes again and again, so the pool removes malloc/free calls and page faults on these buffers.
+
+Buffers may be released from any thread. Allocator object must outlive all Mat objects allocated by it.
+
+Use freeAllReservedBuffers() to release cached memory (e.g. on resolution change or at the end of processing).
+
+@sa MatAllocatorScope
+*/
+class CV_EXPORTS BufferPoolMatAllocator : public MatAllocator, public BufferPoolController
+{
+public:
+    /** @param maxReservedSize limit of memory which is kept in the pool. Default value is configured through
+     *  `OPENCV_BUFFER_POOL_ALLOCATOR_LIMIT` parameter (in bytes, 256Mb by default).
+     */
+    explicit BufferPoolMatAllocator(size_t maxReservedSize = (size_t)-1);
+    ~BufferPoolMatAllocator() CV_OVERRIDE;
+
+    UMatData* allocate(int dims, const int* sizes, int type,
+                       void* data, size_t* step, AccessFlag flags, UMatUsageFlags usageFlags) const CV_OVERRIDE;
+    bool allocate(UMatData* data, AccessFlag accessflags, UMatUsageFlags usageFlags) const CV_OVERRIDE;
+    void deallocate(UMatData* data) const CV_OVERRIDE;
+    BufferPoolController* getBufferPoolController(const char* id = NULL) const CV_OVERRIDE;
+
+    size_t getReservedSize() const CV_OVERRIDE;
+    size_t getMaxReservedSize() const CV_OVERRIDE;
+    void setMaxReservedSize(size_t size) CV_OVERRIDE;
+    void freeAllReservedBuffers() CV_OVERRIDE;
+
+    /** @brief Statistics of buffers which are used by Mat objects
+     *
+     * Reused buffers are counted as allocations too. Reserved (cached) memory is reported by getReservedSize().
+     */
+    AllocatorStatisticsInterface& getAllocatorStatistics() const;
+
+    class Impl;
+protected:
+    Impl* p;
+private:
+    BufferPoolMatAllocator(const BufferPoolMatAllocator&); // disabled
+    BufferPoolMatAllocator& operator=(const BufferPoolMatAllocator&); // disabled
+};
+
+/** @brief Replaces default Mat allocator for the current thread
+
+Mat buffers which are allocated on the current thread without explicitly specified allocator
+(including temporary buffers of OpenCV functions) are allocated by the passed allocator
+until the scope object is destroyed. Allocator is propagated to nested `parallel_for_()` bodies.
+Scopes may be nested.
+
+@code
+    cv::utils::BufferPoolMatAllocator pool;
+    for (;;)  // per-frame processing
+    {
+        cv::utils::MatAllocatorScope scope(&pool);
+        cv::GaussianBlur(frame, blurred, Size(5, 5), 0);
+        ...
+    }
+@endcode
+
+@note Mat objects which are allocated in the scope keep a reference to the allocator after the scope end.
+*/
+class CV_EXPORTS MatAllocatorScope
+{
+public:
+    explicit MatAllocatorScope(MatAllocator* allocator);
+    ~MatAllocatorScope();
+protected:
+    MatAllocator* prevAllocator_;
+private:
+    MatAllocatorScope(const MatAllocatorScope&); // disabled
+    MatAllocatorScope& operator=(const MatAllocatorScope&); // disabled
+};
+
+//! @}
+
+}} // namespace
+
+#endif // OPENCV_CORE_UTILS_BUFFER_POOL_ALLOCATOR_HPP
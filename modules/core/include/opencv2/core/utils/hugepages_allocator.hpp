@@ -0,0 +1,45 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_UTILS_HUGEPAGES_ALLOCATOR_HPP
+#define OPENCV_CORE_UTILS_HUGEPAGES_ALLOCATOR_HPP
+
+#include "opencv2/core/mat.hpp"
+#include "opencv2/core/utils/allocator_stats.hpp"
+
+namespace cv { namespace utils {
+
+//! @addtogroup core_utils
+//! @{
+
+/** @brief Returns Mat allocator for large buffers which uses huge pages and memory of the local NUMA node
+
+Buffers which are smaller than the threshold are allocated by fastMalloc().
+Large buffers are mapped directly from the OS:
+- with transparent huge pages hint (`madvise(MADV_HUGEPAGE)`) or from the explicitly reserved huge pages (`MAP_HUGETLB`).
+  This reduces TLB misses on processing of large images and tensors.
+- with preferred NUMA node of the calling thread (`mbind(MPOL_PREFERRED)`), so memory is not placed
+  on the node which touches the buffer first.
+
+Configuration parameters:
+- `OPENCV_HUGEPAGES_ALLOCATOR_THRESHOLD` - minimal size of buffer in bytes (default: 4Mb)
+- `OPENCV_HUGEPAGES_ALLOCATOR_MODE` - `THP` (default), `HUGETLB` (falls back to `THP` if there are no reserved pages) or `NONE` (regular pages)
+- `OPENCV_HUGEPAGES_ALLOCATOR_NUMA` - bind buffers to the NUMA node of the calling thread (default: true)
+- `OPENCV_MAT_ALLOCATOR=HUGEPAGES` - use this allocator as default Mat allocator (see Mat::setDefaultAllocator())
+
+On platforms without these features the allocator is equal to the standard one.
+*/
+CV_EXPORTS MatAllocator* getHugePagesMatAllocator();
+
+/** @brief Statistics of buffers which are mapped by getHugePagesMatAllocator()
+ *
+ * Small buffers which are forwarded to fastMalloc() are not counted.
+ */
+CV_EXPORTS AllocatorStatisticsInterface& getHugePagesAllocatorStatistics();
+
+//! @}
+
+}} // namespace
+
+#endif // OPENCV_CORE_UTILS_HUGEPAGES_ALLOCATOR_HPP
@@ -0,0 +1,74 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_CORE_UTILS_METRICS_HPP
+#define OPENCV_CORE_UTILS_METRICS_HPP
+
+#include <opencv2/core/cvdef.h>
+
+#include <string>
+#include <vector>
+
+namespace cv {
+namespace utils {
+namespace metrics {
+
+//! @addtogroup core_logging
+//! @{
+
+/** @brief Call statistics of instrumented function (CV_INSTRUMENT_REGION / CV_TRACE_FUNCTION location)
+
+Durations are collected from sampled calls only (see setSamplingPeriod()).
+Percentiles are estimated from log-linear histogram with ~12% bucket resolution.
+*/
+struct CV_EXPORTS FunctionMetrics
+{
+    std::string name;        //!< function (region) name
+    std::string filename;    //!< source file of instrumented location
+    int line;                //!< source line of instrumented location
+    int64 calls;             //!< number of calls
+    int64 sampledCalls;      //!< number of calls with measured duration
+    int64 processedBytes;    //!< input data size reported by CV_INSTRUMENT_PROCESSED_BYTES()
+    double totalMs;          //!< total duration of sampled calls
+    double meanMs;           //!< mean duration of sampled calls
+    double p50Ms;            //!< median duration
+    double p90Ms;            //!< 90th percentile of duration
+    double p99Ms;            //!< 99th percentile of duration
+    double maxMs;            //!< maximal duration
+
+    FunctionMetrics() : line(0), calls(0), sampledCalls(0), processedBytes(0),
+        totalMs(0), meanMs(0), p50Ms(0), p90Ms(0), p99Ms(0), maxMs(0) {}
+};
+
+/** @brief Enables or disables collection of function call metrics
+
+Initial value is controlled by OPENCV_METRICS environment variable (disabled by default).
+Metrics are collected from CV_INSTRUMENT_REGION() / CV_TRACE_FUNCTION() locations,
+so they are not available in builds with disabled trace or with ENABLE_INSTRUMENTATION.
+*/
+CV_EXPORTS void setEnabled(bool enabled);
+CV_EXPORTS bool isEnabled();
+
+/** @brief Measures duration of each N-th call of every function
+
+Calls counter is exact regardless of this value. Default value is 1 (OPENCV_METRICS_SAMPLING_PERIOD).
+*/
+CV_EXPORTS void setSamplingPeriod(int period);
+CV_EXPORTS int getSamplingPeriod();
+
+/** @brief Returns statistics of functions which have been called since the last reset
+
+@param[out] result metrics snapshot, functions are sorted by total duration (descending)
+@param reset clear collected statistics after snapshot
+*/
+CV_EXPORTS void getSnapshot(std::vector<FunctionMetrics>& result, bool reset = false);
+
+//! Clears collected statistics
+CV_EXPORTS void reset();
+
+//! @}
+
+}}} // namespace
+
+#endif // OPENCV_CORE_UTILS_METRICS_HPP
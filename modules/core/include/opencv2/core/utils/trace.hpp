@@ -32,6 +32,9 @@ namespace trace {
 //! Macro to trace argument value (expanded version)
 #define CV_TRACE_ARG_VALUE(arg_id, arg_name, value)
 
+//! Macro to account size of data processed by the current traced function (see cv::utils::metrics)
+#define CV_TRACE_PROCESSED_BYTES(bytes)
+
 //! @cond IGNORED
 #define CV_TRACE_NS cv::utils::trace
 
@@ -90,10 +93,22 @@ public:
     Impl* pImpl; // NULL if current region is not active
     int implFlags; // see RegionFlag, 0 if region is ignored
 
+    const LocationStaticStorage* metricsLocation; // NULL if call is not accounted in metrics
+    int64 metricsBeginTimestamp; // -1 if duration of this call is not sampled
+
     bool isActive() const { return pImpl != NULL; }
 
+    inline void addProcessedBytes(int64 bytes) const
+    {
+        if (metricsLocation)
+            addProcessedBytes_(bytes);
+    }
+
     void destroy();
 private:
+    void beginMetrics(const LocationStaticStorage& location);
+    void endMetrics();
+    void addProcessedBytes_(int64 bytes) const;
     Region(const Region&); // disabled
     Region& operator= (const Region&); // disabled
 };
@@ -227,6 +242,9 @@ CV_EXPORTS void traceArg(const TraceArg& arg, double value);
 #undef CV_TRACE_ARG
 #define CV_TRACE_ARG CV__TRACE_ARG
 
+#undef CV_TRACE_PROCESSED_BYTES
+#define CV_TRACE_PROCESSED_BYTES(bytes) __region_fn.addProcessedBytes((int64)(bytes))
+
 #endif // OPENCV_DISABLE_TRACE
 
 #ifdef OPENCV_TRACE_VERBOSE
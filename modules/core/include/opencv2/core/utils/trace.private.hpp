@@ -15,6 +15,7 @@
 
 //! @cond IGNORED
 
+#include <atomic>
 #include <deque>
 #include <ostream>
 
@@ -53,12 +54,15 @@ namespace details {
 enum RegionFlag {
     REGION_FLAG__NEED_STACK_POP = (1 << 0),
     REGION_FLAG__ACTIVE = (1 << 1),
+    REGION_FLAG__METRICS = (1 << 2),
 
     ENUM_REGION_FLAG_IMPL_FORCE_INT = INT_MAX
 };
 
 
 class TraceMessage;
+class TraceEventBuffer;
+class TraceEventWriter;
 
 class TraceStorage {
 public:
@@ -266,6 +270,7 @@ struct TraceManagerThreadLocal
 
 
     mutable cv::Ptr<TraceStorage> storage;
+    mutable cv::Ptr<TraceEventBuffer> events;  // OPENCV_TRACE_FORMAT=CHROME
 
     TraceManagerThreadLocal() :
         threadID(cv::utils::getThreadID()),
@@ -280,6 +285,7 @@ struct TraceManagerThreadLocal
     ~TraceManagerThreadLocal();
 
     TraceStorage* getStorage() const;
+    TraceEventBuffer* getEventBuffer() const;
 
     void recordLocation(const Region::LocationStaticStorage& location);
     void recordRegionEnter(const Region& region);
@@ -330,6 +336,7 @@ public:
     ~TraceManager();
 
     static bool isActivated();
+    static bool isEventRecordingActivated();
 
     Mutex mutexCreate;
     Mutex mutexCount;
@@ -337,6 +344,7 @@ public:
     TLSDataAccumulator<TraceManagerThreadLocal> tls;
 
     cv::Ptr<TraceStorage> trace_storage;
+    cv::Ptr<TraceEventWriter> event_writer;
 private:
     // disable copying
     TraceManager(const TraceManager&);
@@ -351,15 +359,44 @@ void parallelForSetRootRegion(const Region& rootRegion, const TraceManagerThread
 void parallelForAttachNestedRegion(const Region& rootRegion);
 void parallelForFinalize(const Region& rootRegion);
 
+//! records parallel_for_ stripe execution (trace events only, see OPENCV_TRACE_FORMAT)
+void traceParallelStripe(int64 beginTimestamp, int64 endTimestamp, int rangeStart, int rangeEnd);
+//! records allocator activity: size > 0 - allocation, size < 0 - deallocation (trace events only)
+void traceAllocation(int64 size);
 
 
 
 
 
 
+
+//! Lock-free call statistics of region location (see cv::utils::metrics)
+struct RegionMetrics
+{
+    // log-linear histogram of durations (ns): 8 sub-buckets per power of two, up to 2^40 ns
+    enum { SUB_BUCKETS_LOG2 = 3, SUB_BUCKETS = 1 << SUB_BUCKETS_LOG2, MAX_DURATION_LOG2 = 40,
+           BUCKETS = (MAX_DURATION_LOG2 - SUB_BUCKETS_LOG2 + 1) * SUB_BUCKETS };
+
+    std::atomic<int64> calls;
+    std::atomic<int64> sampledCalls;
+    std::atomic<int64> totalDuration;
+    std::atomic<int64> maxDuration;
+    std::atomic<int64> processedBytes;
+    std::atomic<int64> histogram[BUCKETS];
+
+    RegionMetrics() { reset(); }
+
+    void reset();
+    void addSample(int64 duration);
+
+    static int getBucket(int64 duration);
+    static int64 getBucketValue(int bucket);  // middle of bucket range
+};
+
 struct Region::LocationExtraData
 {
     int global_location_id; // 0 - region is disabled
+    RegionMetrics metrics;
 #ifdef OPENCV_WITH_ITT
     // Special fields for ITT
     __itt_string_handle* volatile ittHandle_name;
@@ -452,6 +452,68 @@ INSTANTIATE_TEST_CASE_P(/*nothing*/ , BinaryOpTest,
     )
 );
 
+///////////// Matrix expressions ////////
+
+typedef Size_MatType MatExprTest;
+
+PERF_TEST_P_(MatExprTest, absdiff_scale_add)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    cv::Mat a(sz, type), b(sz, type), c(sz, type), dst(sz, type);
+
+    declare.in(a, b, c, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() dst = abs(a - b) * 0.5 + c;
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(MatExprTest, mul_div)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    cv::Mat a(sz, type), b(sz, type), c(sz, type), dst(sz, type);
+
+    declare.in(a, b, c, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() dst = (a + b).mul(c) / (c * 2 + 1);
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/ , MatExprTest,
+    testing::Combine(
+        testing::Values(szVGA, sz1080p),
+        testing::Values(CV_32FC1, CV_32FC3, CV_64FC1)
+    )
+);
+
+typedef Size_MatType TransformElementwiseTest;
+
+PERF_TEST_P_(TransformElementwiseTest, scale_add_min)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    cv::Mat a(sz, type), b(sz, type), dst(sz, type);
+
+    declare.in(a, b, WARMUP_RNG).out(dst);
+
+    std::vector<Mat> src{a, b};
+    ElementwiseOps ops;
+    ops.scale(0.5).addInput(1, 0.25).add(Scalar::all(10)).min(200);
+    TEST_CYCLE() transformElementwise(src, dst, ops, CV_8U);
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/ , TransformElementwiseTest,
+    testing::Combine(
+        testing::Values(szVGA, sz1080p),
+        testing::Values(CV_8UC1, CV_8UC3)
+    )
+);
+
 ///////////// Mixed type arithmetics ////////
 
 typedef perf::TestBaseWithParam<std::tuple<cv::Size, std::tuple<perf::MatType, perf::MatType>>> ArithmMixedTest;
@@ -732,6 +794,52 @@ INSTANTIATE_TEST_CASE_P(/*nothing*/ , RotateTest,
     )
 );
 
+INSTANTIATE_TEST_CASE_P(UHD, RotateTest,
+    testing::Combine(
+        testing::Values(sz2160p),
+        testing::Values(ROTATE_90_CLOCKWISE, ROTATE_90_COUNTERCLOCKWISE),
+        testing::Values(CV_8UC1, CV_8UC3, CV_8UC4, CV_16UC1, CV_16UC4, CV_32FC1, CV_32FC3, CV_32FC4)
+    )
+);
+
+///////////// Transpose ////////////////////////
+
+typedef perf::TestBaseWithParam<std::tuple<cv::Size, perf::MatType>> TransposeTest;
+
+PERF_TEST_P_(TransposeTest, transpose)
+{
+    Size sz  = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    cv::Mat a(sz, type), b(sz.width, sz.height, type);
+
+    declare.in(a, WARMUP_RNG).out(b);
+
+    TEST_CYCLE() cv::transpose(a, b);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(TransposeTest, transpose_inplace)
+{
+    Size sz  = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    cv::Mat a(sz.height, sz.height, type);
+
+    declare.in(a, WARMUP_RNG).out(a);
+
+    TEST_CYCLE() cv::transpose(a, a);
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/ , TransposeTest,
+    testing::Combine(
+        testing::Values(szVGA, sz1080p, sz2160p),
+        testing::Values(CV_8UC1, CV_8UC2, CV_8UC3, CV_8UC4, CV_16UC1, CV_16UC2, CV_16UC3, CV_16UC4,
+                        CV_32FC1, CV_32FC2, CV_32FC3, CV_32FC4)
+    )
+);
+
 
 ///////////// PatchNaNs ////////////////////////
 
@@ -798,4 +906,106 @@ INSTANTIATE_TEST_CASE_P(/*nothing*/ , PatchNaNsFixture,
     )
 );
 
+///////////// Half-precision arithmetic ////////
+
+typedef Size_MatType Arithm16fTest;
+
+// arrays are not passed to declare.in()/out(): the framework computes cv::sum() of them, which has no 16f version
+
+static void makeRandomFloatMat(Mat& m, Size sz, int type, double a, double b)
+{
+    Mat tmp(sz, CV_MAKETYPE(CV_32F, CV_MAT_CN(type)));
+    randu(tmp, a, b);
+    tmp.convertTo(m, type);
+}
+
+PERF_TEST_P_(Arithm16fTest, add)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat a, b, c(sz, type);
+    makeRandomFloatMat(a, sz, type, -100, 100);
+    makeRandomFloatMat(b, sz, type, -100, 100);
+
+
+    TEST_CYCLE() cv::add(a, b, c);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(Arithm16fTest, multiply)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat a, b, c(sz, type);
+    makeRandomFloatMat(a, sz, type, -10, 10);
+    makeRandomFloatMat(b, sz, type, -10, 10);
+
+
+    TEST_CYCLE() cv::multiply(a, b, c, 0.5);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(Arithm16fTest, addWeighted)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat a, b, c(sz, type);
+    makeRandomFloatMat(a, sz, type, -100, 100);
+    makeRandomFloatMat(b, sz, type, -100, 100);
+
+
+    TEST_CYCLE() cv::addWeighted(a, 0.25, b, 0.75, 1.0, c);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(Arithm16fTest, minMaxLoc)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat a;
+    makeRandomFloatMat(a, sz, type, -100, 100);
+    double minVal = 0, maxVal = 0;
+    Point minLoc, maxLoc;
+
+
+    TEST_CYCLE() cv::minMaxLoc(a.reshape(1), &minVal, &maxVal, &minLoc, &maxLoc);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(Arithm16fTest, normL2)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat a;
+    makeRandomFloatMat(a, sz, type, -100, 100);
+
+    TEST_CYCLE() cv::norm(a, NORM_L2);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(Arithm16fTest, normDiffL1)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    Mat a, b;
+    makeRandomFloatMat(a, sz, type, -100, 100);
+    makeRandomFloatMat(b, sz, type, -100, 100);
+
+    TEST_CYCLE() cv::norm(a, b, NORM_L1);
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/ , Arithm16fTest,
+    testing::Combine(
+        testing::Values(szVGA, sz1080p),
+        testing::Values(CV_16FC1, CV_16FC3, CV_32FC1, CV_32FC3)
+    )
+);
+
 } // namespace
@@ -36,6 +36,90 @@ PERF_TEST_P(Size_MatType_FlagsType_NzeroRows, dft, TEST_MATS_DFT)
     SANITY_CHECK(dst, 1e-5, ERROR_RELATIVE);
 }
 
+///////////////////////////////////////////////////////dft large / batched////////////////////////////////////////////
+
+CV_ENUM(LargeFlagsType, 0, DFT_INVERSE, DFT_COMPLEX_OUTPUT, DFT_ROWS, DFT_ROWS|DFT_COMPLEX_OUTPUT)
+
+typedef tuple<Size, MatType, LargeFlagsType> Size_MatType_FlagsType_t;
+typedef perf::TestBaseWithParam<Size_MatType_FlagsType_t> DFT_Large;
+
+PERF_TEST_P_(DFT_Large, dft)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    int flags = get<2>(GetParam());
+
+    Mat src(sz, type);
+    Mat dst;
+
+    declare.in(src, WARMUP_RNG).time(60);
+
+    TEST_CYCLE() cv::dft(src, dst, flags);
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/ , DFT_Large,
+    testing::Combine(
+        testing::Values(Size(4096, 4096)),
+        testing::Values(CV_32FC1, CV_32FC2),
+        testing::Values(LargeFlagsType(0), LargeFlagsType(DFT_COMPLEX_OUTPUT), LargeFlagsType(DFT_INVERSE))
+    )
+);
+
+// many short real rows: spectra of signal windows / rows of filter kernels
+INSTANTIATE_TEST_CASE_P(Batched, DFT_Large,
+    testing::Combine(
+        testing::Values(Size(256, 16384), Size(1024, 4096)),
+        testing::Values(CV_32FC1, CV_64FC1),
+        testing::Values(LargeFlagsType(DFT_ROWS), LargeFlagsType(DFT_ROWS|DFT_COMPLEX_OUTPUT))
+    )
+);
+
+///////////////////////////////////////////////////////dft plan////////////////////////////////////////////////////
+
+typedef tuple<Size, MatType, bool> Size_MatType_UsePlan_t;
+typedef perf::TestBaseWithParam<Size_MatType_UsePlan_t> DFT_Plan;
+
+PERF_TEST_P_(DFT_Plan, dft)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    bool usePlan = get<2>(GetParam());
+    const int flags = type == CV_32FC1 ? DFT_COMPLEX_OUTPUT : 0;
+    const int N = 100;
+
+    Mat src(sz, type);
+    Mat dst;
+    DFTPlan plan;
+    if (usePlan)
+        plan.create(sz, type, flags);
+
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE()
+    {
+        for (int i = 0; i < N; i++)
+        {
+            if (usePlan)
+                plan.execute(src, dst);
+            else
+                cv::dft(src, dst, flags);
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+// small transforms repeated at video rate: correlation trackers
+INSTANTIATE_TEST_CASE_P(/*nothing*/ , DFT_Plan,
+    testing::Combine(
+        testing::Values(Size(32, 32), Size(64, 64), Size(100, 100), Size(128, 128)),
+        testing::Values(CV_32FC1, CV_32FC2),
+        testing::Bool()
+    )
+);
+
 ///////////////////////////////////////////////////////dct//////////////////////////////////////////////////////
 
 CV_ENUM(DCT_FlagsType, 0, DCT_INVERSE , DCT_ROWS, DCT_INVERSE|DCT_ROWS)
@@ -0,0 +1,144 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+#include "perf_precomp.hpp"
+
+// Kernels with runtime CPU dispatching (sum, mean, count_non_zero, split, merge, convert_scale).
+// "optimized" parameter compares the best available dispatch level with the baseline code (cv::setUseOptimized(false)).
+// Intermediate levels are measured by disabling features and comparing reports with modules/ts/misc/summary.py:
+//     opencv_perf_core --gtest_filter=CoreDispatch* --gtest_output=xml:avx512.xml
+//     OPENCV_CPU_DISABLE=AVX512_SKX opencv_perf_core --gtest_filter=CoreDispatch* --gtest_output=xml:avx2.xml
+
+namespace opencv_test
+{
+using namespace perf;
+
+typedef perf::TestBaseWithParam< tuple<Size, MatType, bool> > CoreDispatch;
+
+class OptimizedScope
+{
+public:
+    explicit OptimizedScope(bool flag) : prev(cv::useOptimized()) { cv::setUseOptimized(flag); }
+    ~OptimizedScope() { cv::setUseOptimized(prev); }
+private:
+    bool prev;
+};
+
+PERF_TEST_P_(CoreDispatch, sum)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    OptimizedScope scope(get<2>(GetParam()));
+
+    Mat src(sz, type);
+    Scalar s;
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE() s = cv::sum(src);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(CoreDispatch, mean)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    OptimizedScope scope(get<2>(GetParam()));
+
+    Mat src(sz, type);
+    Scalar s;
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE() s = cv::mean(src);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(CoreDispatch, countNonZero)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    OptimizedScope scope(get<2>(GetParam()));
+
+    Mat src(sz, CV_MAT_DEPTH(type));
+    int cnt = 0;
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE() cnt = cv::countNonZero(src);
+
+    CV_UNUSED(cnt);
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(CoreDispatch, split)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    OptimizedScope scope(get<2>(GetParam()));
+
+    Mat src(sz, CV_MAKETYPE(CV_MAT_DEPTH(type), 3));
+    std::vector<Mat> dst(3);
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE() cv::split(src, dst);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(CoreDispatch, merge)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    OptimizedScope scope(get<2>(GetParam()));
+
+    const int depth = CV_MAT_DEPTH(type);
+    std::vector<Mat> src(3);
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        src[i].create(sz, depth);
+        declare.in(src[i], WARMUP_RNG);
+    }
+    Mat dst;
+
+    TEST_CYCLE() cv::merge(src, dst);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(CoreDispatch, convertScale)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    OptimizedScope scope(get<2>(GetParam()));
+
+    Mat src(sz, type), dst;
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE() src.convertTo(dst, CV_32F, 0.5, 1);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(CoreDispatch, convertScaleAbs)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    OptimizedScope scope(get<2>(GetParam()));
+
+    Mat src(sz, type), dst;
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE() cv::convertScaleAbs(src, dst, 0.5, 1);
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/ , CoreDispatch,
+    testing::Combine(
+        testing::Values(szVGA, sz1080p),
+        testing::Values(CV_8UC1, CV_16UC1, CV_32SC1, CV_32FC1),
+        testing::Bool()
+    )
+);
+
+} // namespace
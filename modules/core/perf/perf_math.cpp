@@ -385,6 +385,155 @@ INSTANTIATE_TEST_CASE_P(/*nothing*/ , KMeans,
     )
 );
 
+// colour quantization and visual vocabulary sizes: full Lloyd iterations vs mini-batch
+typedef perf::TestBaseWithParam< testing::tuple<int, int, int, bool> > KMeans_Large;
+
+PERF_TEST_P_(KMeans_Large, pp)
+{
+    RNG& rng = theRNG();
+    const int K = testing::get<0>(GetParam());
+    const int dims = testing::get<1>(GetParam());
+    const int N = testing::get<2>(GetParam());
+    const int flags = KMEANS_PP_CENTERS | (testing::get<3>(GetParam()) ? KMEANS_MINI_BATCH : 0);
+
+    Mat data(N, dims, CV_32F);
+    rng.fill(data, RNG::UNIFORM, -0.1, 0.1);
+
+    Mat data0(K, dims, CV_32F);
+    rng.fill(data0, RNG::UNIFORM, -1, 1);
+
+    for (int i = 0; i < N; i++)
+    {
+        int base = rng.uniform(0, K);
+        cv::add(data0.row(base), data.row(i), data.row(i));
+    }
+
+    declare.in(data).time(60);
+
+    Mat labels, centers;
+
+    TEST_CYCLE()
+    {
+        kmeans(data, K, labels, TermCriteria(TermCriteria::MAX_ITER+TermCriteria::EPS, 30, 0),
+               1, flags, centers);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/ , KMeans_Large,
+    testing::Values(
+        // K clusters, dims, N points, mini-batch
+        testing::make_tuple(16, 3, 1000000, false),
+        testing::make_tuple(16, 3, 1000000, true),
+        testing::make_tuple(64, 3, 300000, false),
+        testing::make_tuple(64, 3, 300000, true),
+        testing::make_tuple(256, 64, 50000, false),
+        testing::make_tuple(256, 64, 50000, true)
+    )
+);
+
+}
+
+// batched API vs the loop of regular calls for each small matrix
+typedef perf::TestBaseWithParam< tuple<int, MatDepth, bool> > BatchedMatrices;
+
+static Mat batchElement(const Mat& m, int i)
+{
+    return Mat(m.size[1], m.size[2], m.type(), (void*)m.ptr(i), m.step[1]);
+}
+
+static Mat randomBatch(int N, int n, int type)
+{
+    const int sizes[] = { N, n, n };
+    Mat m(3, sizes, type);
+    randu(m, -1, 1);
+    for (int i = 0; i < N; i++)
+    {
+        Mat mi = batchElement(m, i);
+        mi += Mat::eye(n, n, type) * n;
+    }
+    return m;
+}
+
+PERF_TEST_P_(BatchedMatrices, gemm)
+{
+    const int n = get<0>(GetParam()), type = get<1>(GetParam());
+    const bool batched = get<2>(GetParam());
+    const int N = 10000;
+    Mat A = randomBatch(N, n, type), B = randomBatch(N, n, type), D = Mat(3, A.size.p, type);
+
+    TEST_CYCLE()
+    {
+        if (batched)
+            cv::gemmBatched(A, B, 1, noArray(), 0, D);
+        else
+        {
+            for (int i = 0; i < N; i++)
+            {
+                Mat Di = batchElement(D, i);
+                cv::gemm(batchElement(A, i), batchElement(B, i), 1, noArray(), 0, Di);
+            }
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
 }
 
+PERF_TEST_P_(BatchedMatrices, solve)
+{
+    const int n = get<0>(GetParam()), type = get<1>(GetParam());
+    const bool batched = get<2>(GetParam());
+    const int N = 10000;
+    Mat A = randomBatch(N, n, type), B = randomBatch(N, n, type), X = Mat(3, A.size.p, type);
+
+    TEST_CYCLE()
+    {
+        if (batched)
+            cv::solveBatched(A, B, X);
+        else
+        {
+            for (int i = 0; i < N; i++)
+            {
+                Mat Xi = batchElement(X, i);
+                cv::solve(batchElement(A, i), batchElement(B, i), Xi);
+            }
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P_(BatchedMatrices, invert)
+{
+    const int n = get<0>(GetParam()), type = get<1>(GetParam());
+    const bool batched = get<2>(GetParam());
+    const int N = 10000;
+    Mat A = randomBatch(N, n, type), D = Mat(3, A.size.p, type);
+
+    TEST_CYCLE()
+    {
+        if (batched)
+            cv::invertBatched(A, D);
+        else
+        {
+            for (int i = 0; i < N; i++)
+            {
+                Mat Di = batchElement(D, i);
+                cv::invert(batchElement(A, i), Di);
+            }
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/*nothing*/ , BatchedMatrices,
+    testing::Combine(
+        testing::Values(3, 4, 6),
+        testing::Values(CV_32F, CV_64F),
+        testing::Bool()
+    )
+);
+
 } // namespace
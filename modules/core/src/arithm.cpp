@@ -335,7 +335,7 @@ static BinaryFuncC* getMaxTab()
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::max16u), (BinaryFuncC)GET_OPTIMIZED(cv::hal::max16s),
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::max32s),
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::max32f), (BinaryFuncC)cv::hal::max64f,
-        0
+        (BinaryFuncC)cv::hal::max16f
     };
 
     return maxTab;
@@ -349,7 +349,7 @@ static BinaryFuncC* getMinTab()
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::min16u), (BinaryFuncC)GET_OPTIMIZED(cv::hal::min16s),
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::min32s),
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::min32f), (BinaryFuncC)cv::hal::min64f,
-        0
+        (BinaryFuncC)cv::hal::min16f
     };
 
     return minTab;
@@ -666,7 +666,7 @@ static void arithm_op(InputArray _src1, InputArray _src2, OutputArray _dst,
         {
             Mat sc = psrc2->getMat();
             depth2 = actualScalarDepth(sc.ptr<double>(), sz2 == Size(1, 1) ? cn2 : cn);
-            if( depth2 == CV_64F && (depth1 < CV_32S || depth1 == CV_32F) )
+            if( depth2 == CV_64F && (depth1 < CV_32S || depth1 == CV_32F || depth1 == CV_16F) )
                 depth2 = CV_32F;
         }
         else
@@ -708,6 +708,11 @@ static void arithm_op(InputArray _src1, InputArray _src2, OutputArray _dst,
         wtype = std::max(wtype, dtype);
     }
 
+    // CV_16F is the largest depth value, but not the widest type: native 16f kernels
+    // are only used when everything is 16f, otherwise the operation is done in 32f/64f
+    if( wtype == CV_16F && !(depth1 == CV_16F && depth2 == CV_16F && dtype == CV_16F) )
+        wtype = depth1 == CV_64F || depth2 == CV_64F || dtype == CV_64F ? CV_64F : CV_32F;
+
     dtype = CV_MAKETYPE(dtype, cn);
     wtype = CV_MAKETYPE(wtype, cn);
 
@@ -914,7 +919,7 @@ static BinaryFuncC* getAddTab()
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::add16u), (BinaryFuncC)GET_OPTIMIZED(cv::hal::add16s),
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::add32s),
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::add32f), (BinaryFuncC)cv::hal::add64f,
-        0
+        (BinaryFuncC)cv::hal::add16f
     };
 
     return addTab;
@@ -954,7 +959,7 @@ static BinaryFuncC* getSubTab()
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::sub16u), (BinaryFuncC)GET_OPTIMIZED(cv::hal::sub16s),
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::sub32s),
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::sub32f), (BinaryFuncC)cv::hal::sub64f,
-        0
+        (BinaryFuncC)cv::hal::sub16f
     };
 
     return subTab;
@@ -984,7 +989,7 @@ static BinaryFuncC* getAbsDiffTab()
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::absdiff16u), (BinaryFuncC)GET_OPTIMIZED(cv::hal::absdiff16s),
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::absdiff32s),
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::absdiff32f), (BinaryFuncC)cv::hal::absdiff64f,
-        0
+        (BinaryFuncC)cv::hal::absdiff16f
     };
 
     return absDiffTab;
@@ -1090,7 +1095,7 @@ static BinaryFuncC* getMulTab()
     {
         (BinaryFuncC)cv::hal::mul8u, (BinaryFuncC)cv::hal::mul8s, (BinaryFuncC)cv::hal::mul16u,
         (BinaryFuncC)cv::hal::mul16s, (BinaryFuncC)cv::hal::mul32s, (BinaryFuncC)cv::hal::mul32f,
-        (BinaryFuncC)cv::hal::mul64f, 0
+        (BinaryFuncC)cv::hal::mul64f, (BinaryFuncC)cv::hal::mul16f
     };
 
     return mulTab;
@@ -1193,7 +1198,7 @@ static BinaryFuncC* getAddWeightedTab()
     {
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::addWeighted8u), (BinaryFuncC)GET_OPTIMIZED(cv::hal::addWeighted8s), (BinaryFuncC)GET_OPTIMIZED(cv::hal::addWeighted16u),
         (BinaryFuncC)GET_OPTIMIZED(cv::hal::addWeighted16s), (BinaryFuncC)GET_OPTIMIZED(cv::hal::addWeighted32s), (BinaryFuncC)cv::hal::addWeighted32f,
-        (BinaryFuncC)cv::hal::addWeighted64f, 0
+        (BinaryFuncC)cv::hal::addWeighted64f, (BinaryFuncC)cv::hal::addWeighted16f
     };
 
     return addWeightedTab;
@@ -1926,6 +1926,149 @@ void recip_loop<double, v_float64>(const double* src1, size_t step1, double* dst
 
 DEFINE_SIMD_ALL(recip, recip_loop)
 
+//=======================================
+// Half-precision floating point
+//=======================================
+
+#ifdef ARITHM_DEFINITIONS_ONLY
+
+// hfloat lanes are widened to v_float32 on load, processed by the 32f operations
+// and narrowed back on store, so no 32f copies of the arrays are made
+
+template<template<typename T1, typename Tvec> class OP>
+static void bin_loop16f(const hfloat* src1, size_t step1, const hfloat* src2, size_t step2,
+                        hfloat* dst, size_t step, int width, int height)
+{
+    typedef OP<float, v_float32> op;
+
+    step1 /= sizeof(hfloat);
+    step2 /= sizeof(hfloat);
+    step  /= sizeof(hfloat);
+
+    for (; height--; src1 += step1, src2 += step2, dst += step)
+    {
+        int x = 0;
+
+    #if (CV_SIMD || CV_SIMD_SCALABLE)
+        const int wide_step = VTraits<v_float32>::vlanes();
+        for (; x <= width - wide_step*2; x += wide_step*2)
+        {
+            v_float32 r0 = op::r(vx_load_expand(src1 + x), vx_load_expand(src2 + x));
+            v_float32 r1 = op::r(vx_load_expand(src1 + x + wide_step), vx_load_expand(src2 + x + wide_step));
+            v_pack_store(dst + x, r0);
+            v_pack_store(dst + x + wide_step, r1);
+        }
+    #endif
+
+        for (; x < width; x++)
+            dst[x] = hfloat(op::r((float)src1[x], (float)src2[x]));
+    }
+
+    vx_cleanup();
+}
+
+template<template<typename T1, typename T2, typename Tvec> class OP>
+static void scalar_loop16f(const hfloat* src1, size_t step1, const hfloat* src2, size_t step2,
+                           hfloat* dst, size_t step, int width, int height, const float* scalar)
+{
+    typedef OP<float, float, v_float32> op;
+
+    step1 /= sizeof(hfloat);
+    step2 /= sizeof(hfloat);
+    step  /= sizeof(hfloat);
+
+    for (; height--; src1 += step1, src2 += step2, dst += step)
+    {
+        int x = 0;
+
+    #if (CV_SIMD || CV_SIMD_SCALABLE)
+        const int wide_step = VTraits<v_float32>::vlanes();
+        for (; x <= width - wide_step*2; x += wide_step*2)
+        {
+            v_float32 r0 = op::r(vx_load_expand(src1 + x), vx_load_expand(src2 + x), scalar);
+            v_float32 r1 = op::r(vx_load_expand(src1 + x + wide_step), vx_load_expand(src2 + x + wide_step), scalar);
+            v_pack_store(dst + x, r0);
+            v_pack_store(dst + x + wide_step, r1);
+        }
+    #endif
+
+        for (; x < width; x++)
+            dst[x] = hfloat(op::r((float)src1[x], (float)src2[x], scalar));
+    }
+
+    vx_cleanup();
+}
+
+static void mul_loop16f(const hfloat* src1, size_t step1, const hfloat* src2, size_t step2,
+                        hfloat* dst, size_t step, int width, int height, const double* scalar)
+{
+    float fscalar = (float)*scalar;
+    if (std::fabs(fscalar - 1.0f) <= FLT_EPSILON)
+        bin_loop16f<op_mul>(src1, step1, src2, step2, dst, step, width, height);
+    else
+        scalar_loop16f<op_mul_scale>(src1, step1, src2, step2, dst, step, width, height, &fscalar);
+}
+
+static void add_weighted_loop16f(const hfloat* src1, size_t step1, const hfloat* src2, size_t step2,
+                                 hfloat* dst, size_t step, int width, int height, const double* scalars)
+{
+    float fscalars[] = {(float)scalars[0], (float)scalars[1], (float)scalars[2]};
+    if (fscalars[1] == 1.0f && fscalars[2] == 0.0f)
+        scalar_loop16f<op_add_scale>(src1, step1, src2, step2, dst, step, width, height, fscalars);
+    else
+        scalar_loop16f<op_add_weighted>(src1, step1, src2, step2, dst, step, width, height, fscalars);
+}
+
+#endif // ARITHM_DEFINITIONS_ONLY
+
+//////////////////////////////////////////////////////////////////////////
+
+#undef DEFINE_BIN_16F
+#undef DEFINE_SCALAR_16F
+#if defined(ARITHM_DISPATCHING_ONLY)
+    #define DEFINE_BIN_16F(fun, _OP)                                           \
+        void fun(BIN_ARGS(hfloat), void*)                                      \
+        {                                                                      \
+            CV_INSTRUMENT_REGION();                                            \
+            CV_CPU_DISPATCH(fun, (BIN_ARGS_PASS), CV_CPU_DISPATCH_MODES_ALL);  \
+        }
+    #define DEFINE_SCALAR_16F(fun, _LOOP)                                      \
+        void fun(BIN_ARGS(hfloat), void* scalar)                               \
+        {                                                                      \
+            CV_INSTRUMENT_REGION();                                            \
+            CV_CPU_DISPATCH(fun, (BIN_ARGS_PASS, (const double*)scalar),       \
+                CV_CPU_DISPATCH_MODES_ALL);                                    \
+        }
+#elif defined(ARITHM_DEFINITIONS_ONLY)
+    #define DEFINE_BIN_16F(fun, _OP)                 \
+        void fun(BIN_ARGS(hfloat));                  \
+        void fun(BIN_ARGS(hfloat))                   \
+        {                                            \
+            CV_INSTRUMENT_REGION();                  \
+            bin_loop16f<_OP>(BIN_ARGS_PASS);         \
+        }
+    #define DEFINE_SCALAR_16F(fun, _LOOP)                     \
+        void fun(BIN_ARGS(hfloat), const double* scalar);     \
+        void fun(BIN_ARGS(hfloat), const double* scalar)      \
+        {                                                     \
+            CV_INSTRUMENT_REGION();                           \
+            _LOOP(BIN_ARGS_PASS, scalar);                     \
+        }
+#else
+    #define DEFINE_BIN_16F(fun, _OP) \
+        void fun(BIN_ARGS(hfloat));
+    #define DEFINE_SCALAR_16F(fun, _LOOP) \
+        void fun(BIN_ARGS(hfloat), const double* scalar);
+#endif
+
+DEFINE_BIN_16F(add16f, op_add)
+DEFINE_BIN_16F(sub16f, op_sub)
+DEFINE_BIN_16F(min16f, op_min)
+DEFINE_BIN_16F(max16f, op_max)
+DEFINE_BIN_16F(absdiff16f, op_absdiff)
+DEFINE_SCALAR_16F(mul16f, mul_loop16f)
+DEFINE_SCALAR_16F(addWeighted16f, add_weighted_loop16f)
+
 #ifndef ARITHM_DISPATCHING_ONLY
     CV_CPU_OPTIMIZATION_NAMESPACE_END
 #endif
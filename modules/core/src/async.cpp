@@ -18,6 +18,8 @@
 #include <mutex>
 #include <condition_variable>
 #include <chrono>
+#include <deque>
+#include <thread>
 
 namespace cv {
 
@@ -177,6 +179,19 @@ struct AsyncArray::Impl
         cond_var.notify_all();
     }
 
+    // takes ownership of the data without copying
+    void moveValue(Mat& value)
+    {
+        if (future_is_returned && refcount_future == 0)
+            CV_Error(Error::StsError, "Associated AsyncArray has been destroyed");
+        std::unique_lock<std::mutex> lock(mtx);
+        CV_Assert(!has_result);
+        result_mat = makePtr<Mat>();
+        std::swap(*result_mat.get(), value);
+        has_result = true;
+        cond_var.notify_all();
+    }
+
 #if CV__EXCEPTION_PTR
     void setException(std::exception_ptr e)
     {
@@ -341,6 +356,16 @@ struct AsyncArray::Impl
         has_result = true;
     }
 
+    void moveValue(Mat& value)
+    {
+        if (future_is_returned && refcount_future == 0)
+            CV_Error(Error::StsError, "Associated AsyncArray has been destroyed");
+        CV_Assert(!has_result);
+        result_mat = makePtr<Mat>();
+        std::swap(*result_mat.get(), value);
+        has_result = true;
+    }
+
 #if CV__EXCEPTION_PTR
     void setException(std::exception_ptr e)
     {
@@ -496,4 +521,255 @@ void AsyncPromise::setException(std::exception_ptr exception)
 }
 #endif
 
+
+
+//
+// CpuStream / CpuEvent
+//
+
+typedef std::function<void()> CpuStreamTask;
+
+static void runStreamOperation(const CpuStream::Operation& op, AsyncPromise& promise)
+{
+    AsyncArray::Impl* impl = (AsyncArray::Impl*)promise._getImpl();
+    try
+    {
+        Mat dst;
+        try
+        {
+            op(dst);
+        }
+        catch (const cv::Exception& e)
+        {
+            impl->setException(e);
+            return;
+        }
+#if CV__EXCEPTION_PTR
+        catch (...)
+        {
+            impl->setException(std::current_exception());
+            return;
+        }
+#else
+        catch (const std::exception& e)
+        {
+            impl->setException(cv::Exception(Error::StsError, e.what(), CV_Func, __FILE__, __LINE__));
+            return;
+        }
+#endif
+        impl->moveValue(dst);
+    }
+    catch (const cv::Exception&)
+    {
+        // associated AsyncArray has been released: the result is not needed
+    }
+}
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+
+struct CpuEventSignal
+{
+    std::mutex mtx;
+    std::condition_variable cond_var;
+    bool done;
+
+    CpuEventSignal() : done(false) {}
+
+    void set()
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        done = true;
+        cond_var.notify_all();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        cond_var.wait(lock, [&]{ return done; });
+    }
+
+    bool query()
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        return done;
+    }
+};
+
+struct CpuEvent::Impl
+{
+    std::mutex mtx;
+    Ptr<CpuEventSignal> signal;
+
+    Ptr<CpuEventSignal> get()
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        return signal;
+    }
+};
+
+struct CpuStream::Impl
+{
+    std::mutex mtx;
+    std::condition_variable cond_task;
+    std::condition_variable cond_done;
+    std::deque<CpuStreamTask> tasks;
+    size_t submitted;
+    size_t completed;
+    bool stop;
+    std::thread worker;
+
+    Impl() : submitted(0), completed(0), stop(false)
+    {
+        worker = std::thread(&Impl::run, this);
+    }
+
+    ~Impl()
+    {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            stop = true;
+        }
+        cond_task.notify_all();
+        // the last reference may be dropped by an operation running on the worker itself
+        if (worker.get_id() == std::this_thread::get_id())
+            worker.detach();
+        else
+            worker.join();
+    }
+
+    void push(CpuStreamTask&& task)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            tasks.push_back(std::move(task));
+            submitted++;
+        }
+        cond_task.notify_one();
+    }
+
+    void run()
+    {
+        for (;;)
+        {
+            CpuStreamTask task;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                // pending operations are drained before the worker exits
+                cond_task.wait(lock, [&]{ return stop || !tasks.empty(); });
+                if (tasks.empty())
+                    return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+            task = CpuStreamTask();
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                completed++;
+            }
+            cond_done.notify_all();
+        }
+    }
+
+    void waitForCompletion()
+    {
+        CV_Assert(worker.get_id() != std::this_thread::get_id() && "CpuStream can't wait for itself");
+        std::unique_lock<std::mutex> lock(mtx);
+        const size_t target = submitted;
+        cond_done.wait(lock, [&]{ return completed >= target; });
+    }
+
+    bool queryIfComplete()
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        return completed == submitted;
+    }
+};
+
+CpuStream::CpuStream()
+    : p(makePtr<Impl>())
+{
+}
+
+AsyncArray CpuStream::enqueue(const Operation& op)
+{
+    CV_Assert(op);
+    Ptr<AsyncPromise> promise = makePtr<AsyncPromise>();
+    AsyncArray result = promise->getArrayResult();
+    p->push([op, promise]() { runStreamOperation(op, *promise); });
+    return result;
+}
+
+void CpuStream::waitEvent(const CpuEvent& event)
+{
+    Ptr<CpuEventSignal> signal = event.p->get();
+    if (!signal)
+        return;
+    p->push([signal]() { signal->wait(); });
+}
+
+void CpuStream::waitForCompletion()
+{
+    p->waitForCompletion();
+}
+
+bool CpuStream::queryIfComplete() const
+{
+    return p->queryIfComplete();
+}
+
+CpuEvent::CpuEvent()
+    : p(makePtr<Impl>())
+{
+}
+
+void CpuEvent::record(CpuStream& stream)
+{
+    Ptr<CpuEventSignal> signal = makePtr<CpuEventSignal>();
+    stream.p->push([signal]() { signal->set(); });
+    std::unique_lock<std::mutex> lock(p->mtx);
+    p->signal = signal;
+}
+
+void CpuEvent::waitForCompletion() const
+{
+    Ptr<CpuEventSignal> signal = p->get();
+    if (signal)
+        signal->wait();
+}
+
+bool CpuEvent::queryIfComplete() const
+{
+    Ptr<CpuEventSignal> signal = p->get();
+    return !signal || signal->query();
+}
+
+#else  // OPENCV_DISABLE_THREAD_SUPPORT
+
+// no threading: operations are executed by enqueue(), so all events are always complete
+struct CpuStream::Impl {};
+struct CpuEvent::Impl {};
+
+CpuStream::CpuStream() : p(makePtr<Impl>()) {}
+
+AsyncArray CpuStream::enqueue(const Operation& op)
+{
+    CV_Assert(op);
+    AsyncPromise promise;
+    AsyncArray result = promise.getArrayResult();
+    runStreamOperation(op, promise);
+    return result;
+}
+
+void CpuStream::waitEvent(const CpuEvent&) {}
+void CpuStream::waitForCompletion() {}
+bool CpuStream::queryIfComplete() const { return true; }
+
+CpuEvent::CpuEvent() : p(makePtr<Impl>()) {}
+void CpuEvent::record(CpuStream&) {}
+void CpuEvent::waitForCompletion() const {}
+bool CpuEvent::queryIfComplete() const { return true; }
+
+#endif  // OPENCV_DISABLE_THREAD_SUPPORT
+
 } // namespace
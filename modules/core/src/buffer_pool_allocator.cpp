@@ -0,0 +1,288 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "opencv2/core/utils/buffer_pool_allocator.hpp"
+
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/logger.defines.hpp>
+#include <opencv2/core/utils/logger.hpp>
+
+#include "opencv2/core/utils/allocator_stats.impl.hpp"
+
+#include <list>
+
+namespace cv { namespace utils {
+
+static size_t getDefaultMaxReservedSize()
+{
+    static size_t g_maxReservedSize = utils::getConfigurationParameterSizeT("OPENCV_BUFFER_POOL_ALLOCATOR_LIMIT", (size_t)256 << 20);
+    return g_maxReservedSize;
+}
+
+// Buffer layout: [header: capacity (CV_MALLOC_ALIGN bytes)][data: capacity bytes]
+// Header keeps alignment of data.
+static const size_t BUFFER_HEADER_SIZE = CV_MALLOC_ALIGN;
+
+static inline size_t& bufferCapacity(uchar* data)
+{
+    return *(size_t*)(data - BUFFER_HEADER_SIZE);
+}
+
+class BufferPoolMatAllocator::Impl
+{
+public:
+    struct BufferEntry
+    {
+        uchar* data;
+        size_t capacity;
+    };
+
+    Impl(size_t maxReservedSize_)
+        : currentReservedSize(0), maxReservedSize(maxReservedSize_)
+    {
+        // nothing
+    }
+
+    ~Impl()
+    {
+        freeAllReservedBuffers();
+    }
+
+    uchar* allocate(size_t size)
+    {
+        {
+            AutoLock lock(mutex);
+            if (maxReservedSize > 0)
+            {
+                uchar* data = findAndRemoveReservedEntry(size);
+                if (data)
+                    return data;
+            }
+        }
+        const size_t capacity = alignSize(size, allocationGranularity(size));
+        uchar* buffer = (uchar*)fastMalloc(capacity + BUFFER_HEADER_SIZE);
+        uchar* data = buffer + BUFFER_HEADER_SIZE;
+        bufferCapacity(data) = capacity;
+        return data;
+    }
+
+    void release(uchar* data)
+    {
+        CV_DbgAssert(data);
+        BufferEntry entry = { data, bufferCapacity(data) };
+        std::vector<BufferEntry> evicted;
+        {
+            AutoLock lock(mutex);
+            if (maxReservedSize > 0 && entry.capacity <= maxReservedSize / 8)
+            {
+                reservedEntries.push_front(entry);
+                currentReservedSize += entry.capacity;
+                while (currentReservedSize > maxReservedSize)
+                {
+                    CV_DbgAssert(!reservedEntries.empty());
+                    const BufferEntry& e = reservedEntries.back();
+                    currentReservedSize -= e.capacity;
+                    evicted.push_back(e);
+                    reservedEntries.pop_back();
+                }
+            }
+            else
+            {
+                evicted.push_back(entry);
+            }
+        }
+        for (size_t i = 0; i < evicted.size(); i++)
+            fastFree(evicted[i].data - BUFFER_HEADER_SIZE);
+    }
+
+    void setMaxReservedSize(size_t size)
+    {
+        std::vector<BufferEntry> evicted;
+        {
+            AutoLock lock(mutex);
+            maxReservedSize = size;
+            while (currentReservedSize > maxReservedSize)
+            {
+                const BufferEntry& e = reservedEntries.back();
+                currentReservedSize -= e.capacity;
+                evicted.push_back(e);
+                reservedEntries.pop_back();
+            }
+        }
+        for (size_t i = 0; i < evicted.size(); i++)
+            fastFree(evicted[i].data - BUFFER_HEADER_SIZE);
+    }
+
+    void freeAllReservedBuffers()
+    {
+        std::list<BufferEntry> entries;
+        {
+            AutoLock lock(mutex);
+            entries.swap(reservedEntries);
+            currentReservedSize = 0;
+        }
+        for (std::list<BufferEntry>::const_iterator i = entries.begin(); i != entries.end(); ++i)
+            fastFree(i->data - BUFFER_HEADER_SIZE);
+    }
+
+    Mutex mutex;
+    std::list<BufferEntry> reservedEntries;  // LRU order
+    size_t currentReservedSize;
+    size_t maxReservedSize;
+
+    AllocatorStatistics stats;
+
+protected:
+    static inline size_t allocationGranularity(size_t size)
+    {
+        // heuristic values (see OpenCL buffer pool)
+        if (size < 1024*1024)
+            return 4096;
+        else if (size < 16*1024*1024)
+            return 64*1024;
+        else
+            return 1024*1024;
+    }
+
+    // synchronized
+    uchar* findAndRemoveReservedEntry(size_t size)
+    {
+        std::list<BufferEntry>::iterator result_pos = reservedEntries.end();
+        size_t minDiff = (size_t)(-1);
+        for (std::list<BufferEntry>::iterator i = reservedEntries.begin(); i != reservedEntries.end(); ++i)
+        {
+            const BufferEntry& e = *i;
+            if (e.capacity >= size)
+            {
+                size_t diff = e.capacity - size;
+                if (diff < std::max((size_t)4096, size / 8) && diff < minDiff)
+                {
+                    minDiff = diff;
+                    result_pos = i;
+                    if (diff == 0)
+                        break;
+                }
+            }
+        }
+        if (result_pos == reservedEntries.end())
+            return NULL;
+        uchar* data = result_pos->data;
+        currentReservedSize -= result_pos->capacity;
+        reservedEntries.erase(result_pos);
+        return data;
+    }
+};
+
+BufferPoolMatAllocator::BufferPoolMatAllocator(size_t maxReservedSize)
+    : p(new Impl(maxReservedSize == (size_t)-1 ? getDefaultMaxReservedSize() : maxReservedSize))
+{
+    // nothing
+}
+
+BufferPoolMatAllocator::~BufferPoolMatAllocator()
+{
+    if (p->stats.getCurrentUsage() != 0)
+    {
+        CV_LOG_WARNING(NULL, "BufferPoolMatAllocator: allocator is destroyed, but " << p->stats.getCurrentUsage() << " bytes are still in use");
+    }
+    delete p;
+}
+
+UMatData* BufferPoolMatAllocator::allocate(int dims, const int* sizes, int type,
+                                           void* data0, size_t* step, AccessFlag /*flags*/, UMatUsageFlags /*usageFlags*/) const
+{
+    size_t total = CV_ELEM_SIZE(type);
+    for (int i = dims-1; i >= 0; i--)
+    {
+        if (step)
+        {
+            if (data0 && step[i] != CV_AUTOSTEP)
+            {
+                CV_Assert(total <= step[i]);
+                total = step[i];
+            }
+            else
+                step[i] = total;
+        }
+        total *= sizes[i];
+    }
+    uchar* data = data0 ? (uchar*)data0 : p->allocate(total);
+    UMatData* u = new UMatData(this);
+    u->data = u->origdata = data;
+    u->size = total;
+    if (data0)
+        u->flags |= UMatData::USER_ALLOCATED;
+    else
+        p->stats.onAllocate(total);
+    return u;
+}
+
+bool BufferPoolMatAllocator::allocate(UMatData* u, AccessFlag /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const
+{
+    if (!u) return false;
+    return true;
+}
+
+void BufferPoolMatAllocator::deallocate(UMatData* u) const
+{
+    if (!u)
+        return;
+
+    CV_Assert(u->urefcount == 0);
+    CV_Assert(u->refcount == 0);
+    if (!(u->flags & UMatData::USER_ALLOCATED))
+    {
+        p->stats.onFree(u->size);
+        p->release(u->origdata);
+        u->origdata = 0;
+    }
+    delete u;
+}
+
+BufferPoolController* BufferPoolMatAllocator::getBufferPoolController(const char* /*id*/) const
+{
+    return const_cast<BufferPoolMatAllocator*>(this);
+}
+
+size_t BufferPoolMatAllocator::getReservedSize() const
+{
+    AutoLock lock(p->mutex);
+    return p->currentReservedSize;
+}
+
+size_t BufferPoolMatAllocator::getMaxReservedSize() const
+{
+    AutoLock lock(p->mutex);
+    return p->maxReservedSize;
+}
+
+void BufferPoolMatAllocator::setMaxReservedSize(size_t size)
+{
+    p->setMaxReservedSize(size);
+}
+
+void BufferPoolMatAllocator::freeAllReservedBuffers()
+{
+    p->freeAllReservedBuffers();
+}
+
+AllocatorStatisticsInterface& BufferPoolMatAllocator::getAllocatorStatistics() const
+{
+    return p->stats;
+}
+
+
+MatAllocatorScope::MatAllocatorScope(MatAllocator* allocator)
+{
+    prevAllocator_ = cv::details::getThreadMatAllocator();
+    cv::details::setThreadMatAllocator(allocator);
+}
+
+MatAllocatorScope::~MatAllocatorScope()
+{
+    cv::details::setThreadMatAllocator(prevAllocator_);
+}
+
+}}  // namespace
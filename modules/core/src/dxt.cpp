@@ -1538,98 +1538,6 @@ CopyColumn( const uchar* _src, size_t src_step,
 }
 
 
-static void
-CopyFrom2Columns( const uchar* _src, size_t src_step,
-                  uchar* _dst0, uchar* _dst1,
-                  int len, size_t elem_size )
-{
-    int i, t0, t1;
-    const int* src = (const int*)_src;
-    int* dst0 = (int*)_dst0;
-    int* dst1 = (int*)_dst1;
-    src_step /= sizeof(src[0]);
-
-    if( elem_size == sizeof(int) )
-    {
-        for( i = 0; i < len; i++, src += src_step )
-        {
-            t0 = src[0]; t1 = src[1];
-            dst0[i] = t0; dst1[i] = t1;
-        }
-    }
-    else if( elem_size == sizeof(int)*2 )
-    {
-        for( i = 0; i < len*2; i += 2, src += src_step )
-        {
-            t0 = src[0]; t1 = src[1];
-            dst0[i] = t0; dst0[i+1] = t1;
-            t0 = src[2]; t1 = src[3];
-            dst1[i] = t0; dst1[i+1] = t1;
-        }
-    }
-    else if( elem_size == sizeof(int)*4 )
-    {
-        for( i = 0; i < len*4; i += 4, src += src_step )
-        {
-            t0 = src[0]; t1 = src[1];
-            dst0[i] = t0; dst0[i+1] = t1;
-            t0 = src[2]; t1 = src[3];
-            dst0[i+2] = t0; dst0[i+3] = t1;
-            t0 = src[4]; t1 = src[5];
-            dst1[i] = t0; dst1[i+1] = t1;
-            t0 = src[6]; t1 = src[7];
-            dst1[i+2] = t0; dst1[i+3] = t1;
-        }
-    }
-}
-
-
-static void
-CopyTo2Columns( const uchar* _src0, const uchar* _src1,
-                uchar* _dst, size_t dst_step,
-                int len, size_t elem_size )
-{
-    int i, t0, t1;
-    const int* src0 = (const int*)_src0;
-    const int* src1 = (const int*)_src1;
-    int* dst = (int*)_dst;
-    dst_step /= sizeof(dst[0]);
-
-    if( elem_size == sizeof(int) )
-    {
-        for( i = 0; i < len; i++, dst += dst_step )
-        {
-            t0 = src0[i]; t1 = src1[i];
-            dst[0] = t0; dst[1] = t1;
-        }
-    }
-    else if( elem_size == sizeof(int)*2 )
-    {
-        for( i = 0; i < len*2; i += 2, dst += dst_step )
-        {
-            t0 = src0[i]; t1 = src0[i+1];
-            dst[0] = t0; dst[1] = t1;
-            t0 = src1[i]; t1 = src1[i+1];
-            dst[2] = t0; dst[3] = t1;
-        }
-    }
-    else if( elem_size == sizeof(int)*4 )
-    {
-        for( i = 0; i < len*4; i += 4, dst += dst_step )
-        {
-            t0 = src0[i]; t1 = src0[i+1];
-            dst[0] = t0; dst[1] = t1;
-            t0 = src0[i+2]; t1 = src0[i+3];
-            dst[2] = t0; dst[3] = t1;
-            t0 = src1[i]; t1 = src1[i+1];
-            dst[4] = t0; dst[5] = t1;
-            t0 = src1[i+2]; t1 = src1[i+3];
-            dst[6] = t0; dst[7] = t1;
-        }
-    }
-}
-
-
 static void
 ExpandCCS( uchar* _ptr, int n, int elem_size )
 {
@@ -2679,6 +2587,71 @@ static void complementComplexOutput(int depth, uchar * ptr, size_t step, int cou
         complementComplex((double*)ptr, step, count, len, dft_dims);
 }
 
+// Column pass gathers blocks of DFT_COL_BLOCK_BYTES-wide complex columns, so every source/destination row
+// is accessed by whole cache lines instead of one element per row.
+enum { DFT_COL_BLOCK_BYTES = 64 };
+
+template <typename T>
+static void copyColumnsToBlock(const uchar* src, size_t src_step, T* block, int len, int ncols)
+{
+    for( int i = 0; i < len; i++ )
+    {
+        const T* s = (const T*)(src + src_step*i);
+        for( int j = 0; j < ncols; j++ )
+            block[j*len + i] = s[j];
+    }
+}
+
+template <typename T>
+static void copyBlockToColumns(const T* block, int len, int ncols, uchar* dst, size_t dst_step)
+{
+    for( int i = 0; i < len; i++ )
+    {
+        T* d = (T*)(dst + dst_step*i);
+        for( int j = 0; j < ncols; j++ )
+            d[j] = block[j*len + i];
+    }
+}
+
+class OcvDftImpl;
+
+class DftRowsInvoker : public ParallelLoopBody
+{
+public:
+    DftRowsInvoker(OcvDftImpl* _impl, const uchar* _src, size_t _src_step, uchar* _dst, size_t _dst_step,
+                   int _dptr_offset, int _dst_full_len)
+        : impl(_impl), src(_src), src_step(_src_step), dst(_dst), dst_step(_dst_step),
+          dptr_offset(_dptr_offset), dst_full_len(_dst_full_len) {}
+    void operator()(const Range& range) const CV_OVERRIDE;
+
+private:
+    OcvDftImpl* impl;
+    const uchar* src;
+    size_t src_step;
+    uchar* dst;
+    size_t dst_step;
+    int dptr_offset;
+    int dst_full_len;
+};
+
+class DftColsInvoker : public ParallelLoopBody
+{
+public:
+    DftColsInvoker(OcvDftImpl* _impl, const uchar* _src, size_t _src_step, uchar* _dst, size_t _dst_step, int _ncols)
+        : impl(_impl), src(_src), src_step(_src_step), dst(_dst), dst_step(_dst_step), ncols(_ncols) {}
+    void operator()(const Range& range) const CV_OVERRIDE;
+
+private:
+    OcvDftImpl* impl;
+    const uchar* src;
+    size_t src_step;
+    uchar* dst;
+    size_t dst_step;
+    int ncols;
+};
+
+static bool isDFT1DParallelSafe(const Ptr<hal::DFT1D>& context);
+
 enum DftMode {
     InvalidDft = 0,
     FwdRealToCCS,
@@ -2801,16 +2774,24 @@ protected:
     int src_channels;
     int dst_channels;
 
+    bool parallelA;
+    bool parallelB;
+
     AutoBuffer<uchar> tmp_bufA;
     AutoBuffer<uchar> tmp_bufB;
     AutoBuffer<uchar> buf0;
     AutoBuffer<uchar> buf1;
 
+    friend class DftRowsInvoker;
+    friend class DftColsInvoker;
+
 public:
     OcvDftImpl()
     {
         needBufferA = false;
         needBufferB = false;
+        parallelA = false;
+        parallelB = false;
         inv = false;
         width = 0;
         height = 0;
@@ -2931,6 +2912,7 @@ public:
                 }
                 needBufferA = isInplace;
                 contextA = hal::DFT1D::create(len, count, depth, f, &needBufferA);
+                parallelA = isDFT1DParallelSafe(contextA);
                 if (needBufferA)
                     tmp_bufA.allocate(len * complex_elem_size);
             }
@@ -2941,6 +2923,7 @@ public:
                 f |= CV_HAL_DFT_STAGE_COLS;
                 needBufferB = isInplace;
                 contextB = hal::DFT1D::create(len, count, depth, f, &needBufferB);
+                parallelB = isDFT1DParallelSafe(contextB);
                 if (needBufferB)
                     tmp_bufB.allocate(len * complex_elem_size);
 
@@ -3058,29 +3041,72 @@ protected:
         if( nz <= 0 || nz > count )
             nz = count;
 
-        int i;
-        for( i = 0; i < nz; i++ )
+        if( parallelA && nz > 1 )
+            parallel_for_(Range(0, nz), DftRowsInvoker(this, src_data, src_step, dst_data, dst_step, dptr_offset, dst_full_len),
+                          (double)nz*len/(1 << 14));
+        else
+            rowDftRange(Range(0, nz), src_data, src_step, dst_data, dst_step, dptr_offset, dst_full_len, tmp_bufA.data());
+
+        for( int i = nz; i < count; i++ )
         {
-            const uchar* sptr = src_data + src_step * i;
             uchar* dptr0 = dst_data + dst_step * i;
-            uchar* dptr = dptr0;
+            memset( dptr0, 0, dst_full_len );
+        }
+        if(isLastStage &&  mode == FwdRealToComplex)
+            complementComplexOutput(depth, dst_data, dst_step, len, nz, 1);
+    }
 
-            if( needBufferA )
-                dptr = tmp_bufA.data();
+    void rowDftRange(const Range& range, const uchar* src_data, size_t src_step, uchar* dst_data, size_t dst_step,
+                     int dptr_offset, int dst_full_len, uchar* buf)
+    {
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const uchar* sptr = src_data + src_step * i;
+            uchar* dptr0 = dst_data + dst_step * i;
+            uchar* dptr = needBufferA ? buf : dptr0;
 
             contextA->apply(sptr, dptr);
 
             if( needBufferA )
                 memcpy( dptr0, dptr + dptr_offset, dst_full_len );
         }
+    }
 
-        for( ; i < count; i++ )
+    // transforms complex columns [range.start, range.end) of the block (blockwise gather -> 1D DFT -> scatter)
+    void colDftRange(const Range& range, const uchar* sptr0, size_t src_step, uchar* dptr0, size_t dst_step, uchar* buf)
+    {
+        int len = height;
+        int block = std::max(DFT_COL_BLOCK_BYTES / complex_elem_size, 1);
+        uchar* ibuf = buf;
+        uchar* obuf = buf + (size_t)block*len*complex_elem_size;
+
+        for( int j0 = range.start; j0 < range.end; j0 += block )
         {
-            uchar* dptr0 = dst_data + dst_step * i;
-            memset( dptr0, 0, dst_full_len );
+            int ncols = std::min(block, range.end - j0);
+            const uchar* sptr = sptr0 + (size_t)j0*complex_elem_size;
+            uchar* dptr = dptr0 + (size_t)j0*complex_elem_size;
+
+            if( depth == CV_32F )
+                copyColumnsToBlock(sptr, src_step, (Complexf*)ibuf, len, ncols);
+            else
+                copyColumnsToBlock(sptr, src_step, (Complexd*)ibuf, len, ncols);
+
+            for( int j = 0; j < ncols; j++ )
+            {
+                size_t ofs = (size_t)j*len*complex_elem_size;
+                contextB->apply(ibuf + ofs, obuf + ofs);
+            }
+
+            if( depth == CV_32F )
+                copyBlockToColumns((const Complexf*)obuf, len, ncols, dptr, dst_step);
+            else
+                copyBlockToColumns((const Complexd*)obuf, len, ncols, dptr, dst_step);
         }
-        if(isLastStage &&  mode == FwdRealToComplex)
-            complementComplexOutput(depth, dst_data, dst_step, len, nz, 1);
+    }
+
+    size_t colDftBufSize() const
+    {
+        return (size_t)std::max(DFT_COL_BLOCK_BYTES / complex_elem_size, 1)*height*complex_elem_size*2;
     }
 
     void colDft(const uchar* src_data, size_t src_step, uchar* dst_data, size_t dst_step, int stage_src_channels, int stage_dst_channels, bool isLastStage)
@@ -3186,30 +3212,35 @@ protected:
             }
         }
 
-        for(int i = a; i < b; i += 2 )
+        int ncols = b - a;
+        if( ncols > 0 )
         {
-            if( i+1 < b )
-            {
-                CopyFrom2Columns( sptr0, src_step, buf0.data(), buf1.data(), len, complex_elem_size );
-                contextB->apply(buf1.data(), dbuf1);
-            }
+            int block = std::max(DFT_COL_BLOCK_BYTES / complex_elem_size, 1);
+            int nblocks = (ncols + block - 1) / block;
+            DftColsInvoker invoker(this, sptr0, src_step, dptr0, dst_step, ncols);
+            if( parallelB && nblocks > 1 )
+                parallel_for_(Range(0, nblocks), invoker, (double)ncols*len/(1 << 14));
             else
-                CopyColumn( sptr0, src_step, buf0.data(), complex_elem_size, len, complex_elem_size );
-
-            contextB->apply(buf0.data(), dbuf0);
-
-            if( i+1 < b )
-                CopyTo2Columns( dbuf0, dbuf1, dptr0, dst_step, len, complex_elem_size );
-            else
-                CopyColumn( dbuf0, complex_elem_size, dptr0, dst_step, len, complex_elem_size );
-            sptr0 += 2*complex_elem_size;
-            dptr0 += 2*complex_elem_size;
+                invoker(Range(0, nblocks));
         }
         if(isLastStage && mode == FwdRealToComplex)
             complementComplexOutput(depth, dst_data, dst_step, count, len, 2);
     }
 };
 
+void DftRowsInvoker::operator()(const Range& range) const
+{
+    AutoBuffer<uchar> buf(impl->needBufferA ? impl->tmp_bufA.size() : 0);
+    impl->rowDftRange(range, src, src_step, dst, dst_step, dptr_offset, dst_full_len, buf.data());
+}
+
+void DftColsInvoker::operator()(const Range& range) const
+{
+    int block = std::max(DFT_COL_BLOCK_BYTES / impl->complex_elem_size, 1);
+    AutoBuffer<uchar> buf(impl->colDftBufSize());
+    impl->colDftRange(Range(range.start*block, std::min(range.end*block, ncols)), src, src_step, dst, dst_step, buf.data());
+}
+
 class OcvDftBasicImpl CV_FINAL : public hal::DFT1D
 {
 public:
@@ -3373,6 +3404,13 @@ public:
     void free() {}
 };
 
+// OcvDftBasicImpl keeps read-only tables only (IPP uses shared work buffer), HAL replacements are not known to be reentrant
+static bool isDFT1DParallelSafe(const Ptr<hal::DFT1D>& context)
+{
+    const OcvDftBasicImpl* impl = dynamic_cast<const OcvDftBasicImpl*>(context.get());
+    return impl && !impl->opt.useIpp;
+}
+
 struct ReplacementDFT1D : public hal::DFT1D
 {
     cvhalDFT *context;
@@ -3480,6 +3518,43 @@ Ptr<DFT2D> DFT2D::create(int width, int height, int depth,
 }
 
 } // cv::hal::
+
+static int getDftDstType(int type, int flags)
+{
+    bool inv = (flags & DFT_INVERSE) != 0;
+    int depth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
+
+    if( !inv && cn == 1 && (flags & DFT_COMPLEX_OUTPUT) )
+        return CV_MAKETYPE(depth, 2);
+    if( inv && cn == 2 && (flags & DFT_REAL_OUTPUT) )
+        return depth;
+    return type;
+}
+
+static void checkDftArgs(int type, int flags)
+{
+    CV_Assert( type == CV_32FC1 || type == CV_32FC2 || type == CV_64FC1 || type == CV_64FC2 );
+
+    // Fail if DFT_COMPLEX_INPUT is specified, but src is not 2 channels.
+    CV_Assert( !((flags & DFT_COMPLEX_INPUT) && CV_MAT_CN(type) != 2) );
+}
+
+static int getDftHalFlags(int flags, bool isContinuous, bool isInplace)
+{
+    int f = 0;
+    if (isContinuous)
+        f |= CV_HAL_DFT_IS_CONTINUOUS;
+    if (flags & DFT_INVERSE)
+        f |= CV_HAL_DFT_INVERSE;
+    if (flags & DFT_ROWS)
+        f |= CV_HAL_DFT_ROWS;
+    if (flags & DFT_SCALE)
+        f |= CV_HAL_DFT_SCALE;
+    if (isInplace)
+        f |= CV_HAL_DFT_IS_INPLACE;
+    return f;
+}
+
 } // cv::
 
 
@@ -3499,35 +3574,16 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
 #endif
 
     Mat src0 = _src0.getMat(), src = src0;
-    bool inv = (flags & DFT_INVERSE) != 0;
     int type = src.type();
     int depth = src.depth();
 
-    CV_Assert( type == CV_32FC1 || type == CV_32FC2 || type == CV_64FC1 || type == CV_64FC2 );
+    checkDftArgs(type, flags);
 
-    // Fail if DFT_COMPLEX_INPUT is specified, but src is not 2 channels.
-    CV_Assert( !((flags & DFT_COMPLEX_INPUT) && src.channels() != 2) );
-
-    if( !inv && src.channels() == 1 && (flags & DFT_COMPLEX_OUTPUT) )
-        _dst.create( src.size(), CV_MAKETYPE(depth, 2) );
-    else if( inv && src.channels() == 2 && (flags & DFT_REAL_OUTPUT) )
-        _dst.create( src.size(), depth );
-    else
-        _dst.create( src.size(), type );
+    _dst.create( src.size(), getDftDstType(type, flags) );
 
     Mat dst = _dst.getMat();
 
-    int f = 0;
-    if (src.isContinuous() && dst.isContinuous())
-        f |= CV_HAL_DFT_IS_CONTINUOUS;
-    if (inv)
-        f |= CV_HAL_DFT_INVERSE;
-    if (flags & DFT_ROWS)
-        f |= CV_HAL_DFT_ROWS;
-    if (flags & DFT_SCALE)
-        f |= CV_HAL_DFT_SCALE;
-    if (src.data == dst.data)
-        f |= CV_HAL_DFT_IS_INPLACE;
+    int f = getDftHalFlags(flags, src.isContinuous() && dst.isContinuous(), src.data == dst.data);
     Ptr<hal::DFT2D> c = hal::DFT2D::create(src.cols, src.rows, depth, src.channels(), dst.channels(), f, nonzero_rows);
     c->apply(src.data, src.step, dst.data, dst.step);
 }
@@ -3540,6 +3596,102 @@ void cv::idft( InputArray src, OutputArray dst, int flags, int nonzero_rows )
     dft( src, dst, flags | DFT_INVERSE, nonzero_rows );
 }
 
+namespace cv {
+
+/* Transform contexts are not reentrant (they own their scratch buffers), so the plan keeps
+   a pool of idle contexts keyed by HAL flags: concurrent calls take different contexts,
+   sequential calls keep reusing the same one. */
+struct DFTPlan::Impl
+{
+    Size size;
+    int type;
+    int dstType;
+    int flags;
+    int nonzeroRows;
+
+    Mutex mutex;
+    std::vector<std::pair<int, Ptr<hal::DFT2D> > > idle;
+
+    Impl(Size size_, int type_, int flags_, int nonzeroRows_)
+        : size(size_), type(type_), dstType(getDftDstType(type_, flags_)),
+          flags(flags_), nonzeroRows(nonzeroRows_)
+    {}
+
+    Ptr<hal::DFT2D> acquire(int halFlags)
+    {
+        {
+            AutoLock lock(mutex);
+            for (size_t i = idle.size(); i > 0; i--)
+            {
+                if (idle[i-1].first == halFlags)
+                {
+                    Ptr<hal::DFT2D> c = idle[i-1].second;
+                    idle.erase(idle.begin() + (i-1));
+                    return c;
+                }
+            }
+        }
+        return hal::DFT2D::create(size.width, size.height, CV_MAT_DEPTH(type), CV_MAT_CN(type),
+                                  CV_MAT_CN(dstType), halFlags, nonzeroRows);
+    }
+
+    void release(int halFlags, const Ptr<hal::DFT2D>& c)
+    {
+        AutoLock lock(mutex);
+        idle.push_back(std::make_pair(halFlags, c));
+    }
+};
+
+DFTPlan::DFTPlan()
+{
+}
+
+DFTPlan::DFTPlan(Size size_, int type_, int flags_, int nonzeroRows_)
+{
+    create(size_, type_, flags_, nonzeroRows_);
+}
+
+void DFTPlan::create(Size size_, int type_, int flags_, int nonzeroRows_)
+{
+    CV_INSTRUMENT_REGION();
+
+    checkDftArgs(type_, flags_);
+    CV_Assert( size_.width > 0 && size_.height > 0 );
+
+    Ptr<Impl> impl = makePtr<Impl>(size_, type_, flags_, nonzeroRows_);
+
+    // precompute the context for the common case: continuous, not in-place arrays
+    int f = getDftHalFlags(flags_, true, false);
+    impl->release(f, impl->acquire(f));
+
+    p = impl;
+}
+
+void DFTPlan::execute(InputArray _src, OutputArray _dst) const
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( !empty() );
+
+    Mat src = _src.getMat();
+    CV_Assert( src.size() == p->size && src.type() == p->type );
+
+    _dst.create( p->size, p->dstType );
+    Mat dst = _dst.getMat();
+
+    int f = getDftHalFlags(p->flags, src.isContinuous() && dst.isContinuous(), src.data == dst.data);
+    Ptr<hal::DFT2D> c = p->acquire(f);
+    c->apply(src.data, src.step, dst.data, dst.step);
+    p->release(f, c);
+}
+
+bool DFTPlan::empty() const { return p.empty(); }
+Size DFTPlan::size() const { return p ? p->size : Size(); }
+int DFTPlan::type() const { return p ? p->type : -1; }
+int DFTPlan::flags() const { return p ? p->flags : 0; }
+
+} // cv::
+
 #ifdef HAVE_OPENCL
 
 namespace cv {
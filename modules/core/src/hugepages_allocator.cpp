@@ -0,0 +1,239 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "opencv2/core/utils/hugepages_allocator.hpp"
+
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/logger.defines.hpp>
+#include <opencv2/core/utils/logger.hpp>
+#include <opencv2/core/utils/trace.private.hpp>
+
+#include "opencv2/core/utils/allocator_stats.impl.hpp"
+
+#if defined(__linux__) && !defined(__ANDROID__) && !defined(OPENCV_DISABLE_HUGEPAGES_ALLOCATOR)
+#define OPENCV_HAVE_HUGEPAGES_ALLOCATOR 1
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+namespace cv { namespace utils {
+
+static cv::utils::AllocatorStatistics hugepages_allocator_stats;
+
+AllocatorStatisticsInterface& getHugePagesAllocatorStatistics()
+{
+    return hugepages_allocator_stats;
+}
+
+#ifdef OPENCV_HAVE_HUGEPAGES_ALLOCATOR
+
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1  // <numaif.h>, libnuma is not required
+#endif
+
+static const size_t HUGE_PAGE_SIZE = (size_t)2 << 20;  // default huge page size on x86_64/aarch64
+
+enum HugePagesMode
+{
+    HUGEPAGES_NONE = 0,
+    HUGEPAGES_THP = 1,      // madvise(MADV_HUGEPAGE)
+    HUGEPAGES_HUGETLB = 2   // mmap(MAP_HUGETLB)
+};
+
+// UMatData::allocatorFlags_
+enum HugePagesAllocatorFlags
+{
+    BUFFER_FAST_MALLOC = 0,  // buffer is allocated by fastMalloc()
+    BUFFER_MMAP = 1          // buffer is mapped, size is aligned to HUGE_PAGE_SIZE
+};
+
+struct HugePagesAllocatorParameters
+{
+    size_t threshold;
+    HugePagesMode mode;
+    bool numaBind;
+
+    HugePagesAllocatorParameters()
+    {
+        threshold = utils::getConfigurationParameterSizeT("OPENCV_HUGEPAGES_ALLOCATOR_THRESHOLD", (size_t)4 << 20);
+        std::string modeName = toUpperCase(utils::getConfigurationParameterString("OPENCV_HUGEPAGES_ALLOCATOR_MODE", "THP"));
+        if (modeName == "THP")
+            mode = HUGEPAGES_THP;
+        else if (modeName == "HUGETLB")
+            mode = HUGEPAGES_HUGETLB;
+        else if (modeName == "NONE")
+            mode = HUGEPAGES_NONE;
+        else
+        {
+            CV_LOG_WARNING(NULL, "OPENCV_HUGEPAGES_ALLOCATOR_MODE: unknown value '" << modeName << "', THP mode is used");
+            mode = HUGEPAGES_THP;
+        }
+        numaBind = utils::getConfigurationParameterBool("OPENCV_HUGEPAGES_ALLOCATOR_NUMA", true);
+    }
+};
+
+static const HugePagesAllocatorParameters& getParameters()
+{
+    static HugePagesAllocatorParameters g_parameters;
+    return g_parameters;
+}
+
+/// sets preferred NUMA node of memory range to the node of the calling thread (before the first touch)
+static void bindToCurrentNumaNode(void* ptr, size_t size)
+{
+#if defined(SYS_getcpu) && defined(SYS_mbind)
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0)
+        return;
+    const size_t bitsPerMask = sizeof(unsigned long) * 8;
+    unsigned long nodemask[4] = { 0, 0, 0, 0 };
+    if (node >= sizeof(nodemask) * 8)
+        return;
+    nodemask[node / bitsPerMask] = 1ul << (node % bitsPerMask);
+    if (syscall(SYS_mbind, ptr, size, MPOL_PREFERRED, nodemask, sizeof(nodemask) * 8, 0) != 0)
+    {
+        CV_LOG_ONCE_DEBUG(NULL, "HugePagesMatAllocator: mbind() failed, errno=" << errno);
+    }
+#else
+    CV_UNUSED(ptr); CV_UNUSED(size);
+#endif
+}
+
+static void* mapBuffer(size_t size)
+{
+    const HugePagesAllocatorParameters& params = getParameters();
+    void* ptr = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (params.mode == HUGEPAGES_HUGETLB)
+    {
+        ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (ptr == MAP_FAILED)
+        {
+            CV_LOG_ONCE_INFO(NULL, "HugePagesMatAllocator: can't map explicit huge pages (see /proc/sys/vm/nr_hugepages), fallback on THP");
+        }
+    }
+#endif
+    if (ptr == MAP_FAILED)
+    {
+        // over-allocate to align buffer on huge page boundary, THP can't be used for unaligned ranges
+        const size_t mapSize = size + HUGE_PAGE_SIZE;
+        uchar* base = (uchar*)mmap(NULL, mapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == (uchar*)MAP_FAILED)
+            return NULL;
+        uchar* aligned = alignPtr(base, (int)HUGE_PAGE_SIZE);
+        if (aligned != base)
+            munmap(base, aligned - base);
+        const size_t tail = (base + mapSize) - (aligned + size);
+        if (tail > 0)
+            munmap(aligned + size, tail);
+        ptr = aligned;
+#ifdef MADV_HUGEPAGE
+        if (params.mode != HUGEPAGES_NONE)
+            madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+    }
+    if (params.numaBind)
+        bindToCurrentNumaNode(ptr, size);
+    return ptr;
+}
+
+class HugePagesMatAllocator CV_FINAL : public MatAllocator
+{
+public:
+    UMatData* allocate(int dims, const int* sizes, int type,
+                       void* data0, size_t* step, AccessFlag /*flags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        size_t total = CV_ELEM_SIZE(type);
+        for (int i = dims-1; i >= 0; i--)
+        {
+            if (step)
+            {
+                if (data0 && step[i] != CV_AUTOSTEP)
+                {
+                    CV_Assert(total <= step[i]);
+                    total = step[i];
+                }
+                else
+                    step[i] = total;
+            }
+            total *= sizes[i];
+        }
+        UMatData* u = new UMatData(this);
+        uchar* data = (uchar*)data0;
+        u->allocatorFlags_ = BUFFER_FAST_MALLOC;
+        if (!data && total >= getParameters().threshold)
+        {
+            const size_t mapSize = alignSize(total, HUGE_PAGE_SIZE);
+            data = (uchar*)mapBuffer(mapSize);
+            if (data)
+            {
+                u->allocatorFlags_ = BUFFER_MMAP;
+                hugepages_allocator_stats.onAllocate(mapSize);
+            }
+        }
+        if (!data)
+            data = (uchar*)fastMalloc(total);
+        u->data = u->origdata = data;
+        u->size = total;
+        if (data0)
+            u->flags |= UMatData::USER_ALLOCATED;
+#ifdef OPENCV_TRACE
+        else
+            CV_TRACE_NS::details::traceAllocation((int64)total);
+#endif
+        return u;
+    }
+
+    bool allocate(UMatData* u, AccessFlag /*accessFlags*/, UMatUsageFlags /*usageFlags*/) const CV_OVERRIDE
+    {
+        if (!u) return false;
+        return true;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if (!u)
+            return;
+
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        if (!(u->flags & UMatData::USER_ALLOCATED))
+        {
+            if (u->allocatorFlags_ == BUFFER_MMAP)
+            {
+                const size_t mapSize = alignSize(u->size, HUGE_PAGE_SIZE);
+                munmap(u->origdata, mapSize);
+                hugepages_allocator_stats.onFree(mapSize);
+            }
+            else
+            {
+                fastFree(u->origdata);
+            }
+            u->origdata = 0;
+#ifdef OPENCV_TRACE
+            CV_TRACE_NS::details::traceAllocation(-(int64)u->size);
+#endif
+        }
+        delete u;
+    }
+};
+
+MatAllocator* getHugePagesMatAllocator()
+{
+    CV_SINGLETON_LAZY_INIT(MatAllocator, new HugePagesMatAllocator())
+}
+
+#else  // OPENCV_HAVE_HUGEPAGES_ALLOCATOR
+
+MatAllocator* getHugePagesMatAllocator()
+{
+    return Mat::getStdAllocator();
+}
+
+#endif  // OPENCV_HAVE_HUGEPAGES_ALLOCATOR
+
+}}  // namespace
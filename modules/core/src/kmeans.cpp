@@ -51,6 +51,7 @@ namespace cv
 {
 
 static int CV_KMEANS_PARALLEL_GRANULARITY = (int)utils::getConfigurationParameterSizeT("OPENCV_KMEANS_PARALLEL_GRANULARITY", 1000);
+static int CV_KMEANS_MINI_BATCH_SIZE = (int)utils::getConfigurationParameterSizeT("OPENCV_KMEANS_MINI_BATCH_SIZE", 1024);
 
 static void generateRandomCenter(int dims, const Vec2f* box, float* center, RNG& rng)
 {
@@ -159,6 +160,59 @@ static void generateCentersPP(const Mat& data, Mat& _out_centers,
     }
 }
 
+/*
+hal::normL2Sqr_ vectorizes along the sample dimensions and falls back to scalar code for
+short vectors (colour quantization, low-dimensional descriptors). For such data the centers
+are transposed (dims x K) and the distances to several centers are computed at once.
+*/
+static bool useTransposedCenters(int K, int dims)
+{
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    return K >= VTraits<v_float32>::vlanes() && dims < 4 * VTraits<v_float32>::vlanes();
+#else
+    CV_UNUSED(K); CV_UNUSED(dims);
+    return false;
+#endif
+}
+
+static void distancesToCenters(const float* sample, const Mat& centers, const Mat& centersT, float* dist)
+{
+    const int K = centers.rows;
+    const int dims = centers.cols;
+    int k = 0;
+
+    if (centersT.empty())
+    {
+        for (; k < K; k++)
+            dist[k] = hal::normL2Sqr_(sample, centers.ptr<float>(k), dims);
+        return;
+    }
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int vlanes = VTraits<v_float32>::vlanes();
+    for (; k <= K - vlanes; k += vlanes)
+    {
+        v_float32 v_d = vx_setzero_f32();
+        for (int j = 0; j < dims; j++)
+        {
+            v_float32 t = v_sub(vx_setall_f32(sample[j]), vx_load(centersT.ptr<float>(j) + k));
+            v_d = v_muladd(t, t, v_d);
+        }
+        v_store(dist + k, v_d);
+    }
+#endif
+    for (; k < K; k++)
+    {
+        float d = 0.f;
+        for (int j = 0; j < dims; j++)
+        {
+            float t = sample[j] - centersT.at<float>(j, k);
+            d += t*t;
+        }
+        dist[k] = d;
+    }
+}
+
 template<bool onlyDistance>
 class KMeansDistanceComputer : public ParallelLoopBody
 {
@@ -166,11 +220,13 @@ public:
     KMeansDistanceComputer( double *distances_,
                             int *labels_,
                             const Mat& data_,
-                            const Mat& centers_)
+                            const Mat& centers_,
+                            const Mat& centersT_ = Mat())
         : distances(distances_),
           labels(labels_),
           data(data_),
-          centers(centers_)
+          centers(centers_),
+          centersT(centersT_)
     {
     }
 
@@ -181,6 +237,8 @@ public:
         const int end = range.end;
         const int K = centers.rows;
         const int dims = centers.cols;
+        cv::AutoBuffer<float, 64> _dist(onlyDistance ? 1 : K);
+        float* dist = _dist.data();
 
         for (int i = begin; i < end; ++i)
         {
@@ -196,14 +254,12 @@ public:
                 int k_best = 0;
                 double min_dist = DBL_MAX;
 
+                distancesToCenters(sample, centers, centersT, dist);
                 for (int k = 0; k < K; k++)
                 {
-                    const float* center = centers.ptr<float>(k);
-                    const double dist = hal::normL2Sqr_(sample, center, dims);
-
-                    if (min_dist > dist)
+                    if (min_dist > dist[k])
                     {
-                        min_dist = dist;
+                        min_dist = dist[k];
                         k_best = k;
                     }
                 }
@@ -221,8 +277,268 @@ private:
     int *labels;
     const Mat& data;
     const Mat& centers;
+    const Mat& centersT;
+};
+
+/*
+Assignment step with Hamerly's bounds (G. Hamerly, "Making k-means even faster", SDM 2010).
+upper[i] bounds the distance from the sample to its center, lower[i] the distance to any other
+center; both are moved by the center shifts of the previous update. A sample keeps its label
+without computing the distances to all centers while its upper bound is below the lower bound
+and below half the distance from its center to the nearest other center. The bounds need O(N)
+memory, unlike the O(N*K) of Elkan's variant. The margin keeps rounding errors of the bounds
+from changing the result compared to the plain assignment step.
+*/
+class KMeansHamerlyAssigner : public ParallelLoopBody
+{
+public:
+    KMeansHamerlyAssigner(int *labels_, float *upper_, float *lower_,
+                          const Mat& data_, const Mat& centers_, const Mat& centersT_,
+                          const float *halfSeparation_, const float *shifts_, bool fullPass_)
+        : labels(labels_), upper(upper_), lower(lower_),
+          data(data_), centers(centers_), centersT(centersT_),
+          halfSeparation(halfSeparation_), shifts(shifts_), fullPass(fullPass_)
+    {
+        maxShift[0] = maxShift[1] = 0.f;
+        maxShiftIdx = -1;
+        if (!fullPass)
+        {
+            for (int k = 0; k < centers.rows; k++)
+            {
+                if (shifts[k] > maxShift[0])
+                {
+                    maxShift[1] = maxShift[0];
+                    maxShift[0] = shifts[k];
+                    maxShiftIdx = k;
+                }
+                else
+                    maxShift[1] = std::max(maxShift[1], shifts[k]);
+            }
+        }
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        const float margin = 1.f - 1e-4f;
+        const int K = centers.rows;
+        const int dims = centers.cols;
+        cv::AutoBuffer<float, 64> _dist(K);
+        float* dist = _dist.data();
+
+        for (int i = range.start; i < range.end; i++)
+        {
+            const float* sample = data.ptr<float>(i);
+            if (!fullPass)
+            {
+                const int a = labels[i];
+                upper[i] += shifts[a];
+                lower[i] -= maxShift[a == maxShiftIdx ? 1 : 0];
+
+                float bound = std::max(halfSeparation[a], lower[i])*margin;
+                if (upper[i] < bound)
+                    continue;
+                upper[i] = std::sqrt(hal::normL2Sqr_(sample, centers.ptr<float>(a), dims));
+                if (upper[i] < bound)
+                    continue;
+            }
+
+            distancesToCenters(sample, centers, centersT, dist);
+            // ties go to the first center, as in KMeansDistanceComputer
+            int k_best = 0;
+            float d0 = dist[0], d1 = FLT_MAX;
+            for (int k = 1; k < K; k++)
+            {
+                if (dist[k] < d0)
+                {
+                    d1 = d0;
+                    d0 = dist[k];
+                    k_best = k;
+                }
+                else if (dist[k] < d1)
+                    d1 = dist[k];
+            }
+            labels[i] = k_best;
+            upper[i] = std::sqrt(d0);
+            lower[i] = std::sqrt(d1);
+        }
+    }
+
+private:
+    KMeansHamerlyAssigner& operator=(const KMeansHamerlyAssigner&); // = delete
+
+    int *labels;
+    float *upper;
+    float *lower;
+    const Mat& data;
+    const Mat& centers;
+    const Mat& centersT;
+    const float *halfSeparation;
+    const float *shifts;
+    bool fullPass;
+    float maxShift[2];
+    int maxShiftIdx;
 };
 
+/*
+Sums the samples of every cluster. The samples are split into a fixed number of chunks
+(independent of the number of threads, so the result is reproducible), each chunk has its
+own partial sums, which are then added up in order.
+*/
+class KMeansCentersAccumulator : public ParallelLoopBody
+{
+public:
+    KMeansCentersAccumulator(Mat& sums_, Mat& counts_, const Mat& data_, const int *labels_, int chunkSize_)
+        : sums(sums_), counts(counts_), data(data_), labels(labels_), chunkSize(chunkSize_)
+    { }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        const int N = data.rows;
+        const int dims = data.cols;
+
+        for (int c = range.start; c < range.end; c++)
+        {
+            float* sum = sums.ptr<float>(c);
+            int* count = counts.ptr<int>(c);
+            const int end = std::min(N, (c + 1)*chunkSize);
+            for (int i = c*chunkSize; i < end; i++)
+            {
+                const float* sample = data.ptr<float>(i);
+                const int k = labels[i];
+                float* center = sum + (size_t)k*dims;
+                for (int j = 0; j < dims; j++)
+                    center[j] += sample[j];
+                count[k]++;
+            }
+        }
+    }
+
+private:
+    KMeansCentersAccumulator& operator=(const KMeansCentersAccumulator&); // = delete
+
+    Mat& sums;
+    Mat& counts;
+    const Mat& data;
+    const int *labels;
+    const int chunkSize;
+};
+
+static void accumulateCenters(const Mat& data, const int* labels, Mat& centers, int* counters)
+{
+    CV_TRACE_FUNCTION();
+    const int N = data.rows, K = centers.rows, dims = centers.cols;
+
+    int nchunks = std::min(std::max(N >> 15, 1), 64);
+    while (nchunks > 1 && (size_t)nchunks*K*dims > ((size_t)1 << 22))
+        nchunks >>= 1;
+    const int chunkSize = divUp(N, nchunks);
+    nchunks = divUp(N, chunkSize);
+
+    if (nchunks == 1)
+    {
+        centers = Scalar(0);
+        Mat sums(1, K*dims, CV_32F, centers.ptr<float>()), counts(1, K, CV_32S, counters);
+        counts = Scalar(0);
+        KMeansCentersAccumulator(sums, counts, data, labels, chunkSize)(Range(0, 1));
+        return;
+    }
+
+    Mat sums(nchunks, K*dims, CV_32F, Scalar(0)), counts(nchunks, K, CV_32S, Scalar(0));
+    parallel_for_(Range(0, nchunks), KMeansCentersAccumulator(sums, counts, data, labels, chunkSize), nchunks);
+
+    sums.row(0).reshape(1, K).copyTo(centers);
+    for (int k = 0; k < K; k++)
+        counters[k] = counts.at<int>(0, k);
+    for (int c = 1; c < nchunks; c++)
+    {
+        const float* sum = sums.ptr<float>(c);
+        float* center = centers.ptr<float>();
+        for (int j = 0; j < K*dims; j++)
+            center[j] += sum[j];
+        const int* count = counts.ptr<int>(c);
+        for (int k = 0; k < K; k++)
+            counters[k] += count[k];
+    }
+}
+
+// half distance from every center to the nearest other center
+static void computeHalfSeparation(const Mat& centers, float* halfSeparation)
+{
+    const int K = centers.rows, dims = centers.cols;
+    for (int k = 0; k < K; k++)
+        halfSeparation[k] = FLT_MAX;
+    for (int k = 0; k < K; k++)
+    {
+        for (int k1 = k + 1; k1 < K; k1++)
+        {
+            float d = hal::normL2Sqr_(centers.ptr<float>(k), centers.ptr<float>(k1), dims);
+            halfSeparation[k] = std::min(halfSeparation[k], d);
+            halfSeparation[k1] = std::min(halfSeparation[k1], d);
+        }
+        halfSeparation[k] = 0.5f*std::sqrt(halfSeparation[k]);
+    }
+}
+
+/*
+Mini-batch k-means: D. Sculley, "Web-scale k-means clustering", WWW 2010.
+Every iteration assigns a random batch of samples and moves the centers towards them with
+a per-center learning rate of 1/(number of samples assigned to the center so far).
+Returns the compactness of the final assignment of all samples.
+*/
+static double kmeansMiniBatch(const Mat& data, Mat& centers, int* labels, double* dists,
+                              const TermCriteria& criteria, RNG& rng)
+{
+    CV_TRACE_FUNCTION();
+    const int N = data.rows, K = centers.rows, dims = centers.cols;
+    const int batchSize = std::min(N, std::max(CV_KMEANS_MINI_BATCH_SIZE, K));
+    const bool transposed = useTransposedCenters(K, dims);
+
+    Mat batch(batchSize, dims, CV_32F), centersT, old_centers;
+    cv::AutoBuffer<int, 64> counters(K), batchLabels(batchSize);
+    cv::AutoBuffer<double, 64> batchDists(batchSize);
+    for (int k = 0; k < K; k++)
+        counters[k] = 0;
+
+    for (int iter = 0; iter < criteria.maxCount; iter++)
+    {
+        for (int i = 0; i < batchSize; i++)
+        {
+            const float* sample = data.ptr<float>(rng.uniform(0, N));
+            std::copy(sample, sample + dims, batch.ptr<float>(i));
+        }
+        if (transposed)
+            transpose(centers, centersT);
+        parallel_for_(Range(0, batchSize),
+                      KMeansDistanceComputer<false>(batchDists.data(), batchLabels.data(), batch, centers, centersT),
+                      (double)divUp((size_t)(dims * batchSize * K), CV_KMEANS_PARALLEL_GRANULARITY));
+
+        centers.copyTo(old_centers);
+        for (int i = 0; i < batchSize; i++)
+        {
+            const int k = batchLabels[i];
+            const float* sample = batch.ptr<float>(i);
+            float* center = centers.ptr<float>(k);
+            float eta = 1.f/++counters[k];
+            for (int j = 0; j < dims; j++)
+                center[j] += (sample[j] - center[j])*eta;
+        }
+
+        double max_center_shift = 0;
+        for (int k = 0; k < K; k++)
+            max_center_shift = std::max(max_center_shift, (double)hal::normL2Sqr_(centers.ptr<float>(k), old_centers.ptr<float>(k), dims));
+        if (max_center_shift <= criteria.epsilon)
+            break;
+    }
+
+    if (transposed)
+        transpose(centers, centersT);
+    parallel_for_(Range(0, N), KMeansDistanceComputer<false>(dists, labels, data, centers, centersT),
+                  (double)divUp((size_t)(dims * N * K), CV_KMEANS_PARALLEL_GRANULARITY));
+    return sum(Mat(Size(N, 1), CV_64F, dists))[0];
+}
+
 }
 
 double cv::kmeans( InputArray _data, int K,
@@ -273,9 +589,17 @@ double cv::kmeans( InputArray _data, int K,
     }
     int* labels = _labels.ptr<int>();
 
-    Mat centers(K, dims, type), old_centers(K, dims, type), temp(1, dims, type);
+    const bool miniBatch = (flags & KMEANS_MINI_BATCH) != 0;
+    const bool transposed = useTransposedCenters(K, dims);
+    const bool pruned = !miniBatch && K > 2;
+
+    Mat centers(K, dims, type), old_centers(K, dims, type), temp(1, dims, type), centersT;
     cv::AutoBuffer<int, 64> counters(K);
     cv::AutoBuffer<double, 64> dists(N);
+    cv::AutoBuffer<float, 0> bounds(pruned ? N*2 : 0);
+    cv::AutoBuffer<float, 64> centerInfo(K*2);
+    float* upper = bounds.data(), *lower = upper + (pruned ? N : 0);
+    float* halfSeparation = centerInfo.data(), *shifts = halfSeparation + K;
     RNG& rng = theRNG();
 
     if (criteria.type & TermCriteria::EPS)
@@ -285,7 +609,7 @@ double cv::kmeans( InputArray _data, int K,
     criteria.epsilon *= criteria.epsilon;
 
     if (criteria.type & TermCriteria::COUNT)
-        criteria.maxCount = std::min(std::max(criteria.maxCount, 2), 100);
+        criteria.maxCount = miniBatch ? std::max(criteria.maxCount, 1) : std::min(std::max(criteria.maxCount, 2), 100);
     else
         criteria.maxCount = 100;
 
@@ -319,6 +643,7 @@ double cv::kmeans( InputArray _data, int K,
     for (int a = 0; a < attempts; a++)
     {
         double compactness = 0;
+        bool boundsValid = false;
 
         for (int iter = 0; ;)
         {
@@ -329,7 +654,18 @@ double cv::kmeans( InputArray _data, int K,
             if (iter == 0 && (a > 0 || !(flags & KMEANS_USE_INITIAL_LABELS)))
             {
                 if (flags & KMEANS_PP_CENTERS)
-                    generateCentersPP(data, centers, K, rng, SPP_TRIALS);
+                {
+                    // in the mini-batch mode seed on a random subset, k-means++ over all samples is O(N*K)
+                    Mat seeds = data;
+                    const int nseeds = std::min(N, std::max(3*CV_KMEANS_MINI_BATCH_SIZE, K));
+                    if (miniBatch && nseeds < N)
+                    {
+                        seeds = Mat(nseeds, dims, type);
+                        for (int i = 0; i < nseeds; i++)
+                            data.row(rng.uniform(0, N)).copyTo(seeds.row(i));
+                    }
+                    generateCentersPP(seeds, centers, K, rng, SPP_TRIALS);
+                }
                 else
                 {
                     for (int k = 0; k < K; k++)
@@ -339,19 +675,7 @@ double cv::kmeans( InputArray _data, int K,
             else
             {
                 // compute centers
-                centers = Scalar(0);
-                for (int k = 0; k < K; k++)
-                    counters[k] = 0;
-
-                for (int i = 0; i < N; i++)
-                {
-                    const float* sample = data.ptr<float>(i);
-                    int k = labels[i];
-                    float* center = centers.ptr<float>(k);
-                    for (int j = 0; j < dims; j++)
-                        center[j] += sample[j];
-                    counters[k]++;
-                }
+                accumulateCenters(data, labels, centers, counters.data());
 
                 for (int k = 0; k < K; k++)
                 {
@@ -394,6 +718,8 @@ double cv::kmeans( InputArray _data, int K,
                     counters[max_k]--;
                     counters[k]++;
                     labels[farthest_i] = k;
+                    if (pruned)
+                        upper[farthest_i] = FLT_MAX;
 
                     const float* sample = data.ptr<float>(farthest_i);
                     float* cur_center = centers.ptr<float>(k);
@@ -423,10 +749,17 @@ double cv::kmeans( InputArray _data, int K,
                             dist += t*t;
                         }
                         max_center_shift = std::max(max_center_shift, dist);
+                        shifts[k] = (float)std::sqrt(dist);
                     }
                 }
             }
 
+            if (miniBatch)
+            {
+                compactness = kmeansMiniBatch(data, centers, labels, dists.data(), criteria, rng);
+                break;
+            }
+
             bool isLastIter = (++iter == MAX(criteria.maxCount, 2) || max_center_shift <= criteria.epsilon);
 
             if (isLastIter)
@@ -439,7 +772,16 @@ double cv::kmeans( InputArray _data, int K,
             else
             {
                 // assign labels
-                parallel_for_(Range(0, N), KMeansDistanceComputer<false>(dists.data(), labels, data, centers), (double)divUp((size_t)(dims * N * K), CV_KMEANS_PARALLEL_GRANULARITY));
+                if (transposed)
+                    transpose(centers, centersT);
+                if (pruned)
+                {
+                    computeHalfSeparation(centers, halfSeparation);
+                    parallel_for_(Range(0, N), KMeansHamerlyAssigner(labels, upper, lower, data, centers, centersT, halfSeparation, shifts, !boundsValid), (double)divUp((size_t)(dims * N * K), CV_KMEANS_PARALLEL_GRANULARITY));
+                    boundsValid = true;
+                }
+                else
+                    parallel_for_(Range(0, N), KMeansDistanceComputer<false>(dists.data(), labels, data, centers, centersT), (double)divUp((size_t)(dims * N * K), CV_KMEANS_PARALLEL_GRANULARITY));
             }
         }
 
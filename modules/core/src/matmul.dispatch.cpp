@@ -430,6 +430,264 @@ void gemm(InputArray matA, InputArray matB, double alpha,
 }
 
 
+/****************************************************************************************\
+*                                 Batched small matrices                                 *
+\****************************************************************************************/
+
+// matrices up to this size are processed with SIMD across the batch dimension
+static const int BATCHED_SIMD_MAX_SIZE = 8;
+
+// Returns batch size of N x rows x cols matrix or -1 for 2D matrix (the same operand for all elements of the batch)
+static int getBatchedMatrices(const Mat& m, bool transposed, int& rows, int& cols, BatchedMatrices& b)
+{
+    CV_Assert(m.channels() == 1 && (m.dims == 2 || m.dims == 3));
+    const size_t esz = m.elemSize();
+    int N = -1;
+    b.data = m.data;
+    b.colStep = 1;
+    if (m.dims == 3)
+    {
+        N = m.size[0];
+        rows = m.size[1];
+        cols = m.size[2];
+        b.batchStep = m.step[0] / esz;
+        b.rowStep = m.step[1] / esz;
+    }
+    else
+    {
+        rows = m.rows;
+        cols = m.cols;
+        b.batchStep = 0;
+        b.rowStep = m.step[0] / esz;
+    }
+    if (transposed)
+    {
+        std::swap(rows, cols);
+        std::swap(b.rowStep, b.colStep);
+    }
+    return N;
+}
+
+static void updateBatchSize(int& N, int n)
+{
+    if (n < 0)
+        return;
+    CV_Assert(N < 0 || N == n);
+    N = n;
+}
+
+// i-th matrix of the batch as 2D matrix header
+static Mat getBatchElement(const Mat& m, int i)
+{
+    if (m.dims == 2)
+        return m;
+    return Mat(m.size[1], m.size[2], m.type(), (void*)m.ptr(i), m.step[1]);
+}
+
+class GemmBatchedInvoker : public ParallelLoopBody
+{
+public:
+    GemmBatchedInvoker(const Mat& A_, const Mat& B_, double alpha_, const Mat& C_, double beta_, Mat& D_, int flags_,
+                       const BatchedMatrices& a_, const BatchedMatrices& b_, const BatchedMatrices& c_, const BatchedMatrices& d_,
+                       int m_, int n_, int k_)
+        : A(A_), B(B_), C(C_), D(D_), alpha(alpha_), beta(beta_), flags(flags_),
+          a(a_), b(b_), c(c_), d(d_), m(m_), n(n_), k(k_)
+    {}
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        if (std::max(m, std::max(n, k)) <= BATCHED_SIMD_MAX_SIZE)
+        {
+            if (A.depth() == CV_32F)
+            {
+                CV_CPU_DISPATCH(gemmBatched32f, (a, b, (float)alpha, c, (float)beta, d, m, n, k, range.start, range.end),
+                    CV_CPU_DISPATCH_MODES_ALL);
+            }
+            else
+            {
+                CV_CPU_DISPATCH(gemmBatched64f, (a, b, alpha, c, beta, d, m, n, k, range.start, range.end),
+                    CV_CPU_DISPATCH_MODES_ALL);
+            }
+            return;
+        }
+
+        for (int i = range.start; i < range.end; i++)
+        {
+            Mat Di = getBatchElement(D, i);
+            gemm(getBatchElement(A, i), getBatchElement(B, i), alpha,
+                 C.empty() ? Mat() : getBatchElement(C, i), beta, Di, flags);
+        }
+    }
+
+private:
+    const Mat &A, &B, &C;
+    Mat& D;
+    double alpha, beta;
+    int flags;
+    BatchedMatrices a, b, c, d;
+    int m, n, k;
+};
+
+void gemmBatched(InputArray _src1, InputArray _src2, double alpha,
+                 InputArray _src3, double beta, OutputArray _dst, int flags)
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat A = _src1.getMat(), B = _src2.getMat(), C = beta != 0.0 ? _src3.getMat() : Mat();
+    const int type = A.type();
+    CV_Assert_N(type == B.type(), (type == CV_32FC1 || type == CV_64FC1));
+
+    BatchedMatrices a, b, c = BatchedMatrices(), d;
+    int m = 0, n = 0, n2 = 0, k = 0, N = -1;
+    updateBatchSize(N, getBatchedMatrices(A, (flags & GEMM_1_T) != 0, m, n, a));
+    updateBatchSize(N, getBatchedMatrices(B, (flags & GEMM_2_T) != 0, n2, k, b));
+    CV_Assert(n == n2);
+    if (!C.empty())
+    {
+        int m3 = 0, k3 = 0;
+        CV_Assert(C.type() == type);
+        updateBatchSize(N, getBatchedMatrices(C, (flags & GEMM_3_T) != 0, m3, k3, c));
+        CV_Assert(m3 == m && k3 == k);
+    }
+    CV_Assert(N >= 0 && "At least one operand must be N x rows x cols batch");
+
+    const int sizes[] = { N, m, k };
+    _dst.create(3, sizes, type);
+    Mat D = _dst.getMat(), DProxy = D;
+    if (N == 0)
+        return;
+    if (D.data == A.data || D.data == B.data || D.data == C.data)
+        DProxy = Mat(3, sizes, type);
+    int m_d = 0, k_d = 0;
+    getBatchedMatrices(DProxy, false, m_d, k_d, d);
+
+    GemmBatchedInvoker invoker(A, B, alpha, C, beta, DProxy, flags, a, b, c, d, m, n, k);
+    parallel_for_(Range(0, N), invoker, (double)N * m * n * k / (1 << 14));
+
+    if (DProxy.data != D.data)
+        DProxy.copyTo(D);
+}
+
+// inversion if B is empty
+class SolveBatchedInvoker : public ParallelLoopBody
+{
+public:
+    SolveBatchedInvoker(const Mat& A_, const Mat& B_, Mat& D_, uchar* status_, int method_,
+                        const BatchedMatrices& a_, const BatchedMatrices& b_, const BatchedMatrices& d_,
+                        int m_, int n_, bool useLU_)
+        : A(A_), B(B_), D(D_), status(status_), method(method_),
+          a(a_), b(b_), d(d_), m(m_), n(n_), useLU(useLU_)
+    {}
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        if (useLU)
+        {
+            if (A.depth() == CV_32F)
+            {
+                CV_CPU_DISPATCH(solveBatchedLU32f, (a, b, d, status, m, n, range.start, range.end),
+                    CV_CPU_DISPATCH_MODES_ALL);
+            }
+            else
+            {
+                CV_CPU_DISPATCH(solveBatchedLU64f, (a, b, d, status, m, n, range.start, range.end),
+                    CV_CPU_DISPATCH_MODES_ALL);
+            }
+            return;
+        }
+
+        const bool singularIsError = (method & ~DECOMP_NORMAL) == DECOMP_LU || (method & ~DECOMP_NORMAL) == DECOMP_CHOLESKY;
+        for (int i = range.start; i < range.end; i++)
+        {
+            Mat Di = getBatchElement(D, i);
+            bool ok = B.empty() ? invert(getBatchElement(A, i), Di, method) != 0 :
+                                  solve(getBatchElement(A, i), getBatchElement(B, i), Di, method);
+            if (!ok && singularIsError)
+                Di = Scalar::all(0);
+            status[i] = ok ? 1 : 0;
+        }
+    }
+
+private:
+    const Mat &A, &B;
+    Mat& D;
+    uchar* status;
+    int method;
+    BatchedMatrices a, b, d;
+    int m, n;
+    bool useLU;
+};
+
+static bool solveBatched_(const Mat& A, const Mat& B, OutputArray _dst, int method, OutputArray _status)
+{
+    const int type = A.type();
+    CV_Assert(type == CV_32FC1 || type == CV_64FC1);
+
+    BatchedMatrices a, b = BatchedMatrices(), d;
+    int m = 0, m1 = 0, n = 0, N = -1;
+    updateBatchSize(N, getBatchedMatrices(A, false, m, m1, a));
+    if (!B.empty())
+    {
+        int m2 = 0;
+        CV_Assert(B.type() == type);
+        updateBatchSize(N, getBatchedMatrices(B, false, m2, n, b));
+        CV_Assert(m2 == m);
+    }
+    else
+        n = m;  // inversion
+    CV_Assert(N >= 0 && "Left-hand side must be N x rows x cols batch");
+
+    const bool is_normal = (method & DECOMP_NORMAL) != 0;
+    if ((method & ~DECOMP_NORMAL) == DECOMP_LU || (method & ~DECOMP_NORMAL) == DECOMP_CHOLESKY)
+        CV_Assert(m == m1 || is_normal);
+    const bool useLU = method == DECOMP_LU && m <= BATCHED_SIMD_MAX_SIZE && n <= BATCHED_SIMD_MAX_SIZE;
+
+    const int sizes[] = { N, m1, B.empty() ? m : n };
+    _dst.create(3, sizes, type);
+    Mat D = _dst.getMat(), DProxy = D;
+
+    Mat status;
+    if (_status.needed())
+    {
+        _status.create(N, 1, CV_8UC1);
+        status = _status.getMat();
+    }
+    else
+        status.create(N, 1, CV_8UC1);
+    if (N == 0)
+        return true;
+
+    if (D.data == A.data || D.data == B.data)
+        DProxy = Mat(3, sizes, type);
+    int m_d = 0, n_d = 0;
+    getBatchedMatrices(DProxy, false, m_d, n_d, d);
+
+    SolveBatchedInvoker invoker(A, B, DProxy, status.ptr(), method, a, b, d, m, n, useLU);
+    parallel_for_(Range(0, N), invoker, (double)N * m * m * (m + n) / (1 << 14));
+
+    if (DProxy.data != D.data)
+        DProxy.copyTo(D);
+    return countNonZero(status) == N;
+}
+
+bool solveBatched(InputArray _src1, InputArray _src2, OutputArray _dst, int method, OutputArray _status)
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat B = _src2.getMat();
+    CV_Assert(!B.empty());
+    return solveBatched_(_src1.getMat(), B, _dst, method, _status);
+}
+
+bool invertBatched(InputArray _src, OutputArray _dst, int method, OutputArray _status)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert((method & DECOMP_NORMAL) == 0);
+    return solveBatched_(_src.getMat(), Mat(), _dst, method, _status);
+}
+
+
 
 /****************************************************************************************\
 *                                        Transform                                       *
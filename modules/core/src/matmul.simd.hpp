@@ -57,6 +57,17 @@ typedef void (*ScaleAddFunc)(const uchar* src1, const uchar* src2, uchar* dst, i
 typedef void (*MulTransposedFunc)(const Mat& src, const/*preallocated*/ Mat& dst, const Mat& delta, double scale);
 typedef double (*MahalanobisImplFunc)(const Mat& v1, const Mat& v2, const Mat& icovar, double *diff_buffer /*[len]*/, int len /*=v1.total()*/);
 
+// Batch of small matrices: element (r, c) of the i-th matrix is data[i*batchStep + r*rowStep + c*colStep].
+// Steps are in elements, batchStep == 0 means the same matrix for all elements of the batch.
+#ifndef OPENCV_CORE_MATMUL_BATCHED_MATRICES
+#define OPENCV_CORE_MATMUL_BATCHED_MATRICES
+struct BatchedMatrices
+{
+    void* data;
+    size_t batchStep, rowStep, colStep;
+};
+#endif
+
 CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
 
 // forward declarations
@@ -92,6 +103,20 @@ double dotProd_32s(const int* src1, const int* src2, int len);
 double dotProd_32f(const float* src1, const float* src2, int len);
 double dotProd_64f(const double* src1, const double* src2, int len);
 
+// processes matrices [start, end) of the batch
+void gemmBatched32f(const BatchedMatrices& src1, const BatchedMatrices& src2, float alpha,
+                    const BatchedMatrices& src3, float beta, const BatchedMatrices& dst,
+                    int m, int n, int k, int start, int end);
+void gemmBatched64f(const BatchedMatrices& src1, const BatchedMatrices& src2, double alpha,
+                    const BatchedMatrices& src3, double beta, const BatchedMatrices& dst,
+                    int m, int n, int k, int start, int end);
+// solves src1*dst = src2 with LU decomposition (src2.data == NULL means identity matrix),
+// status[i] is set to 0 for singular systems
+void solveBatchedLU32f(const BatchedMatrices& src1, const BatchedMatrices& src2, const BatchedMatrices& dst,
+                       uchar* status, int m, int n, int start, int end);
+void solveBatchedLU64f(const BatchedMatrices& src1, const BatchedMatrices& src2, const BatchedMatrices& dst,
+                       uchar* status, int m, int n, int start, int end);
+
 
 
 #ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
@@ -2622,6 +2647,281 @@ double dotProd_64f(const double* src1, const double* src2, int len)
     return dotProd_(src1, src2, len);
 }
 
+
+
+/*****************************************************************************************                                 Batched small matrices                                 *
+\****************************************************************************************/
+
+// Matrices of the batch are transposed into "element-major" buffer: buf[(r*cols + c)*lanes + l],
+// so each SIMD vector holds the same element of `lanes` different matrices.
+// Unused lanes (count < lanes) are filled with identity matrices.
+template<typename _Tp> static void
+gatherBatch(const BatchedMatrices& src, int idx, int count, int lanes, int rows, int cols, _Tp* buf)
+{
+    for (int l = 0; l < lanes; l++)
+    {
+        if (l < count)
+        {
+            const _Tp* p = (const _Tp*)src.data + (size_t)(idx + l)*src.batchStep;
+            for (int r = 0; r < rows; r++)
+                for (int c = 0; c < cols; c++)
+                    buf[(r*cols + c)*lanes + l] = p[r*src.rowStep + c*src.colStep];
+        }
+        else
+        {
+            for (int r = 0; r < rows; r++)
+                for (int c = 0; c < cols; c++)
+                    buf[(r*cols + c)*lanes + l] = r == c ? (_Tp)1 : (_Tp)0;
+        }
+    }
+}
+
+template<typename _Tp> static void
+scatterBatch(const _Tp* buf, int idx, int count, int lanes, int rows, int cols, const BatchedMatrices& dst)
+{
+    for (int l = 0; l < count; l++)
+    {
+        _Tp* p = (_Tp*)dst.data + (size_t)(idx + l)*dst.batchStep;
+        for (int r = 0; r < rows; r++)
+            for (int c = 0; c < cols; c++)
+                p[r*dst.rowStep + c*dst.colStep] = buf[(r*cols + c)*lanes + l];
+    }
+}
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+static inline v_float32 vx_setall_batched(float v) { return vx_setall_f32(v); }
+#endif
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+static inline v_float64 vx_setall_batched(double v) { return vx_setall_f64(v); }
+#endif
+
+template<typename _Tp, typename _VTp> static void
+gemmBatchedSIMD_(const BatchedMatrices& src1, const BatchedMatrices& src2, _Tp alpha,
+                 const BatchedMatrices& src3, _Tp beta, const BatchedMatrices& dst,
+                 int m, int n, int k, int start, int end)
+{
+    const int lanes = VTraits<_VTp>::vlanes();
+    AutoBuffer<_Tp> _buf((m*n + n*k + m*k)*lanes);
+    _Tp* A = _buf.data();
+    _Tp* B = A + m*n*lanes;
+    _Tp* D = B + n*k*lanes;
+    const _VTp valpha = vx_setall_batched(alpha), vbeta = vx_setall_batched(beta);
+
+    for (int i = start; i < end; i += lanes)
+    {
+        const int count = std::min(lanes, end - i);
+        gatherBatch(src1, i, count, lanes, m, n, A);
+        gatherBatch(src2, i, count, lanes, n, k, B);
+        if (src3.data)
+            gatherBatch(src3, i, count, lanes, m, k, D);
+
+        for (int r = 0; r < m; r++)
+        {
+            for (int c = 0; c < k; c++)
+            {
+                _VTp s = vx_setall_batched((_Tp)0);
+                for (int p = 0; p < n; p++)
+                    s = v_fma(vx_load(A + (r*n + p)*lanes), vx_load(B + (p*k + c)*lanes), s);
+                s = v_mul(s, valpha);
+                if (src3.data)
+                    s = v_fma(vx_load(D + (r*k + c)*lanes), vbeta, s);
+                v_store(D + (r*k + c)*lanes, s);
+            }
+        }
+        scatterBatch(D, i, count, lanes, m, k, dst);
+    }
+    vx_cleanup();
+}
+
+template<typename _VTp, typename _Tp> static inline void
+swapBatchLanes(const _VTp& mask, _Tp* a, _Tp* b)
+{
+    _VTp va = vx_load(a), vb = vx_load(b);
+    v_store(a, v_select(mask, vb, va));
+    v_store(b, v_select(mask, va, vb));
+}
+
+// LU decomposition with partial pivoting (the same as hal::LU), pivot rows are chosen for each lane
+template<typename _Tp, typename _VTp> static void
+solveBatchedLUSIMD_(const BatchedMatrices& src1, const BatchedMatrices& src2, const BatchedMatrices& dst,
+                    uchar* status, int m, int n, int start, int end, _Tp eps)
+{
+    const int lanes = VTraits<_VTp>::vlanes();
+    AutoBuffer<_Tp> _buf((m*m + m*n + 1)*lanes);
+    _Tp* A = _buf.data();
+    _Tp* B = A + m*m*lanes;
+    _Tp* S = B + m*n*lanes;
+    const _VTp vzero = vx_setall_batched((_Tp)0), vone = vx_setall_batched((_Tp)1);
+    const _VTp vminus_one = vx_setall_batched((_Tp)-1), veps = vx_setall_batched(eps);
+
+    for (int i = start; i < end; i += lanes)
+    {
+        const int count = std::min(lanes, end - i);
+        gatherBatch(src1, i, count, lanes, m, m, A);
+        if (src2.data)
+            gatherBatch(src2, i, count, lanes, m, n, B);
+        else
+        {
+            for (int r = 0; r < m; r++)
+                for (int c = 0; c < n; c++)
+                    v_store(B + (r*n + c)*lanes, r == c ? vone : vzero);
+        }
+
+        _VTp singular = vzero;
+        for (int p = 0; p < m; p++)
+        {
+            _Tp* Ap = A + p*m*lanes;
+            _Tp* Bp = B + p*n*lanes;
+            for (int r = p + 1; r < m; r++)
+            {
+                _Tp* Ar = A + r*m*lanes;
+                _Tp* Br = B + r*n*lanes;
+                _VTp mask = v_gt(v_abs(vx_load(Ar + p*lanes)), v_abs(vx_load(Ap + p*lanes)));
+                for (int c = p; c < m; c++)
+                    swapBatchLanes(mask, Ap + c*lanes, Ar + c*lanes);
+                for (int c = 0; c < n; c++)
+                    swapBatchLanes(mask, Bp + c*lanes, Br + c*lanes);
+            }
+
+            _VTp pivot = vx_load(Ap + p*lanes);
+            _VTp bad = v_lt(v_abs(pivot), veps);
+            singular = v_or(singular, bad);
+            pivot = v_select(bad, vone, pivot);
+            v_store(Ap + p*lanes, pivot);
+            _VTp d = v_div(vminus_one, pivot);
+
+            for (int r = p + 1; r < m; r++)
+            {
+                _Tp* Ar = A + r*m*lanes;
+                _Tp* Br = B + r*n*lanes;
+                _VTp alpha = v_mul(vx_load(Ar + p*lanes), d);
+                for (int c = p + 1; c < m; c++)
+                    v_store(Ar + c*lanes, v_fma(alpha, vx_load(Ap + c*lanes), vx_load(Ar + c*lanes)));
+                for (int c = 0; c < n; c++)
+                    v_store(Br + c*lanes, v_fma(alpha, vx_load(Bp + c*lanes), vx_load(Br + c*lanes)));
+            }
+        }
+
+        for (int r = m - 1; r >= 0; r--)
+        {
+            const _Tp* Ar = A + r*m*lanes;
+            _VTp diag = vx_load(Ar + r*lanes);
+            for (int c = 0; c < n; c++)
+            {
+                _VTp s = vx_load(B + (r*n + c)*lanes);
+                for (int q = r + 1; q < m; q++)
+                    s = v_sub(s, v_mul(vx_load(Ar + q*lanes), vx_load(B + (q*n + c)*lanes)));
+                v_store(B + (r*n + c)*lanes, v_select(singular, vzero, v_div(s, diag)));
+            }
+        }
+
+        scatterBatch(B, i, count, lanes, m, n, dst);
+        v_store(S, v_select(singular, vzero, vone));
+        for (int l = 0; l < count; l++)
+            status[i + l] = S[l] != 0 ? 1 : 0;
+    }
+    vx_cleanup();
+}
+
+template<typename _Tp> static void
+gemmBatchedScalar_(const BatchedMatrices& src1, const BatchedMatrices& src2, _Tp alpha,
+                   const BatchedMatrices& src3, _Tp beta, const BatchedMatrices& dst,
+                   int m, int n, int k, int start, int end)
+{
+    for (int i = start; i < end; i++)
+    {
+        const _Tp* a = (const _Tp*)src1.data + (size_t)i*src1.batchStep;
+        const _Tp* b = (const _Tp*)src2.data + (size_t)i*src2.batchStep;
+        const _Tp* c3 = (const _Tp*)src3.data + (size_t)i*src3.batchStep;
+        _Tp* d = (_Tp*)dst.data + (size_t)i*dst.batchStep;
+        for (int r = 0; r < m; r++)
+            for (int c = 0; c < k; c++)
+            {
+                _Tp s = 0;
+                for (int p = 0; p < n; p++)
+                    s += a[r*src1.rowStep + p*src1.colStep]*b[p*src2.rowStep + c*src2.colStep];
+                s *= alpha;
+                if (src3.data)
+                    s += beta*c3[r*src3.rowStep + c*src3.colStep];
+                d[r*dst.rowStep + c*dst.colStep] = s;
+            }
+    }
+}
+
+static inline int batchedLU(float* A, size_t astep, int m, float* b, size_t bstep, int n)
+{
+    return hal::LU32f(A, astep, m, b, bstep, n);
+}
+
+static inline int batchedLU(double* A, size_t astep, int m, double* b, size_t bstep, int n)
+{
+    return hal::LU64f(A, astep, m, b, bstep, n);
+}
+
+template<typename _Tp> static void
+solveBatchedLUScalar_(const BatchedMatrices& src1, const BatchedMatrices& src2, const BatchedMatrices& dst,
+                      uchar* status, int m, int n, int start, int end)
+{
+    AutoBuffer<_Tp> _buf(m*m + m*n);
+    _Tp* A = _buf.data();
+    _Tp* B = A + m*m;
+    for (int i = start; i < end; i++)
+    {
+        gatherBatch(src1, i, 1, 1, m, m, A);
+        if (src2.data)
+            gatherBatch(src2, i, 1, 1, m, n, B);
+        else
+            gatherBatch(src2, i, 0, 1, m, n, B);  // identity
+        bool ok = batchedLU(A, m*sizeof(_Tp), m, B, n*sizeof(_Tp), n) != 0;
+        if (!ok)
+            std::fill(B, B + m*n, (_Tp)0);
+        scatterBatch(B, i, 1, 1, m, n, dst);
+        status[i] = ok ? 1 : 0;
+    }
+}
+
+void gemmBatched32f(const BatchedMatrices& src1, const BatchedMatrices& src2, float alpha,
+                    const BatchedMatrices& src3, float beta, const BatchedMatrices& dst,
+                    int m, int n, int k, int start, int end)
+{
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    gemmBatchedSIMD_<float, v_float32>(src1, src2, alpha, src3, beta, dst, m, n, k, start, end);
+#else
+    gemmBatchedScalar_<float>(src1, src2, alpha, src3, beta, dst, m, n, k, start, end);
+#endif
+}
+
+void gemmBatched64f(const BatchedMatrices& src1, const BatchedMatrices& src2, double alpha,
+                    const BatchedMatrices& src3, double beta, const BatchedMatrices& dst,
+                    int m, int n, int k, int start, int end)
+{
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+    gemmBatchedSIMD_<double, v_float64>(src1, src2, alpha, src3, beta, dst, m, n, k, start, end);
+#else
+    gemmBatchedScalar_<double>(src1, src2, alpha, src3, beta, dst, m, n, k, start, end);
+#endif
+}
+
+void solveBatchedLU32f(const BatchedMatrices& src1, const BatchedMatrices& src2, const BatchedMatrices& dst,
+                       uchar* status, int m, int n, int start, int end)
+{
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    solveBatchedLUSIMD_<float, v_float32>(src1, src2, dst, status, m, n, start, end, FLT_EPSILON*10);
+#else
+    solveBatchedLUScalar_<float>(src1, src2, dst, status, m, n, start, end);
+#endif
+}
+
+void solveBatchedLU64f(const BatchedMatrices& src1, const BatchedMatrices& src2, const BatchedMatrices& dst,
+                       uchar* status, int m, int n, int start, int end)
+{
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+    solveBatchedLUSIMD_<double, v_float64>(src1, src2, dst, status, m, n, start, end, DBL_EPSILON*100);
+#else
+    solveBatchedLUScalar_<double>(src1, src2, dst, status, m, n, start, end);
+#endif
+}
+
 #endif
 CV_CPU_OPTIMIZATION_NAMESPACE_END
 } // namespace
@@ -5,6 +5,13 @@
 #include "precomp.hpp"
 #include "bufferpool.impl.hpp"
 
+#include "opencv2/core/utils/hugepages_allocator.hpp"
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/logger.hpp>
+#include <opencv2/core/utils/trace.private.hpp>
+
+#include <atomic>
+
 namespace cv {
 
 void MatAllocator::map(UMatData*, AccessFlag) const
@@ -150,6 +157,10 @@ public:
         u->size = total;
         if(data0)
             u->flags |= UMatData::USER_ALLOCATED;
+#ifdef OPENCV_TRACE
+        else
+            CV_TRACE_NS::details::traceAllocation((int64)total);
+#endif
 
         return u;
     }
@@ -171,20 +182,60 @@ public:
         {
             fastFree(u->origdata);
             u->origdata = 0;
+#ifdef OPENCV_TRACE
+            CV_TRACE_NS::details::traceAllocation(-(int64)u->size);
+#endif
         }
         delete u;
     }
 };
 
+static
+MatAllocator* createDefaultAllocator()
+{
+    std::string name = toUpperCase(utils::getConfigurationParameterString("OPENCV_MAT_ALLOCATOR", ""));
+    if (name == "HUGEPAGES")
+        return utils::getHugePagesMatAllocator();
+    if (!name.empty() && name != "DEFAULT")
+        CV_LOG_WARNING(NULL, "OPENCV_MAT_ALLOCATOR: unknown allocator '" << name << "', standard allocator is used");
+    return Mat::getStdAllocator();
+}
+
 static
 MatAllocator*& getDefaultAllocatorMatRef()
 {
-    static MatAllocator* g_matAllocator = Mat::getStdAllocator();
+    static MatAllocator* g_matAllocator = createDefaultAllocator();
     return g_matAllocator;
 }
 
+namespace details {
+
+static std::atomic<int> g_numThreadMatAllocators(0);  // fast path: skip TLS access if thread allocators are not used
+
+MatAllocator* getThreadMatAllocator()
+{
+    if (g_numThreadMatAllocators.load(std::memory_order_relaxed) == 0)
+        return NULL;
+    return getCoreTlsData().matAllocator;
+}
+
+void setThreadMatAllocator(MatAllocator* allocator)
+{
+    MatAllocator*& threadAllocator = getCoreTlsData().matAllocator;
+    if (!threadAllocator && allocator)
+        g_numThreadMatAllocators++;
+    else if (threadAllocator && !allocator)
+        g_numThreadMatAllocators--;
+    threadAllocator = allocator;
+}
+
+}  // namespace details
+
 MatAllocator* Mat::getDefaultAllocator()
 {
+    MatAllocator* threadAllocator = details::getThreadMatAllocator();
+    if (threadAllocator)
+        return threadAllocator;
     return getDefaultAllocatorMatRef();
 }
 
@@ -12,6 +12,10 @@
 #include "precomp.hpp"
 #include <opencv2/core/utils/logger.hpp>
 
+#include "matrix_expressions.hpp"
+#include "matrix_expressions.simd.hpp"
+#include "matrix_expressions.simd_declarations.hpp" // defines CV_CPU_DISPATCH_MODES_ALL=AVX2,...,BASELINE based on CMakeLists.txt content
+
 namespace cv
 {
 
@@ -195,6 +199,37 @@ public:
     static void makeExpr(MatExpr& res, int method, int ndims, const int* sizes, int type, double alpha=1);
 };
 
+class ElementwiseProgram;
+
+// Fused chain of element-wise operations on floating-point matrices.
+// Expression graph is attached to MatExpr::a (see ElementwiseProgram), other fields are not used.
+class MatOp_Elementwise CV_FINAL : public MatOp
+{
+public:
+    MatOp_Elementwise() {}
+    virtual ~MatOp_Elementwise() {}
+
+    bool elementWise(const MatExpr& /*expr*/) const CV_OVERRIDE { return true; }
+    void assign(const MatExpr& expr, Mat& m, int type=-1) const CV_OVERRIDE;
+
+    void roi(const MatExpr& expr, const Range& rowRange, const Range& colRange, MatExpr& res) const CV_OVERRIDE;
+    void diag(const MatExpr& expr, int d, MatExpr& res) const CV_OVERRIDE;
+
+    Size size(const MatExpr& expr) const CV_OVERRIDE;
+    int type(const MatExpr& expr) const CV_OVERRIDE;
+
+    static const ElementwiseProgram& program(const MatExpr& e);
+    static void makeExpr(MatExpr& res, const ElementwiseProgram& p);
+
+    // Fuses 'e1 op e2' (op is one of '+', '-', '*', '/').
+    // Returns false if operands are not supported or the regular MatOp code doesn't need intermediate matrices.
+    static bool fuse(char op, const MatExpr& e1, const MatExpr& e2, double scale, MatExpr& res);
+    // Fuses 'e + s' ('+'), 's - e' ('-'), 'e * s[0]' ('*'), 's[0] / e' ('/'), 'abs(e)' ('a')
+    static bool fuse(char op, const MatExpr& e, const Scalar& s, MatExpr& res);
+};
+
+static MatOp_Elementwise g_MatOp_Elementwise;
+
 static MatOp_Initializer* getGlobalMatOpInitializer()
 {
     CV_SINGLETON_LAZY_INIT(MatOp_Initializer, new MatOp_Initializer())
@@ -212,6 +247,7 @@ static inline bool isSolve(const MatExpr& e) { return e.op == &g_MatOp_Solve; }
 //static inline bool isGEMM(const MatExpr& e) { return e.op == &g_MatOp_GEMM; }
 static inline bool isMatProd(const MatExpr& e) { return e.op == &g_MatOp_GEMM && (!e.c.data || e.beta == 0); }
 static inline bool isInitializer(const MatExpr& e) { return e.op == getGlobalMatOpInitializer(); }
+static inline bool isElementwise(const MatExpr& e) { return e.op == &g_MatOp_Elementwise; }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -329,6 +365,9 @@ void MatOp::add(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
 
     if( this == e2.op )
     {
+        if( MatOp_Elementwise::fuse('+', e1, e2, 1, res) )
+            return;
+
         double alpha = 1, beta = 1;
         Scalar s;
         Mat m1, m2;
@@ -360,6 +399,9 @@ void MatOp::add(const MatExpr& expr1, const Scalar& s, MatExpr& res) const
 {
     CV_INSTRUMENT_REGION();
 
+    if( MatOp_Elementwise::fuse('+', expr1, s, res) )
+        return;
+
     Mat m1;
     expr1.op->assign(expr1, m1);
     MatOp_AddEx::makeExpr(res, m1, Mat(), 1, 0, s);
@@ -372,6 +414,9 @@ void MatOp::subtract(const MatExpr& e1, const MatExpr& e2, MatExpr& res) const
 
     if( this == e2.op )
     {
+        if( MatOp_Elementwise::fuse('-', e1, e2, 1, res) )
+            return;
+
         double alpha = 1, beta = -1;
         Scalar s;
         Mat m1, m2;
@@ -403,6 +448,9 @@ void MatOp::subtract(const Scalar& s, const MatExpr& expr, MatExpr& res) const
 {
     CV_INSTRUMENT_REGION();
 
+    if( MatOp_Elementwise::fuse('-', expr, s, res) )
+        return;
+
     Mat m;
     expr.op->assign(expr, m);
     MatOp_AddEx::makeExpr(res, m, Mat(), -1, 0, s);
@@ -415,6 +463,9 @@ void MatOp::multiply(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double
 
     if( this == e2.op )
     {
+        if( MatOp_Elementwise::fuse('*', e1, e2, scale, res) )
+            return;
+
         Mat m1, m2;
 
         if( isReciprocal(e1) )
@@ -466,6 +517,9 @@ void MatOp::multiply(const MatExpr& expr, double s, MatExpr& res) const
 {
     CV_INSTRUMENT_REGION();
 
+    if( MatOp_Elementwise::fuse('*', expr, Scalar(s), res) )
+        return;
+
     Mat m;
     expr.op->assign(expr, m);
     MatOp_AddEx::makeExpr(res, m, Mat(), s, 0);
@@ -478,6 +532,9 @@ void MatOp::divide(const MatExpr& e1, const MatExpr& e2, MatExpr& res, double sc
 
     if( this == e2.op )
     {
+        if( MatOp_Elementwise::fuse('/', e1, e2, scale, res) )
+            return;
+
         if( isReciprocal(e1) && isReciprocal(e2) )
             MatOp_Bin::makeExpr(res, '/', e2.a, e1.a, e1.alpha/e2.alpha);
         else
@@ -518,6 +575,9 @@ void MatOp::divide(double s, const MatExpr& expr, MatExpr& res) const
 {
     CV_INSTRUMENT_REGION();
 
+    if( MatOp_Elementwise::fuse('/', expr, Scalar(s), res) )
+        return;
+
     Mat m;
     expr.op->assign(expr, m);
     MatOp_Bin::makeExpr(res, '/', m, Mat(), s);
@@ -528,6 +588,9 @@ void MatOp::abs(const MatExpr& expr, MatExpr& res) const
 {
     CV_INSTRUMENT_REGION();
 
+    if( MatOp_Elementwise::fuse('a', expr, Scalar(), res) )
+        return;
+
     Mat m;
     expr.op->assign(expr, m);
     MatOp_Bin::makeExpr(res, 'a', m, Mat());
@@ -1714,6 +1777,368 @@ inline void MatOp_Initializer::makeExpr(MatExpr& res, int method, int ndims, con
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+ElementwiseProgramFunc getElementwiseProgramFunc(int depth)
+{
+    CV_INSTRUMENT_REGION();
+    CV_CPU_DISPATCH(getElementwiseProgramFunc, (depth),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
+
+// Limit of nodes in the fused expression, longer chains are evaluated through temporary matrices
+static const int ELEMWISE_MAX_OPS = 64;
+
+class ElementwiseProgram
+{
+public:
+    std::vector<Mat> inputs;
+    std::vector<ElementwiseOp> ops;
+
+    int addOp(int code, int arg0, int arg1 = -1, double alpha = 1, double beta = 0)
+    {
+        ElementwiseOp op;
+        op.code = code;
+        op.arg0 = arg0;
+        op.arg1 = arg1;
+        op.alpha = alpha;
+        op.beta = beta;
+        op.s[0] = op.s[1] = op.s[2] = op.s[3] = 0;
+        ops.push_back(op);
+        return (int)ops.size() - 1;
+    }
+
+    int addInput(const Mat& m)
+    {
+        size_t i = 0;
+        for( ; i < inputs.size(); i++ )
+        {
+            const Mat& x = inputs[i];
+            if( x.data == m.data && x.step == m.step && x.size == m.size && x.type() == m.type() )
+                break;
+        }
+        if( i == inputs.size() )
+            inputs.push_back(m);
+        for( size_t k = 0; k < ops.size(); k++ )
+        {
+            if( ops[k].code == ELEMWISE_INPUT && ops[k].arg0 == (int)i )
+                return (int)k;
+        }
+        return addOp(ELEMWISE_INPUT, (int)i);
+    }
+
+    int addConst(const Scalar& s)
+    {
+        int k = addOp(ELEMWISE_CONST, -1);
+        for( int c = 0; c < 4; c++ )
+            ops[k].s[c] = s[c];
+        return k;
+    }
+
+    // appends nodes of other program, returns index of its result
+    int append(const ElementwiseProgram& p)
+    {
+        std::vector<int> remap(p.ops.size());
+        for( size_t k = 0; k < p.ops.size(); k++ )
+        {
+            ElementwiseOp op = p.ops[k];
+            if( op.code == ELEMWISE_INPUT )
+            {
+                remap[k] = addInput(p.inputs[op.arg0]);
+                continue;
+            }
+            if( op.arg0 >= 0 )
+                op.arg0 = remap[op.arg0];
+            if( op.arg1 >= 0 )
+                op.arg1 = remap[op.arg1];
+            ops.push_back(op);
+            remap[k] = (int)ops.size() - 1;
+        }
+        return remap.back();
+    }
+
+    // appends expression, returns index of its result or -1 if expression is not element-wise
+    int append(const MatExpr& e)
+    {
+        if( isIdentity(e) )
+            return addInput(e.a);
+        if( isElementwise(e) )
+            return append(MatOp_Elementwise::program(e));
+        if( isAddEx(e) )
+        {
+            int r = addInput(e.a);
+            if( e.b.data && e.beta != 0 )
+                r = addOp(ELEMWISE_ADDW, r, addInput(e.b), e.alpha, e.beta);
+            else if( e.alpha != 1 )
+                r = addOp(ELEMWISE_ADDW, r, -1, e.alpha);
+            if( e.s != Scalar() )
+            {
+                // MatOp_AddEx::assign() applies "real" scalar to all channels if addWeighted() or convertTo() is used
+                bool allChannels = e.s.isReal() && (e.b.data ? e.beta != 0 : fabs(e.alpha) != 1);
+                r = addOp(ELEMWISE_ADDW, r, addConst(allChannels ? Scalar::all(e.s[0]) : e.s), 1, 1);
+            }
+            return r;
+        }
+        if( e.op == &g_MatOp_Bin )
+        {
+            switch( e.flags )
+            {
+            case '*':
+                return addOp(ELEMWISE_MUL, addInput(e.a), addInput(e.b), e.alpha);
+            case '/':
+                if( e.b.data )
+                    return addOp(ELEMWISE_DIV, addInput(e.a), addInput(e.b), e.alpha);
+                return addOp(ELEMWISE_RECIP, addInput(e.a), -1, e.alpha);
+            case 'm':
+                return addOp(ELEMWISE_MIN, addInput(e.a), addInput(e.b));
+            case 'M':
+                return addOp(ELEMWISE_MAX, addInput(e.a), addInput(e.b));
+            case 'n':
+                return addOp(ELEMWISE_MIN, addInput(e.a), addConst(Scalar::all(e.s[0])));
+            case 'N':
+                return addOp(ELEMWISE_MAX, addInput(e.a), addConst(Scalar::all(e.s[0])));
+            case 'a':
+                return addOp(ELEMWISE_ABSDIFF, addInput(e.a), e.b.data ? addInput(e.b) : addConst(e.s));
+            default:
+                break;
+            }
+        }
+        return -1;
+    }
+
+    // all inputs must be floating-point 1D/2D arrays of the same size and type
+    bool isValid() const
+    {
+        if( inputs.empty() || ops.empty() || ops.size() > (size_t)ELEMWISE_MAX_OPS )
+            return false;
+        const Mat& m0 = inputs[0];
+        if( m0.empty() || m0.dims > 2 || (m0.depth() != CV_32F && m0.depth() != CV_64F) || m0.channels() > 4 )
+            return false;
+        for( size_t i = 1; i < inputs.size(); i++ )
+        {
+            if( inputs[i].size != m0.size || inputs[i].type() != m0.type() )
+                return false;
+        }
+        return true;
+    }
+
+    void run(Mat& dst) const;
+};
+
+class ElementwiseProgramInvoker : public ParallelLoopBody
+{
+public:
+    ElementwiseProgramInvoker(const ElementwiseProgram& p_, Mat& dst_, int len_, int chunk_)
+        : p(p_), dst(dst_), len(len_), chunk(chunk_)
+    {
+        func = getElementwiseProgramFunc(dst.depth());
+        CV_Assert(func);
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        const int nops = (int)p.ops.size(), ninputs = (int)p.inputs.size(), cn = dst.channels();
+        const size_t esz = dst.elemSize1();
+        const int nchunks = (len + chunk - 1) / chunk;
+        AutoBuffer<uchar> buf((size_t)nops*ELEMWISE_BLOCK_SIZE*sizeof(double));
+        AutoBuffer<const uchar*, 16> src(ninputs);
+        for( int idx = range.start; idx < range.end; idx++ )
+        {
+            int y = idx / nchunks, x = (idx % nchunks) * chunk;
+            for( int i = 0; i < ninputs; i++ )
+                src[i] = p.inputs[i].ptr(y) + x*esz;
+            func(&p.ops[0], nops, src.data(), dst.ptr(y) + x*esz, std::min(chunk, len - x), cn, buf.data());
+        }
+    }
+
+protected:
+    const ElementwiseProgram& p;
+    Mat& dst;
+    int len, chunk;
+    ElementwiseProgramFunc func;
+};
+
+void ElementwiseProgram::run(Mat& dst) const
+{
+    CV_INSTRUMENT_REGION();
+
+    bool continuous = dst.isContinuous();
+    for( size_t i = 0; i < inputs.size(); i++ )
+        continuous = continuous && inputs[i].isContinuous();
+    const int cn = dst.channels();
+    int rows = dst.rows, len = dst.cols*cn;
+    if( continuous )
+    {
+        len = (int)(dst.total()*cn);
+        rows = 1;
+    }
+    // rows are split into chunks for parallel processing of large continuous matrices
+    const int chunk = ELEMWISE_BLOCK_SIZE*64;
+    const int nchunks = (len + chunk - 1) / chunk;
+    ElementwiseProgramInvoker invoker(*this, dst, len, chunk);
+    parallel_for_(Range(0, rows*nchunks), invoker, (double)rows*len/(1 << 16));
+}
+
+// MatExpr has no room for expression graph, so the graph object is attached to MatExpr::a
+// with reference counting of Mat: the allocator below destroys it together with the last Mat header.
+class ElementwiseProgramHolder CV_FINAL : public MatAllocator
+{
+public:
+    UMatData* allocate(int, const int*, int, void*, size_t*, AccessFlag, UMatUsageFlags) const CV_OVERRIDE
+    {
+        CV_Error(Error::StsNotImplemented, "");
+    }
+
+    bool allocate(UMatData*, AccessFlag, UMatUsageFlags) const CV_OVERRIDE
+    {
+        return false;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if( !u )
+            return;
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        delete (ElementwiseProgram*)u->userdata;
+        delete u;
+    }
+
+    static Mat wrap(ElementwiseProgram* p)
+    {
+        UMatData* u = new UMatData(getInstance());
+        u->data = u->origdata = (uchar*)p;
+        u->size = sizeof(*p);
+        u->userdata = p;
+        u->refcount = 1;
+        Mat m(1, (int)sizeof(*p), CV_8U, (void*)p);
+        m.u = u;
+        return m;
+    }
+
+    static MatAllocator* getInstance()
+    {
+        CV_SINGLETON_LAZY_INIT(MatAllocator, new ElementwiseProgramHolder())
+    }
+};
+
+const ElementwiseProgram& MatOp_Elementwise::program(const MatExpr& e)
+{
+    CV_DbgAssert(e.a.u && e.a.u->currAllocator == ElementwiseProgramHolder::getInstance());
+    return *(const ElementwiseProgram*)e.a.u->userdata;
+}
+
+void MatOp_Elementwise::makeExpr(MatExpr& res, const ElementwiseProgram& p)
+{
+    res = MatExpr(&g_MatOp_Elementwise, 0, ElementwiseProgramHolder::wrap(new ElementwiseProgram(p)), Mat(), Mat(), 1, 0);
+}
+
+bool MatOp_Elementwise::fuse(char op, const MatExpr& e1, const MatExpr& e2, double scale, MatExpr& res)
+{
+    // skip expressions which are handled by regular MatOp code without temporary matrices
+    bool simple1, simple2;
+    if( op == '+' || op == '-' )
+    {
+        simple1 = isIdentity(e1) || (isAddEx(e1) && (!e1.b.data || e1.beta == 0));
+        simple2 = isIdentity(e2) || (isAddEx(e2) && (!e2.b.data || e2.beta == 0));
+    }
+    else
+    {
+        simple1 = isIdentity(e1) || isScaled(e1) || isReciprocal(e1);
+        simple2 = isIdentity(e2) || isScaled(e2) || isReciprocal(e2);
+    }
+    if( simple1 && simple2 )
+        return false;
+
+    ElementwiseProgram p;
+    int r1 = p.append(e1);
+    if( r1 < 0 )
+        return false;
+    int r2 = p.append(e2);
+    if( r2 < 0 )
+        return false;
+    if( op == '+' )
+        p.addOp(ELEMWISE_ADDW, r1, r2, 1, 1);
+    else if( op == '-' )
+        p.addOp(ELEMWISE_ADDW, r1, r2, 1, -1);
+    else if( op == '*' )
+        p.addOp(ELEMWISE_MUL, r1, r2, scale);
+    else if( op == '/' )
+        p.addOp(ELEMWISE_DIV, r1, r2, scale);
+    else
+        return false;
+    if( !p.isValid() )
+        return false;
+    makeExpr(res, p);
+    return true;
+}
+
+bool MatOp_Elementwise::fuse(char op, const MatExpr& e, const Scalar& s, MatExpr& res)
+{
+    if( isIdentity(e) )
+        return false;
+
+    ElementwiseProgram p;
+    int r = p.append(e);
+    if( r < 0 )
+        return false;
+    if( op == '+' )
+        p.addOp(ELEMWISE_ADDW, r, p.addConst(s), 1, 1);
+    else if( op == '-' )
+        p.addOp(ELEMWISE_ADDW, p.addConst(s), r, 1, -1);
+    else if( op == '*' )
+        p.addOp(ELEMWISE_ADDW, r, -1, s[0]);
+    else if( op == '/' )
+        p.addOp(ELEMWISE_RECIP, r, -1, s[0]);
+    else if( op == 'a' )
+        p.addOp(ELEMWISE_ABSDIFF, r, p.addConst(Scalar()));
+    else
+        return false;
+    if( !p.isValid() )
+        return false;
+    makeExpr(res, p);
+    return true;
+}
+
+void MatOp_Elementwise::assign(const MatExpr& e, Mat& m, int _type) const
+{
+    const ElementwiseProgram& p = program(e);
+    int type = p.inputs[0].type();
+    Mat temp, &dst = _type == -1 || _type == type ? m : temp;
+
+    dst.create(p.inputs[0].dims, p.inputs[0].size.p, type);
+    p.run(dst);
+
+    if( dst.data != m.data )
+        dst.convertTo(m, _type);
+}
+
+void MatOp_Elementwise::roi(const MatExpr& e, const Range& rowRange, const Range& colRange, MatExpr& res) const
+{
+    ElementwiseProgram p = program(e);
+    for( size_t i = 0; i < p.inputs.size(); i++ )
+        p.inputs[i] = p.inputs[i](rowRange, colRange);
+    makeExpr(res, p);
+}
+
+void MatOp_Elementwise::diag(const MatExpr& e, int d, MatExpr& res) const
+{
+    ElementwiseProgram p = program(e);
+    for( size_t i = 0; i < p.inputs.size(); i++ )
+        p.inputs[i] = p.inputs[i].diag(d);
+    makeExpr(res, p);
+}
+
+Size MatOp_Elementwise::size(const MatExpr& e) const
+{
+    return program(e).inputs[0].size();
+}
+
+int MatOp_Elementwise::type(const MatExpr& e) const
+{
+    return program(e).inputs[0].type();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 MatExpr Mat::t() const
 {
     CV_INSTRUMENT_REGION();
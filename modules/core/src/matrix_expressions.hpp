@@ -0,0 +1,46 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#ifndef OPENCV_CORE_SRC_MATRIX_EXPRESSIONS_HPP
+#define OPENCV_CORE_SRC_MATRIX_EXPRESSIONS_HPP
+
+namespace cv {
+
+// Node of fused element-wise expression. Nodes are stored in topological order,
+// arguments refer to previous nodes. The last node is the result.
+enum ElementwiseOpCode
+{
+    ELEMWISE_INPUT = 0,   // src[arg0]
+    ELEMWISE_CONST,       // per-channel constant s[]
+    ELEMWISE_ADDW,        // arg0*alpha + arg1*beta (arg1 < 0: arg0*alpha)
+    ELEMWISE_MUL,         // arg0*arg1*alpha
+    ELEMWISE_DIV,         // arg0*alpha/arg1
+    ELEMWISE_RECIP,       // alpha/arg0
+    ELEMWISE_MIN,         // min(arg0, arg1)
+    ELEMWISE_MAX,         // max(arg0, arg1)
+    ELEMWISE_ABSDIFF,     // |arg0 - arg1|
+    ELEMWISE_CAST         // s[0] == 0: round arg0 to integer and saturate to [alpha, beta]; s[0] != 0: round arg0 to float
+};
+
+struct ElementwiseOp
+{
+    int code;
+    int arg0, arg1;
+    double alpha, beta;
+    double s[4];
+};
+
+// Intermediate results are kept in blocks of this size (elements).
+// Value is divisible by any supported number of channels (1..4), so block starts at channel 0.
+enum { ELEMWISE_BLOCK_SIZE = 240 };
+
+typedef void (*ElementwiseProgramFunc)(const ElementwiseOp* ops, int nops, const uchar* const* src,
+                                       uchar* dst, int len, int cn, uchar* buf);
+
+// returns evaluator of element-wise program for CV_32F / CV_64F data (see matrix_expressions.simd.hpp)
+ElementwiseProgramFunc getElementwiseProgramFunc(int depth);
+
+} // namespace
+
+#endif // OPENCV_CORE_SRC_MATRIX_EXPRESSIONS_HPP
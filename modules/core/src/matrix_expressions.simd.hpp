@@ -0,0 +1,405 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "precomp.hpp"
+#include "matrix_expressions.hpp"
+
+namespace cv {
+
+CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
+
+ElementwiseProgramFunc getElementwiseProgramFunc(int depth);
+
+#ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+template<typename T> struct ElemwiseOpAddW
+{
+    T alpha, beta;
+    ElemwiseOpAddW(double alpha_, double beta_) : alpha((T)alpha_), beta((T)beta_) {}
+    inline T operator()(T a, T b) const { return a*alpha + b*beta; }
+};
+
+template<typename T> struct ElemwiseOpScale
+{
+    T alpha;
+    ElemwiseOpScale(double alpha_) : alpha((T)alpha_) {}
+    inline T operator()(T a) const { return a*alpha; }
+};
+
+template<typename T> struct ElemwiseOpMul
+{
+    T alpha;
+    ElemwiseOpMul(double alpha_) : alpha((T)alpha_) {}
+    inline T operator()(T a, T b) const { return a*b*alpha; }
+};
+
+template<typename T> struct ElemwiseOpDiv
+{
+    T alpha;
+    ElemwiseOpDiv(double alpha_) : alpha((T)alpha_) {}
+    inline T operator()(T a, T b) const { return a*alpha/b; }
+};
+
+template<typename T> struct ElemwiseOpRecip
+{
+    T alpha;
+    ElemwiseOpRecip(double alpha_) : alpha((T)alpha_) {}
+    inline T operator()(T a) const { return alpha/a; }
+};
+
+template<typename T> struct ElemwiseOpMin
+{
+    inline T operator()(T a, T b) const { return std::min(a, b); }
+};
+
+template<typename T> struct ElemwiseOpMax
+{
+    inline T operator()(T a, T b) const { return std::max(a, b); }
+};
+
+template<typename T> struct ElemwiseOpAbsDiff
+{
+    inline T operator()(T a, T b) const { return std::abs(a - b); }
+};
+
+template<typename T> struct ElemwiseOpCastInt
+{
+    T lo, hi;
+    ElemwiseOpCastInt(double lo_, double hi_) : lo((T)lo_), hi((T)hi_) {}
+    inline T operator()(T a) const { return (T)cvRound(std::min(std::max(a, lo), hi)); }
+};
+
+template<typename T> struct ElemwiseOpCastFloat
+{
+    inline T operator()(T a) const { return (T)(float)a; }
+};
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+template<typename T> struct ElemwiseVec;
+
+template<> struct ElemwiseVec<float>
+{
+    typedef v_float32 vec;
+    static inline int vlanes() { return VTraits<v_float32>::vlanes(); }
+    static inline v_float32 load(const float* p) { return vx_load(p); }
+    static inline v_float32 setall(float v) { return vx_setall_f32(v); }
+};
+
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+template<> struct ElemwiseVec<double>
+{
+    typedef v_float64 vec;
+    static inline int vlanes() { return VTraits<v_float64>::vlanes(); }
+    static inline v_float64 load(const double* p) { return vx_load(p); }
+    static inline v_float64 setall(double v) { return vx_setall_f64(v); }
+};
+#endif
+
+// Vector loops. Coefficients are broadcasted inside the loop body (sizeless vector types can't be kept in structures)
+#define CV_ELEMWISE_BINARY_LOOP(T, vexpr) \
+    { \
+        typedef ElemwiseVec<T> V; \
+        const int VL = V::vlanes(); \
+        for( ; i <= n - VL; i += VL ) \
+        { \
+            typename V::vec va = V::load(a + i), vb = V::load(b + i); \
+            v_store(dst + i, vexpr); \
+        } \
+    }
+
+#define CV_ELEMWISE_UNARY_LOOP(T, vexpr) \
+    { \
+        typedef ElemwiseVec<T> V; \
+        const int VL = V::vlanes(); \
+        for( ; i <= n - VL; i += VL ) \
+        { \
+            typename V::vec va = V::load(a + i); \
+            v_store(dst + i, vexpr); \
+        } \
+    }
+
+template<typename T> static inline int
+vecAddW(const T* a, const T* b, T* dst, int n, T alpha, T beta)
+{
+    int i = 0;
+    CV_ELEMWISE_BINARY_LOOP(T, v_add(v_mul(va, V::setall(alpha)), v_mul(vb, V::setall(beta))));
+    return i;
+}
+
+template<typename T> static inline int
+vecScale(const T* a, T* dst, int n, T alpha)
+{
+    int i = 0;
+    CV_ELEMWISE_UNARY_LOOP(T, v_mul(va, V::setall(alpha)));
+    return i;
+}
+
+template<typename T> static inline int
+vecMul(const T* a, const T* b, T* dst, int n, T alpha)
+{
+    int i = 0;
+    if( alpha == 1 )
+        CV_ELEMWISE_BINARY_LOOP(T, v_mul(va, vb))
+    else
+        CV_ELEMWISE_BINARY_LOOP(T, v_mul(v_mul(va, vb), V::setall(alpha)))
+    return i;
+}
+
+template<typename T> static inline int
+vecDiv(const T* a, const T* b, T* dst, int n, T alpha)
+{
+    int i = 0;
+    if( alpha == 1 )
+        CV_ELEMWISE_BINARY_LOOP(T, v_div(va, vb))
+    else
+        CV_ELEMWISE_BINARY_LOOP(T, v_div(v_mul(va, V::setall(alpha)), vb))
+    return i;
+}
+
+template<typename T> static inline int
+vecRecip(const T* a, T* dst, int n, T alpha)
+{
+    int i = 0;
+    CV_ELEMWISE_UNARY_LOOP(T, v_div(V::setall(alpha), va));
+    return i;
+}
+
+template<typename T> static inline int
+vecMin(const T* a, const T* b, T* dst, int n)
+{
+    int i = 0;
+    CV_ELEMWISE_BINARY_LOOP(T, v_min(va, vb));
+    return i;
+}
+
+template<typename T> static inline int
+vecMax(const T* a, const T* b, T* dst, int n)
+{
+    int i = 0;
+    CV_ELEMWISE_BINARY_LOOP(T, v_max(va, vb));
+    return i;
+}
+
+template<typename T> static inline int
+vecAbsDiff(const T* a, const T* b, T* dst, int n)
+{
+    int i = 0;
+    CV_ELEMWISE_BINARY_LOOP(T, v_absdiff(va, vb));
+    return i;
+}
+
+template<typename T> static inline int
+vecCastInt(const T* a, T* dst, int n, T lo, T hi)
+{
+    int i = 0;
+    CV_ELEMWISE_UNARY_LOOP(T, v_cvt_f32(v_round(v_min(v_max(va, V::setall(lo)), V::setall(hi)))));
+    return i;
+}
+
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+template<> inline int
+vecCastInt(const double* a, double* dst, int n, double lo, double hi)
+{
+    int i = 0;
+    CV_ELEMWISE_UNARY_LOOP(double, v_cvt_f64(v_round(v_min(v_max(va, V::setall(lo)), V::setall(hi)))));
+    return i;
+}
+#endif
+
+#undef CV_ELEMWISE_BINARY_LOOP
+#undef CV_ELEMWISE_UNARY_LOOP
+#endif // CV_SIMD || CV_SIMD_SCALABLE
+
+template<typename T> struct ElemwiseKernel
+{
+    static inline int addW(const T*, const T*, T*, int, T, T) { return 0; }
+    static inline int scale(const T*, T*, int, T) { return 0; }
+    static inline int mul(const T*, const T*, T*, int, T) { return 0; }
+    static inline int div(const T*, const T*, T*, int, T) { return 0; }
+    static inline int recip(const T*, T*, int, T) { return 0; }
+    static inline int min(const T*, const T*, T*, int) { return 0; }
+    static inline int max(const T*, const T*, T*, int) { return 0; }
+    static inline int absdiff(const T*, const T*, T*, int) { return 0; }
+    static inline int castInt(const T*, T*, int, T, T) { return 0; }
+};
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+template<> struct ElemwiseKernel<float>
+{
+    typedef float T;
+    static inline int addW(const T* a, const T* b, T* d, int n, T alpha, T beta) { return vecAddW(a, b, d, n, alpha, beta); }
+    static inline int scale(const T* a, T* d, int n, T alpha) { return vecScale(a, d, n, alpha); }
+    static inline int mul(const T* a, const T* b, T* d, int n, T alpha) { return vecMul(a, b, d, n, alpha); }
+    static inline int div(const T* a, const T* b, T* d, int n, T alpha) { return vecDiv(a, b, d, n, alpha); }
+    static inline int recip(const T* a, T* d, int n, T alpha) { return vecRecip(a, d, n, alpha); }
+    static inline int min(const T* a, const T* b, T* d, int n) { return vecMin(a, b, d, n); }
+    static inline int max(const T* a, const T* b, T* d, int n) { return vecMax(a, b, d, n); }
+    static inline int absdiff(const T* a, const T* b, T* d, int n) { return vecAbsDiff(a, b, d, n); }
+    static inline int castInt(const T* a, T* d, int n, T lo, T hi) { return vecCastInt(a, d, n, lo, hi); }
+};
+
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+template<> struct ElemwiseKernel<double>
+{
+    typedef double T;
+    static inline int addW(const T* a, const T* b, T* d, int n, T alpha, T beta) { return vecAddW(a, b, d, n, alpha, beta); }
+    static inline int scale(const T* a, T* d, int n, T alpha) { return vecScale(a, d, n, alpha); }
+    static inline int mul(const T* a, const T* b, T* d, int n, T alpha) { return vecMul(a, b, d, n, alpha); }
+    static inline int div(const T* a, const T* b, T* d, int n, T alpha) { return vecDiv(a, b, d, n, alpha); }
+    static inline int recip(const T* a, T* d, int n, T alpha) { return vecRecip(a, d, n, alpha); }
+    static inline int min(const T* a, const T* b, T* d, int n) { return vecMin(a, b, d, n); }
+    static inline int max(const T* a, const T* b, T* d, int n) { return vecMax(a, b, d, n); }
+    static inline int absdiff(const T* a, const T* b, T* d, int n) { return vecAbsDiff(a, b, d, n); }
+    static inline int castInt(const T* a, T* d, int n, T lo, T hi) { return vecCastInt(a, d, n, lo, hi); }
+};
+#endif
+#endif // CV_SIMD || CV_SIMD_SCALABLE
+
+template<typename T, class Op> static inline void
+elemwiseTail(const T* a, const T* b, T* dst, int i, int n, const Op& op)
+{
+    for( ; i < n; i++ )
+        dst[i] = op(a[i], b[i]);
+}
+
+template<typename T, class Op> static inline void
+elemwiseTail(const T* a, T* dst, int i, int n, const Op& op)
+{
+    for( ; i < n; i++ )
+        dst[i] = op(a[i]);
+}
+
+/*
+ Evaluates the program block by block: every node produces ELEMWISE_BLOCK_SIZE elements, so all
+ intermediate results of one block stay in L1 cache and every input/output element is touched once.
+ The last node is written to dst directly.
+*/
+template<typename T> static void
+runElementwiseProgram_(const ElementwiseOp* ops, int nops, const uchar* const* src_,
+                       uchar* dst_, int len, int cn, uchar* buf_)
+{
+    typedef ElemwiseKernel<T> K;
+    const int BLOCK = ELEMWISE_BLOCK_SIZE;
+    const T* const* src = (const T* const*)src_;
+    T* dst = (T*)dst_;
+    T* buf = (T*)buf_;
+    AutoBuffer<const T*, 64> _ptrs(nops);
+    const T** ptrs = _ptrs.data();
+
+    // constants are expanded once, the channel pattern is the same for each block
+    for( int k = 0; k < nops; k++ )
+    {
+        if( ops[k].code == ELEMWISE_CONST )
+        {
+            T* c = buf + (size_t)k*BLOCK;
+            for( int j = 0; j < BLOCK; j++ )
+                c[j] = (T)ops[k].s[j % cn];
+        }
+    }
+
+    for( int j0 = 0; j0 < len; j0 += BLOCK )
+    {
+        const int n = std::min(BLOCK, len - j0);
+        for( int k = 0; k < nops; k++ )
+        {
+            const ElementwiseOp& op = ops[k];
+            T* out = k == nops - 1 ? dst + j0 : buf + (size_t)k*BLOCK;
+            const T* a = op.arg0 >= 0 && op.code != ELEMWISE_INPUT ? ptrs[op.arg0] : 0;
+            const T* b = op.arg1 >= 0 ? ptrs[op.arg1] : 0;
+            switch( op.code )
+            {
+            case ELEMWISE_INPUT:
+                a = src[op.arg0] + j0;
+                if( out == dst + j0 )
+                    memcpy(out, a, n*sizeof(T));
+                else
+                    out = (T*)a;
+                break;
+            case ELEMWISE_CONST:
+                if( out == dst + j0 )
+                    memcpy(out, buf + (size_t)k*BLOCK, n*sizeof(T));
+                break;
+            case ELEMWISE_ADDW:
+                if( b )
+                {
+                    ElemwiseOpAddW<T> f(op.alpha, op.beta);
+                    elemwiseTail(a, b, out, K::addW(a, b, out, n, f.alpha, f.beta), n, f);
+                }
+                else
+                {
+                    ElemwiseOpScale<T> f(op.alpha);
+                    elemwiseTail(a, out, K::scale(a, out, n, f.alpha), n, f);
+                }
+                break;
+            case ELEMWISE_MUL:
+                {
+                    ElemwiseOpMul<T> f(op.alpha);
+                    elemwiseTail(a, b, out, K::mul(a, b, out, n, f.alpha), n, f);
+                }
+                break;
+            case ELEMWISE_DIV:
+                {
+                    ElemwiseOpDiv<T> f(op.alpha);
+                    elemwiseTail(a, b, out, K::div(a, b, out, n, f.alpha), n, f);
+                }
+                break;
+            case ELEMWISE_RECIP:
+                {
+                    ElemwiseOpRecip<T> f(op.alpha);
+                    elemwiseTail(a, out, K::recip(a, out, n, f.alpha), n, f);
+                }
+                break;
+            case ELEMWISE_MIN:
+                elemwiseTail(a, b, out, K::min(a, b, out, n), n, ElemwiseOpMin<T>());
+                break;
+            case ELEMWISE_MAX:
+                elemwiseTail(a, b, out, K::max(a, b, out, n), n, ElemwiseOpMax<T>());
+                break;
+            case ELEMWISE_ABSDIFF:
+                elemwiseTail(a, b, out, K::absdiff(a, b, out, n), n, ElemwiseOpAbsDiff<T>());
+                break;
+            case ELEMWISE_CAST:
+                if( op.s[0] == 0 )
+                {
+                    ElemwiseOpCastInt<T> f(op.alpha, op.beta);
+                    elemwiseTail(a, out, K::castInt(a, out, n, f.lo, f.hi), n, f);
+                }
+                else
+                    elemwiseTail(a, out, 0, n, ElemwiseOpCastFloat<T>());
+                break;
+            default:
+                CV_Error(Error::StsInternal, "Unknown element-wise operation");
+            }
+            ptrs[k] = out;
+        }
+    }
+}
+
+static void runElementwiseProgram32f(const ElementwiseOp* ops, int nops, const uchar* const* src,
+                                     uchar* dst, int len, int cn, uchar* buf)
+{
+    CV_INSTRUMENT_REGION();
+    runElementwiseProgram_<float>(ops, nops, src, dst, len, cn, buf);
+}
+
+static void runElementwiseProgram64f(const ElementwiseOp* ops, int nops, const uchar* const* src,
+                                     uchar* dst, int len, int cn, uchar* buf)
+{
+    CV_INSTRUMENT_REGION();
+    runElementwiseProgram_<double>(ops, nops, src, dst, len, cn, buf);
+}
+
+ElementwiseProgramFunc getElementwiseProgramFunc(int depth)
+{
+    if( depth == CV_32F )
+        return runElementwiseProgram32f;
+    if( depth == CV_64F )
+        return runElementwiseProgram64f;
+    return 0;
+}
+
+#endif // CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
+
+CV_CPU_OPTIMIZATION_NAMESPACE_END
+} // namespace
@@ -14,8 +14,11 @@ namespace cv {
 
 ////////////////////////////////////// transpose /////////////////////////////////////////
 
+// Steps are signed: rotate() passes the last source (destination) row with negative step
+// to get 90 degrees clockwise (counterclockwise) rotation in a single pass.
+
 template<typename T> static void
-transpose_( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz )
+transpose_( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz )
 {
     int i=0, j, m = sz.width, n = sz.height;
 
@@ -70,32 +73,103 @@ transpose_( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz )
     }
 }
 
-template<typename T> static void
-transposeI_( uchar* data, size_t step, int n )
+// size of square tiles (in elements) of blocked and in-place transposition
+static const int TRANSPOSE_TILE = 64;
+
+#if CV_SIMD128
+// Elements of 1, 2 and 4 bytes are transposed by N x N register blocks (N is number of lanes)
+// inside of TRANSPOSE_TILE x TRANSPOSE_TILE tiles, so source rows of a tile stay in L1 cache
+// while destination rows are written.
+
+template<typename T> static inline void
+transposeScalar_( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, int i0, int i1, int j0, int j1 )
+{
+    for( int i = i0; i < i1; i++ )
+    {
+        T* d = (T*)(dst + dstep*i);
+        const uchar* s = src + i*sizeof(T);
+        for( int j = j0; j < j1; j++ )
+            d[j] = *(const T*)(s + sstep*j);
+    }
+}
+
+// transposes N x N block in log2(N) interleaving passes
+template<typename V> static inline void
+transposeBlock_( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep )
 {
-    for( int i = 0; i < n; i++ )
+    typedef typename VTraits<V>::lane_type T;
+    const int N = VTraits<V>::nlanes;
+    V buf0[N], buf1[N];
+    V* r = buf0;
+    V* t = buf1;
+    for( int k = 0; k < N; k++ )
+        r[k] = v_load((const T*)(src + sstep*k));
+    for( int pass = 1; pass < N; pass *= 2 )
     {
-        T* row = (T*)(data + step*i);
-        uchar* data1 = data + i*sizeof(T);
-        for( int j = i+1; j < n; j++ )
-            std::swap( row[j], *(T*)(data1 + step*j) );
+        for( int k = 0; k < N/2; k++ )
+            v_zip(r[k], r[k + N/2], t[k*2], t[k*2 + 1]);
+        std::swap(r, t);
     }
+    for( int k = 0; k < N; k++ )
+        v_store((T*)(dst + dstep*k), r[k]);
 }
 
-typedef void (*TransposeFunc)( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz );
-typedef void (*TransposeInplaceFunc)( uchar* data, size_t step, int n );
+template<> inline void
+transposeBlock_<v_uint32x4>( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep )
+{
+    v_uint32x4 a0 = v_load((const unsigned*)src), a1 = v_load((const unsigned*)(src + sstep));
+    v_uint32x4 a2 = v_load((const unsigned*)(src + sstep*2)), a3 = v_load((const unsigned*)(src + sstep*3));
+    v_uint32x4 b0, b1, b2, b3;
+    v_transpose4x4(a0, a1, a2, a3, b0, b1, b2, b3);
+    v_store((unsigned*)dst, b0);
+    v_store((unsigned*)(dst + dstep), b1);
+    v_store((unsigned*)(dst + dstep*2), b2);
+    v_store((unsigned*)(dst + dstep*3), b3);
+}
+
+template<typename V> static void
+transposeSIMD_( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz )
+{
+    typedef typename VTraits<V>::lane_type T;
+    const int N = VTraits<V>::nlanes;
+    const int m = sz.width, n = sz.height;
+    for( int i0 = 0; i0 < m; i0 += TRANSPOSE_TILE )
+    {
+        int i1 = std::min(i0 + TRANSPOSE_TILE, m);
+        for( int j0 = 0; j0 < n; j0 += TRANSPOSE_TILE )
+        {
+            int j1 = std::min(j0 + TRANSPOSE_TILE, n), i = i0;
+            for( ; i <= i1 - N; i += N )
+            {
+                int j = j0;
+                for( ; j <= j1 - N; j += N )
+                    transposeBlock_<V>(src + sstep*j + i*sizeof(T), sstep, dst + dstep*i + j*sizeof(T), dstep);
+                transposeScalar_<T>(src, sstep, dst, dstep, i, i + N, j, j1);
+            }
+            transposeScalar_<T>(src, sstep, dst, dstep, i, i1, j0, j1);
+        }
+    }
+}
+#endif
+
+typedef void (*TransposeFunc)( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz );
+
+#if CV_SIMD128
+#define DEF_TRANSPOSE_FUNC_SIMD(suffix, type, vtype) \
+static void transpose_##suffix( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz ) \
+{ transposeSIMD_<vtype>(src, sstep, dst, dstep, sz); }
+#else
+#define DEF_TRANSPOSE_FUNC_SIMD(suffix, type, vtype) DEF_TRANSPOSE_FUNC(suffix, type)
+#endif
 
 #define DEF_TRANSPOSE_FUNC(suffix, type) \
-static void transpose_##suffix( const uchar* src, size_t sstep, uchar* dst, size_t dstep, Size sz ) \
-{ transpose_<type>(src, sstep, dst, dstep, sz); } \
-\
-static void transposeI_##suffix( uchar* data, size_t step, int n ) \
-{ transposeI_<type>(data, step, n); }
-
-DEF_TRANSPOSE_FUNC(8u, uchar)
-DEF_TRANSPOSE_FUNC(16u, ushort)
+static void transpose_##suffix( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz ) \
+{ transpose_<type>(src, sstep, dst, dstep, sz); }
+
+DEF_TRANSPOSE_FUNC_SIMD(8u, uchar, v_uint8x16)
+DEF_TRANSPOSE_FUNC_SIMD(16u, ushort, v_uint16x8)
 DEF_TRANSPOSE_FUNC(8uC3, Vec3b)
-DEF_TRANSPOSE_FUNC(32s, int)
+DEF_TRANSPOSE_FUNC_SIMD(32s, int, v_uint32x4)
 DEF_TRANSPOSE_FUNC(16uC3, Vec3s)
 DEF_TRANSPOSE_FUNC(32sC2, Vec2i)
 DEF_TRANSPOSE_FUNC(32sC3, Vec3i)
@@ -110,13 +184,93 @@ static TransposeFunc transposeTab[] =
     0, 0, 0, 0, 0, 0, 0, transpose_32sC6, 0, 0, 0, 0, 0, 0, 0, transpose_32sC8
 };
 
-static TransposeInplaceFunc transposeInplaceTab[] =
+// splits destination rows between threads
+class TransposeInvoker : public ParallelLoopBody
 {
-    0, transposeI_8u, transposeI_16u, transposeI_8uC3, transposeI_32s, 0, transposeI_16uC3, 0,
-    transposeI_32sC2, 0, 0, 0, transposeI_32sC3, 0, 0, 0, transposeI_32sC4,
-    0, 0, 0, 0, 0, 0, 0, transposeI_32sC6, 0, 0, 0, 0, 0, 0, 0, transposeI_32sC8
+public:
+    TransposeInvoker( TransposeFunc _func, const uchar* _src, ptrdiff_t _sstep, uchar* _dst, ptrdiff_t _dstep, Size _sz, int _esz )
+        : func(_func), src(_src), sstep(_sstep), dst(_dst), dstep(_dstep), sz(_sz), esz(_esz) {}
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        func(src + (size_t)range.start*esz, sstep, dst + dstep*range.start, dstep, Size(range.end - range.start, sz.height));
+    }
+
+private:
+    TransposeFunc func;
+    const uchar* src;
+    ptrdiff_t sstep;
+    uchar* dst;
+    ptrdiff_t dstep;
+    Size sz;
+    int esz;
 };
 
+// swaps pairs of tiles (I, J) and (J, I) through a temporary buffer, tile rows are processed in parallel
+class TransposeInplaceInvoker : public ParallelLoopBody
+{
+public:
+    TransposeInplaceInvoker( TransposeFunc _func, uchar* _data, size_t _step, int _n, int _esz )
+        : func(_func), data(_data), step(_step), n(_n), esz(_esz) {}
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        const size_t bufstep = (size_t)TRANSPOSE_TILE*esz;
+        AutoBuffer<uchar> _buf(bufstep*TRANSPOSE_TILE);
+        uchar* buf = _buf.data();
+        for( int ti = range.start; ti < range.end; ti++ )
+        {
+            int i0 = ti*TRANSPOSE_TILE, h = std::min(TRANSPOSE_TILE, n - i0);
+            for( int j0 = i0; j0 < n; j0 += TRANSPOSE_TILE )
+            {
+                int w = std::min(TRANSPOSE_TILE, n - j0);
+                uchar* a = data + step*i0 + (size_t)j0*esz; // tile (I, J), h x w
+                uchar* b = data + step*j0 + (size_t)i0*esz; // tile (J, I), w x h
+                func(a, step, buf, bufstep, Size(w, h));
+                if( a != b )
+                    func(b, step, a, step, Size(h, w));
+                for( int k = 0; k < w; k++ )
+                    memcpy(b + step*k, buf + bufstep*k, (size_t)h*esz);
+            }
+        }
+    }
+
+private:
+    TransposeFunc func;
+    uchar* data;
+    size_t step;
+    int n;
+    int esz;
+};
+
+static inline bool useParallelTranspose( Size sz, int esz )
+{
+    return (double)sz.area()*esz >= (double)(1 << 18) && getNumThreads() > 1;
+}
+
+static void transposeImpl( const uchar* src, ptrdiff_t sstep, uchar* dst, ptrdiff_t dstep, Size sz, int esz )
+{
+    TransposeFunc func = transposeTab[esz];
+    CV_Assert( func != 0 );
+    if( useParallelTranspose(sz, esz) )
+        parallel_for_(Range(0, sz.width), TransposeInvoker(func, src, sstep, dst, dstep, sz, esz),
+                      (double)sz.area()*esz/(1 << 16));
+    else
+        func(src, sstep, dst, dstep, sz);
+}
+
+static void transposeInplaceImpl( uchar* data, size_t step, int n, int esz )
+{
+    TransposeFunc func = transposeTab[esz];
+    CV_Assert( func != 0 );
+    TransposeInplaceInvoker invoker(func, data, step, n, esz);
+    Range range(0, divUp(n, TRANSPOSE_TILE));
+    if( useParallelTranspose(Size(n, n), esz) )
+        parallel_for_(range, invoker);
+    else
+        invoker(range);
+}
+
 #ifdef HAVE_OPENCL
 
 static bool ocl_transpose( InputArray _src, OutputArray _dst )
@@ -275,16 +429,12 @@ void transpose( InputArray _src, OutputArray _dst )
 
     if( dst.data == src.data )
     {
-        TransposeInplaceFunc func = transposeInplaceTab[esz];
-        CV_Assert( func != 0 );
         CV_Assert( dst.cols == dst.rows );
-        func( dst.ptr(), dst.step, dst.rows );
+        transposeInplaceImpl( dst.ptr(), dst.step, dst.rows, esz );
     }
     else
     {
-        TransposeFunc func = transposeTab[esz];
-        CV_Assert( func != 0 );
-        func( src.ptr(), src.step, dst.ptr(), dst.step, src.size() );
+        transposeImpl( src.ptr(), src.step, dst.ptr(), dst.step, src.size(), esz );
     }
 }
 
@@ -1144,6 +1294,18 @@ void rotate(InputArray _src, OutputArray _dst, int rotateMode)
     CALL_HAL(rotate90, cv_hal_rotate90, type, src.ptr(), src.step, src.cols, src.rows,
              dst.ptr(), dst.step, angle);
 
+    // 90 degrees rotations are done by single transposition pass with reversed source or destination rows order
+    int esz = (int)src.elemSize();
+    if ((angle == 90 || angle == 270) && dst.data != src.data &&
+        dst.rows == src.cols && dst.cols == src.rows && esz <= 32 && transposeTab[esz] != 0)
+    {
+        if (angle == 90)
+            transposeImpl(src.ptr(src.rows - 1), -(ptrdiff_t)src.step, dst.ptr(), dst.step, src.size(), esz);
+        else
+            transposeImpl(src.ptr(), src.step, dst.ptr(dst.rows - 1), -(ptrdiff_t)dst.step, src.size(), esz);
+        return;
+    }
+
     // use src (Mat) since _src (InputArray) is updated by _dst.create() when in-place
     rotateImpl(src, _dst, rotateMode);
 }
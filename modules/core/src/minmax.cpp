@@ -605,8 +605,15 @@ static void minMaxIdx_32s(const int* src, const uchar* mask, int* minval, int* m
 #endif
 }
 
-static void minMaxIdx_32f(const float* src, const uchar* mask, float* minval, float* maxval,
-                          size_t* minidx, size_t* maxidx, int len, size_t startidx )
+#if CV_SIMD128
+static inline v_float32x4 minMaxIdx_load_f32(const float* src) { return v_load(src); }
+static inline v_float32x4 minMaxIdx_load_f32(const hfloat* src) { return v_load_expand(src); }
+#endif
+
+// shared by 32f and 16f; the latter is widened to 32f on load
+template<typename T> static void
+minMaxIdx_f32_( const T* src, const uchar* mask, float* minval, float* maxval,
+                size_t* minidx, size_t* maxidx, int len, size_t startidx )
 {
 #if CV_SIMD128
     if ( len >= 2 * VTraits<v_float32x4>::vlanes() )
@@ -636,7 +643,7 @@ static void minMaxIdx_32f(const float* src, const uchar* mask, float* minval, fl
                 {
                     for( ; k < std::min(len0, j + 32766 * 2 * VTraits<v_float32x4>::vlanes()); k += 2 * VTraits<v_float32x4>::vlanes() )
                     {
-                        v_float32x4 data = v_load(src + k);
+                        v_float32x4 data = minMaxIdx_load_f32(src + k);
                         v_uint32x4 cmpMin = v_reinterpret_as_u32(v_lt(data, valMin));
                         v_uint32x4 cmpMax = v_reinterpret_as_u32(v_gt(data, valMax));
                         idxMin = v_select(cmpMin, idx, idxMin);
@@ -644,7 +651,7 @@ static void minMaxIdx_32f(const float* src, const uchar* mask, float* minval, fl
                         valMin = v_min(data, valMin);
                         valMax = v_max(data, valMax);
                         idx = v_add(idx, inc);
-                        data = v_load(src + k + VTraits<v_float32x4>::vlanes());
+                        data = minMaxIdx_load_f32(src + k + VTraits<v_float32x4>::vlanes());
                         cmpMin = v_reinterpret_as_u32(v_lt(data, valMin));
                         cmpMax = v_reinterpret_as_u32(v_gt(data, valMax));
                         idxMin = v_select(cmpMin, idx, idxMin);
@@ -658,7 +665,7 @@ static void minMaxIdx_32f(const float* src, const uchar* mask, float* minval, fl
                 {
                     for( ; k < std::min(len0, j + 32766 * 2 * VTraits<v_float32x4>::vlanes()); k += 2 * VTraits<v_float32x4>::vlanes() )
                     {
-                        v_float32x4 data = v_load(src + k);
+                        v_float32x4 data = minMaxIdx_load_f32(src + k);
                         v_uint16x8 maskVal = v_ne(v_load_expand(mask + k), v_setzero_u16());
                         v_int32x4 maskVal1, maskVal2;
                         v_expand(v_reinterpret_as_s16(maskVal), maskVal1, maskVal2);
@@ -669,7 +676,7 @@ static void minMaxIdx_32f(const float* src, const uchar* mask, float* minval, fl
                         valMin = v_select(v_reinterpret_as_f32(cmpMin), data, valMin);
                         valMax = v_select(v_reinterpret_as_f32(cmpMax), data, valMax);
                         idx = v_add(idx, inc);
-                        data = v_load(src + k + VTraits<v_float32x4>::vlanes());
+                        data = minMaxIdx_load_f32(src + k + VTraits<v_float32x4>::vlanes());
                         cmpMin = v_reinterpret_as_u32(v_and(v_reinterpret_as_s32(v_lt(data, valMin)), maskVal2));
                         cmpMax = v_reinterpret_as_u32(v_and(v_reinterpret_as_s32(v_gt(data, valMax)), maskVal2));
                         idxMin = v_select(cmpMin, idx, idxMin);
@@ -700,6 +707,18 @@ static void minMaxIdx_32f(const float* src, const uchar* mask, float* minval, fl
 #endif
 }
 
+static void minMaxIdx_32f(const float* src, const uchar* mask, float* minval, float* maxval,
+                          size_t* minidx, size_t* maxidx, int len, size_t startidx )
+{
+    minMaxIdx_f32_(src, mask, minval, maxval, minidx, maxidx, len, startidx);
+}
+
+static void minMaxIdx_16f(const hfloat* src, const uchar* mask, float* minval, float* maxval,
+                          size_t* minidx, size_t* maxidx, int len, size_t startidx )
+{
+    minMaxIdx_f32_(src, mask, minval, maxval, minidx, maxidx, len, startidx);
+}
+
 static void minMaxIdx_64f(const double* src, const uchar* mask, double* minval, double* maxval,
                           size_t* minidx, size_t* maxidx, int len, size_t startidx )
 {
@@ -840,7 +859,7 @@ static MinMaxIdxFunc getMinmaxTab(int depth)
         (MinMaxIdxFunc)GET_OPTIMIZED(minMaxIdx_16u), (MinMaxIdxFunc)GET_OPTIMIZED(minMaxIdx_16s),
         (MinMaxIdxFunc)GET_OPTIMIZED(minMaxIdx_32s),
         (MinMaxIdxFunc)GET_OPTIMIZED(minMaxIdx_32f), (MinMaxIdxFunc)GET_OPTIMIZED(minMaxIdx_64f),
-        0
+        (MinMaxIdxFunc)minMaxIdx_16f
     };
 
     return minmaxTab[depth];
@@ -1558,7 +1577,7 @@ void cv::minMaxIdx(InputArray _src, double* minVal,
     int *minval = &iminval, *maxval = &imaxval;
     int planeSize = (int)it.size*cn;
 
-    if( depth == CV_32F )
+    if( depth == CV_32F || depth == CV_16F )
         minval = (int*)&fminval, maxval = (int*)&fmaxval;
     else if( depth == CV_64F )
         minval = (int*)&dminval, maxval = (int*)&dmaxval;
@@ -1576,7 +1595,7 @@ void cv::minMaxIdx(InputArray _src, double* minVal,
 
     if( minidx == 0 )
         dminval = dmaxval = 0;
-    else if( depth == CV_32F )
+    else if( depth == CV_32F || depth == CV_16F )
         dminval = fminval, dmaxval = fmaxval;
     else if( depth <= CV_32S )
         dminval = iminval, dmaxval = imaxval;
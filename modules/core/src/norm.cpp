@@ -367,6 +367,95 @@ CV_DEF_NORM_ALL(32s, int, int, double, double)
 CV_DEF_NORM_ALL(32f, float, float, double, double)
 CV_DEF_NORM_ALL(64f, double, double, double, double)
 
+// Half-precision inputs are widened to 32f lanes on load, so no 32f copy of the data is made.
+// 32f partial sums are flushed into the (double) result every NORM16F_BLOCK_SIZE elements.
+enum { NORM16F_BLOCK_SIZE = 1024 };
+
+struct Norm16fInf
+{
+    typedef float ST;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    static inline v_float32 vop(const v_float32& s, const v_float32& v) { return v_max(s, v_abs(v)); }
+    static inline float vreduce(const v_float32& s) { return v_reduce_max(s); }
+#endif
+    static inline ST op(ST s, float v) { return std::max(s, std::abs(v)); }
+    static inline ST combine(ST s, float partial) { return std::max(s, partial); }
+};
+
+struct Norm16fL1
+{
+    typedef double ST;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    static inline v_float32 vop(const v_float32& s, const v_float32& v) { return v_add(s, v_abs(v)); }
+    static inline float vreduce(const v_float32& s) { return v_reduce_sum(s); }
+#endif
+    static inline ST op(ST s, float v) { return s + std::abs(v); }
+    static inline ST combine(ST s, float partial) { return s + partial; }
+};
+
+struct Norm16fL2
+{
+    typedef double ST;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    static inline v_float32 vop(const v_float32& s, const v_float32& v) { return v_muladd(v, v, s); }
+    static inline float vreduce(const v_float32& s) { return v_reduce_sum(s); }
+#endif
+    static inline ST op(ST s, float v) { return s + (double)v*v; }
+    static inline ST combine(ST s, float partial) { return s + partial; }
+};
+
+template<typename Op, bool diff> static int
+norm16f_(const hfloat* src1, const hfloat* src2, const uchar* mask, typename Op::ST* _result, int len, int cn)
+{
+    typename Op::ST result = *_result;
+    if( !mask )
+    {
+        int n = len*cn, j = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+        const int vlanes = VTraits<v_float32>::vlanes();
+        while( j <= n - vlanes )
+        {
+            int blockEnd = std::min(n, j + (int)NORM16F_BLOCK_SIZE);
+            v_float32 s = vx_setzero_f32();
+            for( ; j <= blockEnd - vlanes; j += vlanes )
+            {
+                v_float32 v = vx_load_expand(src1 + j);
+                if( diff )
+                    v = v_sub(v, vx_load_expand(src2 + j));
+                s = Op::vop(s, v);
+            }
+            result = Op::combine(result, Op::vreduce(s));
+        }
+#endif
+        for( ; j < n; j++ )
+            result = Op::op(result, diff ? (float)src1[j] - (float)src2[j] : (float)src1[j]);
+    }
+    else
+    {
+        for( int i = 0; i < len; i++, src1 += cn, src2 += diff ? cn : 0 )
+            if( mask[i] )
+            {
+                for( int k = 0; k < cn; k++ )
+                    result = Op::op(result, diff ? (float)src1[k] - (float)src2[k] : (float)src1[k]);
+            }
+    }
+    *_result = result;
+    return 0;
+}
+
+static int normInf_16f(const hfloat* src, const uchar* mask, float* r, int len, int cn)
+{ return norm16f_<Norm16fInf, false>(src, 0, mask, r, len, cn); }
+static int normL1_16f(const hfloat* src, const uchar* mask, double* r, int len, int cn)
+{ return norm16f_<Norm16fL1, false>(src, 0, mask, r, len, cn); }
+static int normL2_16f(const hfloat* src, const uchar* mask, double* r, int len, int cn)
+{ return norm16f_<Norm16fL2, false>(src, 0, mask, r, len, cn); }
+static int normDiffInf_16f(const hfloat* src1, const hfloat* src2, const uchar* mask, float* r, int len, int cn)
+{ return norm16f_<Norm16fInf, true>(src1, src2, mask, r, len, cn); }
+static int normDiffL1_16f(const hfloat* src1, const hfloat* src2, const uchar* mask, double* r, int len, int cn)
+{ return norm16f_<Norm16fL1, true>(src1, src2, mask, r, len, cn); }
+static int normDiffL2_16f(const hfloat* src1, const hfloat* src2, const uchar* mask, double* r, int len, int cn)
+{ return norm16f_<Norm16fL2, true>(src1, src2, mask, r, len, cn); }
+
 
 typedef int (*NormFunc)(const uchar*, const uchar*, uchar*, int, int);
 typedef int (*NormDiffFunc)(const uchar*, const uchar*, const uchar*, uchar*, int, int);
@@ -377,15 +466,15 @@ static NormFunc getNormFunc(int normType, int depth)
     {
         {
             (NormFunc)GET_OPTIMIZED(normInf_8u), (NormFunc)GET_OPTIMIZED(normInf_8s), (NormFunc)GET_OPTIMIZED(normInf_16u), (NormFunc)GET_OPTIMIZED(normInf_16s),
-            (NormFunc)GET_OPTIMIZED(normInf_32s), (NormFunc)GET_OPTIMIZED(normInf_32f), (NormFunc)normInf_64f, 0
+            (NormFunc)GET_OPTIMIZED(normInf_32s), (NormFunc)GET_OPTIMIZED(normInf_32f), (NormFunc)normInf_64f, (NormFunc)normInf_16f
         },
         {
             (NormFunc)GET_OPTIMIZED(normL1_8u), (NormFunc)GET_OPTIMIZED(normL1_8s), (NormFunc)GET_OPTIMIZED(normL1_16u), (NormFunc)GET_OPTIMIZED(normL1_16s),
-            (NormFunc)GET_OPTIMIZED(normL1_32s), (NormFunc)GET_OPTIMIZED(normL1_32f), (NormFunc)normL1_64f, 0
+            (NormFunc)GET_OPTIMIZED(normL1_32s), (NormFunc)GET_OPTIMIZED(normL1_32f), (NormFunc)normL1_64f, (NormFunc)normL1_16f
         },
         {
             (NormFunc)GET_OPTIMIZED(normL2_8u), (NormFunc)GET_OPTIMIZED(normL2_8s), (NormFunc)GET_OPTIMIZED(normL2_16u), (NormFunc)GET_OPTIMIZED(normL2_16s),
-            (NormFunc)GET_OPTIMIZED(normL2_32s), (NormFunc)GET_OPTIMIZED(normL2_32f), (NormFunc)normL2_64f, 0
+            (NormFunc)GET_OPTIMIZED(normL2_32s), (NormFunc)GET_OPTIMIZED(normL2_32f), (NormFunc)normL2_64f, (NormFunc)normL2_16f
         }
     };
 
@@ -400,19 +489,19 @@ static NormDiffFunc getNormDiffFunc(int normType, int depth)
             (NormDiffFunc)GET_OPTIMIZED(normDiffInf_8u), (NormDiffFunc)normDiffInf_8s,
             (NormDiffFunc)normDiffInf_16u, (NormDiffFunc)normDiffInf_16s,
             (NormDiffFunc)normDiffInf_32s, (NormDiffFunc)GET_OPTIMIZED(normDiffInf_32f),
-            (NormDiffFunc)normDiffInf_64f, 0
+            (NormDiffFunc)normDiffInf_64f, (NormDiffFunc)normDiffInf_16f
         },
         {
             (NormDiffFunc)GET_OPTIMIZED(normDiffL1_8u), (NormDiffFunc)normDiffL1_8s,
             (NormDiffFunc)normDiffL1_16u, (NormDiffFunc)normDiffL1_16s,
             (NormDiffFunc)normDiffL1_32s, (NormDiffFunc)GET_OPTIMIZED(normDiffL1_32f),
-            (NormDiffFunc)normDiffL1_64f, 0
+            (NormDiffFunc)normDiffL1_64f, (NormDiffFunc)normDiffL1_16f
         },
         {
             (NormDiffFunc)GET_OPTIMIZED(normDiffL2_8u), (NormDiffFunc)normDiffL2_8s,
             (NormDiffFunc)normDiffL2_16u, (NormDiffFunc)normDiffL2_16s,
             (NormDiffFunc)normDiffL2_32s, (NormDiffFunc)GET_OPTIMIZED(normDiffL2_32f),
-            (NormDiffFunc)normDiffL2_64f, 0
+            (NormDiffFunc)normDiffL2_64f, (NormDiffFunc)normDiffL2_16f
         }
     };
 
@@ -700,7 +789,7 @@ double norm( InputArray _src, int normType, InputArray _mask )
         return result;
     }
 
-    NormFunc func = getNormFunc(normType >> 1, depth == CV_16F ? CV_32F : depth);
+    NormFunc func = getNormFunc(normType >> 1, depth);
     CV_Assert( func != 0 );
 
     const Mat* arrays[] = {&src, &mask, 0};
@@ -746,26 +835,6 @@ double norm( InputArray _src, int normType, InputArray _mask )
             }
         }
     }
-    else if (depth == CV_16F)
-    {
-        const size_t esz = src.elemSize();
-        const int total = (int)it.size;
-        const int blockSize = std::min(total, divUp(1024, cn));
-        AutoBuffer<float, 1026/*divUp(1024,3)*3*/> fltbuf(blockSize * cn);
-        float* data0 = fltbuf.data();
-        for (size_t i = 0; i < it.nplanes; i++, ++it)
-        {
-            for (int j = 0; j < total; j += blockSize)
-            {
-                int bsz = std::min(total - j, blockSize);
-                hal::cvt16f32f((const hfloat*)ptrs[0], data0, bsz * cn);
-                func((uchar*)data0, ptrs[1], (uchar*)&result.f, bsz, cn);
-                ptrs[0] += bsz*esz;
-                if (ptrs[1])
-                    ptrs[1] += bsz;
-            }
-        }
-    }
     else
     {
         // generic implementation
@@ -1167,7 +1236,7 @@ double norm( InputArray _src1, InputArray _src2, int normType, InputArray _mask
         return result;
     }
 
-    NormDiffFunc func = getNormDiffFunc(normType >> 1, depth == CV_16F ? CV_32F : depth);
+    NormDiffFunc func = getNormDiffFunc(normType >> 1, depth);
     CV_Assert( func != 0 );
 
     const Mat* arrays[] = {&src1, &src2, &mask, 0};
@@ -1215,29 +1284,6 @@ double norm( InputArray _src1, InputArray _src2, int normType, InputArray _mask
             }
         }
     }
-    else if (depth == CV_16F)
-    {
-        const size_t esz = src1.elemSize();
-        const int total = (int)it.size;
-        const int blockSize = std::min(total, divUp(512, cn));
-        AutoBuffer<float, 1026/*divUp(512,3)*3*2*/> fltbuf(blockSize * cn * 2);
-        float* data0 = fltbuf.data();
-        float* data1 = fltbuf.data() + blockSize * cn;
-        for (size_t i = 0; i < it.nplanes; i++, ++it)
-        {
-            for (int j = 0; j < total; j += blockSize)
-            {
-                int bsz = std::min(total - j, blockSize);
-                hal::cvt16f32f((const hfloat*)ptrs[0], data0, bsz * cn);
-                hal::cvt16f32f((const hfloat*)ptrs[1], data1, bsz * cn);
-                func((uchar*)data0, (uchar*)data1, ptrs[2], (uchar*)&result.f, bsz, cn);
-                ptrs[0] += bsz*esz;
-                ptrs[1] += bsz*esz;
-                if (ptrs[2])
-                    ptrs[2] += bsz;
-            }
-        }
-    }
     else
     {
         // generic implementation
@@ -212,6 +212,7 @@ namespace {
 
             // propagate main thread state
             rng = cv::theRNG();
+            matAllocator = details::getThreadMatAllocator();
 #if OPENCV_SUPPORTS_FP_DENORMALS_HINT && OPENCV_IMPL_FP_HINTS
             details::saveFPDenormalsState(fp_denormals_base_state);
 #endif
@@ -262,6 +263,7 @@ namespace {
         int nstripes;
         cv::RNG rng;
         mutable bool is_rng_used;
+        MatAllocator* matAllocator;
 #ifdef OPENCV_TRACE
         CV_TRACE_NS::details::Region* traceRootRegion;
         CV_TRACE_NS::details::TraceManagerThreadLocal* traceRootContext;
@@ -338,6 +340,12 @@ namespace {
 
             // propagate main thread state
             cv::theRNG() = ctx.rng;
+            MatAllocator* prevMatAllocator = NULL;
+            if (ctx.matAllocator)
+            {
+                prevMatAllocator = details::getThreadMatAllocator();
+                details::setThreadMatAllocator(ctx.matAllocator);
+            }
 #if OPENCV_SUPPORTS_FP_DENORMALS_HINT && OPENCV_IMPL_FP_HINTS
             FPDenormalsIgnoreHintScope fp_denormals_scope(ctx.fp_denormals_base_state);
 #endif
@@ -355,6 +363,10 @@ namespace {
             CV_TRACE_ARG_VALUE(range_end, "range.end", (int64)r.end);
 #endif
 
+#ifdef OPENCV_TRACE
+            const int64 stripeBeginTimestamp = CV_TRACE_NS::details::TraceManager::isEventRecordingActivated() ? cv::getTimestampNS() : 0;
+#endif
+
             try
             {
                 (*ctx.body)(r);
@@ -379,6 +391,14 @@ namespace {
             }
 #endif
 
+#ifdef OPENCV_TRACE
+            if (stripeBeginTimestamp)
+                CV_TRACE_NS::details::traceParallelStripe(stripeBeginTimestamp, cv::getTimestampNS(), r.start, r.end);
+#endif
+
+            if (ctx.matAllocator)
+                details::setThreadMatAllocator(prevMatAllocator);
+
             if (!ctx.is_rng_used && !(cv::theRNG() == ctx.rng))
                 ctx.is_rng_used = true;
         }
@@ -517,6 +537,15 @@ void parallel_for_(const cv::Range& range, const cv::ParallelLoopBody& body, dou
     if (range.empty())
         return;
 
+    {
+        std::shared_ptr<ParallelForAPI>& api = getCurrentParallelForAPI();
+        if (api && isNestedParallelForSupported(*api))
+        {
+            parallel_for_impl(range, body, nstripes);
+            return;
+        }
+    }
+
     static std::atomic<bool> flagNestedParallelFor(false);
     bool isNotNestedRegion = !flagNestedParallelFor.load();
     if (isNotNestedRegion)
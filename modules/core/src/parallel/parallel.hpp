@@ -12,6 +12,11 @@ extern int numThreads;
 
 std::shared_ptr<ParallelForAPI>& getCurrentParallelForAPI();
 
+/** Returns true if backend is able to execute nested parallel_for_() calls in parallel
+ * (without over-subscription and deadlocks). Nested calls are serialized for other backends.
+ */
+bool isNestedParallelForSupported(const ParallelForAPI& api);
+
 #ifndef BUILD_PLUGIN
 
 #ifdef HAVE_TBB
@@ -22,6 +27,10 @@ std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendTBB();
 std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendOpenMP();
 #endif
 
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendWorkStealing();
+#endif
+
 #endif  // BUILD_PLUGIN
 
 }}  // namespace
@@ -0,0 +1,433 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "../precomp.hpp"
+#include "parallel.hpp"
+
+#include "../parallel_impl.hpp"  // defaultNumberOfThreads()
+
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/tls.hpp>
+#include <opencv2/core/utils/logger.defines.hpp>
+#include <opencv2/core/utils/logger.hpp>
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+//
+// Work-stealing scheduler for parallel_for_()
+//
+// - each worker thread owns a double-ended queue of tasks (stripe ranges)
+// - owner pushes/pops tasks on the back of its queue (LIFO, cache-friendly),
+//   idle threads steal from the front of other queues (oldest and largest ranges)
+// - ranges are split lazily in halves up to the single stripe (`nstripes` is the grain hint)
+// - threads which wait for completion of parallel_for() call execute pending tasks,
+//   so nested parallel_for() calls don't block workers and don't create extra threads
+// - threads which are not part of the pool (application threads) submit tasks through the shared queue
+//
+
+namespace cv { namespace parallel { namespace workstealing {
+
+static unsigned getSpinCount()
+{
+    static unsigned param_spinCount = (unsigned)utils::getConfigurationParameterSizeT("OPENCV_PARALLEL_WORKSTEALING_SPIN_COUNT", 2000);  // iterations
+    return param_spinCount;
+}
+
+class ParallelForBackend;
+
+struct Job
+{
+    Job(ParallelForAPI::FN_parallel_for_body_cb_t body_, void* data_, int tasks, const Job* parent_)
+        : body(body_), data(data_), parent(parent_), pending(tasks), hasException(false)
+    {}
+
+    /// true if this job is created by tasks of the `root` job (directly or by nested calls)
+    bool isDescendantOf(const Job* root) const
+    {
+        for (const Job* j = this; j; j = j->parent)
+        {
+            if (j == root)
+                return true;
+        }
+        return false;
+    }
+
+    ParallelForAPI::FN_parallel_for_body_cb_t body;
+    void* data;
+    const Job* parent;  // job of the task which has called nested parallel_for()
+    std::atomic<int> pending;  // stripes which are not processed yet
+
+    std::mutex exceptionMutex;
+    bool hasException;
+    std::exception_ptr exception;
+};
+
+struct Task
+{
+    Job* job;
+    int begin;
+    int end;
+
+    /// Waiting threads execute tasks of their own job and nested jobs only.
+    /// This bounds the stack depth by nesting level of user code.
+    inline bool isAllowed(const Job* root) const
+    {
+        return !root || job->isDescendantOf(root);
+    }
+};
+
+struct ThreadState
+{
+    ThreadState() : pool(NULL), index(0), job(NULL) {}
+
+    const ParallelForBackend* pool;
+    int index;
+    const Job* job;  // job of the currently executed task
+};
+
+static TLSData<ThreadState>& getThreadStateTLS()
+{
+    CV_SINGLETON_LAZY_INIT_REF(TLSData<ThreadState>, new TLSData<ThreadState>());
+}
+
+class TaskQueue
+{
+public:
+    TaskQueue() : size_(0) {}
+
+    void push(const Task& task)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(task);
+        size_.store((int)tasks_.size(), std::memory_order_relaxed);
+    }
+
+    /// owner's side: the most recent task (LIFO)
+    bool pop(Task& task, const Job* root)
+    {
+        if (size_.load(std::memory_order_relaxed) == 0)
+            return false;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tasks_.empty() || !tasks_.back().isAllowed(root))
+            return false;
+        task = tasks_.back();
+        tasks_.pop_back();
+        size_.store((int)tasks_.size(), std::memory_order_relaxed);
+        return true;
+    }
+
+    /// thief's side: the oldest allowed task (FIFO, largest ranges)
+    bool steal(Task& task, const Job* root)
+    {
+        if (size_.load(std::memory_order_relaxed) == 0)
+            return false;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (std::deque<Task>::iterator it = tasks_.begin(); it != tasks_.end(); ++it)
+        {
+            if (it->isAllowed(root))
+            {
+                task = *it;
+                tasks_.erase(it);
+                size_.store((int)tasks_.size(), std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+protected:
+    std::mutex mutex_;
+    std::deque<Task> tasks_;
+    std::atomic<int> size_;  // hint for thieves to skip empty queues without locking
+};
+
+/** Work-stealing parallel_for API implementation
+ *
+ * Thread with index 0 is the calling thread, worker threads use indexes [1; getNumThreads()).
+ * Queue with index 0 is shared between all threads which are not the pool's workers.
+ */
+class ParallelForBackend CV_FINAL : public ParallelForAPI
+{
+public:
+    ParallelForBackend()
+        : numThreads(0), started(false), stop(false), epoch(0), sleepers(0)
+    {
+        // nothing
+    }
+
+    ~ParallelForBackend() CV_OVERRIDE
+    {
+        stopWorkers();
+    }
+
+    void parallel_for(int tasks, FN_parallel_for_body_cb_t body_callback, void* callback_data) CV_OVERRIDE
+    {
+        if (tasks <= 0)
+            return;
+        startWorkers();
+        if (tasks == 1 || threads.empty())
+        {
+            body_callback(0, tasks, callback_data);
+            return;
+        }
+
+        ThreadState& state = getThreadStateTLS().getRef();
+        const int self = (state.pool == this) ? state.index : 0;
+
+        Job job(body_callback, callback_data, tasks, state.job);
+        Task root = { &job, 0, tasks };
+        execute(state, *queues[self], root, &job);
+
+        // help other threads until the job is done
+        while (job.pending.load(std::memory_order_acquire) > 0)
+        {
+            Task task;
+            if (findTask(self, task, &job))
+            {
+                execute(state, *queues[self], task, &job);
+                continue;
+            }
+            waitForWork(&job);
+        }
+
+        if (job.hasException)
+            std::rethrow_exception(job.exception);
+    }
+
+    int getThreadNum() const CV_OVERRIDE
+    {
+        const ThreadState& state = getThreadStateTLS().getRef();
+        return (state.pool == this) ? state.index : 0;
+    }
+
+    int getNumThreads() const CV_OVERRIDE
+    {
+        return numThreads > 0 ? numThreads : (int)defaultNumberOfThreads();
+    }
+
+    int setNumThreads(int nThreads) CV_OVERRIDE
+    {
+        int oldNumThreads = numThreads;
+        if (nThreads != numThreads)
+        {
+            stopWorkers();
+            numThreads = nThreads;
+            // workers are started lazily by the next parallel_for() call
+        }
+        return oldNumThreads;
+    }
+
+    const char* getName() const CV_OVERRIDE
+    {
+        return "workstealing";
+    }
+
+protected:
+    /// Splits tasks in halves until single stripe is left (upper halves are available for thieves),
+    /// then continues with own queue in LIFO order.
+    void execute(ThreadState& state, TaskQueue& queue, Task task, const Job* root)
+    {
+        do
+        {
+            while (task.end - task.begin > 1)
+            {
+                const int middle = task.begin + (task.end - task.begin) / 2;
+                Task upper = { task.job, middle, task.end };
+                queue.push(upper);
+                notifyWorkers();
+                task.end = middle;
+            }
+            run(state, task);
+        } while (queue.pop(task, root));
+    }
+
+    void run(ThreadState& state, const Task& task)
+    {
+        Job& job = *task.job;
+        const Job* prevJob = state.job;
+        state.job = &job;
+        try
+        {
+            job.body(task.begin, task.end, job.data);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(job.exceptionMutex);
+            if (!job.hasException)
+            {
+                job.hasException = true;
+                job.exception = std::current_exception();
+            }
+        }
+        state.job = prevJob;
+        const int n = task.end - task.begin;
+        if (job.pending.fetch_sub(n, std::memory_order_acq_rel) == n)
+        {
+            // wake up the thread which waits for this job
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            sleepCond.notify_all();
+        }
+    }
+
+    bool findTask(int self, Task& task, const Job* root)
+    {
+        const int N = (int)queues.size();
+        if (queues[self]->pop(task, root))
+            return true;
+        for (int i = 1; i < N; i++)
+        {
+            int victim = self + i;
+            if (victim >= N)
+                victim -= N;
+            if (queues[victim]->steal(task, root))
+                return true;
+        }
+        return queues[self]->steal(task, root);  // shared queue may have allowed tasks below the foreign ones
+    }
+
+    void notifyWorkers()
+    {
+        epoch.fetch_add(1, std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_seq_cst) > 0)
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            sleepCond.notify_all();
+        }
+    }
+
+    /// Spins for a while, then sleeps until new tasks are available (or the job is completed)
+    void waitForWork(const Job* job)
+    {
+        const unsigned seen = epoch.load(std::memory_order_seq_cst);
+        const unsigned spinCount = getSpinCount();
+        for (unsigned i = 0; i < spinCount; i++)
+        {
+            if (epoch.load(std::memory_order_relaxed) != seen)
+                return;
+            if (job && job->pending.load(std::memory_order_acquire) == 0)
+                return;
+            if (stop.load(std::memory_order_relaxed))
+                return;
+            std::this_thread::yield();
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        while (epoch.load(std::memory_order_seq_cst) == seen &&
+               !stop.load(std::memory_order_relaxed) &&
+               !(job && job->pending.load(std::memory_order_acquire) == 0))
+        {
+            sleepCond.wait(lock);
+        }
+        sleepers.fetch_sub(1, std::memory_order_seq_cst);
+    }
+
+    void workerLoop(int self)
+    {
+        ThreadState& state = getThreadStateTLS().getRef();
+        state.pool = this;
+        state.index = self;
+        state.job = NULL;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            Task task;
+            if (findTask(self, task, NULL))
+            {
+                execute(state, *queues[self], task, NULL);
+                continue;
+            }
+            waitForWork(NULL);
+        }
+        state.pool = NULL;
+        state.index = 0;
+    }
+
+    void startWorkers()
+    {
+        if (started.load(std::memory_order_acquire))
+            return;
+        std::lock_guard<std::mutex> lock(configMutex);
+        if (started.load(std::memory_order_relaxed))
+            return;
+        const int N = std::max(getNumThreads(), 1);
+        stop = false;
+        queues.clear();
+        for (int i = 0; i < N; i++)
+            queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue()));
+        threads.clear();
+        for (int i = 1; i < N; i++)
+            threads.push_back(std::thread(&ParallelForBackend::workerLoop, this, i));
+        CV_LOG_DEBUG(NULL, "core(parallel): work-stealing backend: started " << threads.size() << " worker threads");
+        started.store(true, std::memory_order_release);
+    }
+
+    void stopWorkers()
+    {
+        std::lock_guard<std::mutex> lock(configMutex);
+        if (!started.load(std::memory_order_relaxed))
+            return;
+        {
+            std::lock_guard<std::mutex> l(sleepMutex);
+            stop = true;
+            sleepCond.notify_all();
+        }
+        for (size_t i = 0; i < threads.size(); i++)
+            threads[i].join();
+        threads.clear();
+        queues.clear();
+        started.store(false, std::memory_order_release);
+    }
+
+    int numThreads;  // 0 - default
+
+    std::mutex configMutex;  // guards start/stop of workers
+    std::atomic<bool> started;
+    std::vector<std::thread> threads;
+    std::vector< std::unique_ptr<TaskQueue> > queues;
+
+    std::atomic<bool> stop;
+    std::mutex sleepMutex;
+    std::condition_variable sleepCond;
+    std::atomic<unsigned> epoch;  // incremented on each new task
+    std::atomic<int> sleepers;
+};
+
+}  // namespace workstealing
+
+static
+std::shared_ptr<workstealing::ParallelForBackend>& getWorkStealingInstance()
+{
+    static std::shared_ptr<workstealing::ParallelForBackend> g_instance = std::make_shared<workstealing::ParallelForBackend>();
+    return g_instance;
+}
+
+std::shared_ptr<cv::parallel::ParallelForAPI> createParallelBackendWorkStealing()
+{
+    return getWorkStealingInstance();
+}
+
+bool isNestedParallelForSupported(const ParallelForAPI& api)
+{
+    return dynamic_cast<const workstealing::ParallelForBackend*>(&api) != NULL;
+}
+
+}}  // namespace
+
+#else  // OPENCV_DISABLE_THREAD_SUPPORT
+
+namespace cv { namespace parallel {
+
+bool isNestedParallelForSupported(const ParallelForAPI& /*api*/)
+{
+    return false;
+}
+
+}}  // namespace
+
+#endif  // OPENCV_DISABLE_THREAD_SUPPORT
@@ -16,6 +16,8 @@ struct ParallelBackendInfo
                       // >10000 - prioritized list (OPENCV_PARALLEL_PRIORITY_LIST)
     std::string name;
     std::shared_ptr<IParallelBackendFactory> backendFactory;
+    bool explicitOnly;  // backend is not selected by default, only by name (OPENCV_PARALLEL_BACKEND / setParallelForBackend())
+                        // or through OPENCV_PARALLEL_PRIORITY_LIST
 };
 
 const std::vector<ParallelBackendInfo>& getParallelBackendsInfo();
@@ -13,7 +13,7 @@ namespace cv { namespace parallel {
 #if OPENCV_HAVE_FILESYSTEM_SUPPORT && defined(PARALLEL_ENABLE_PLUGINS)
 #define DECLARE_DYNAMIC_BACKEND(name) \
 ParallelBackendInfo { \
-    1000, name, createPluginParallelBackendFactory(name) \
+    1000, name, createPluginParallelBackendFactory(name), false \
 },
 #else
 #define DECLARE_DYNAMIC_BACKEND(name) /* nothing */
@@ -21,7 +21,12 @@ ParallelBackendInfo { \
 
 #define DECLARE_STATIC_BACKEND(name, createBackendAPI) \
 ParallelBackendInfo { \
-    1000, name, std::make_shared<cv::parallel::StaticBackendFactory>([=] () -> std::shared_ptr<cv::parallel::ParallelForAPI> { return createBackendAPI(); }) \
+    1000, name, std::make_shared<cv::parallel::StaticBackendFactory>([=] () -> std::shared_ptr<cv::parallel::ParallelForAPI> { return createBackendAPI(); }), false \
+},
+
+#define DECLARE_STATIC_BACKEND_EXPLICIT(name, createBackendAPI) \
+ParallelBackendInfo { \
+    1000, name, std::make_shared<cv::parallel::StaticBackendFactory>([=] () -> std::shared_ptr<cv::parallel::ParallelForAPI> { return createBackendAPI(); }), true \
 },
 
 static
@@ -41,6 +46,10 @@ std::vector<ParallelBackendInfo>& getBuiltinParallelBackendsInfo()
 #elif defined(PARALLEL_ENABLE_PLUGINS)
         DECLARE_DYNAMIC_BACKEND("OPENMP")  // TODO Intel OpenMP?
 #endif
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        DECLARE_STATIC_BACKEND_EXPLICIT("WORKSTEALING", createParallelBackendWorkStealing)
+#endif
     };
     return g_backends;
 }
@@ -127,6 +136,7 @@ protected:
                 if (name == info.name)
                 {
                     info.priority = priority;
+                    info.explicitOnly = false;
                     CV_LOG_DEBUG(NULL, "core(parallel): New backend priority: '" << name << "' => " << info.priority);
                     found = true;
                     hasChanges = true;
@@ -136,7 +146,7 @@ protected:
             if (!found)
             {
                 CV_LOG_INFO(NULL, "core(parallel): Adding parallel backend (plugin): '" << name << "'");
-                enabledBackends.push_back(ParallelBackendInfo{priority, name, createPluginParallelBackendFactory(name)});
+                enabledBackends.push_back(ParallelBackendInfo{priority, name, createPluginParallelBackendFactory(name), false});
                 hasChanges = true;
             }
         }
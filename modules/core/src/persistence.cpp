@@ -398,6 +398,10 @@ void FileStorage::Impl::init() {
     fmt = 0;
     file = 0;
     gzfile = 0;
+    mapped_data_file = 0;
+    mapped_data_size = 0;
+    mapped_files.clear();
+    stream_path.clear();
     empty_stream = true;
 
     strbufv.clear();
@@ -421,6 +425,7 @@ void FileStorage::Impl::init() {
 
 FileStorage::Impl::Impl(FileStorage *_fs) {
     fs_ext = _fs;
+    stream_level = 1;
     init();
 }
 
@@ -447,6 +452,7 @@ void FileStorage::Impl::release(String *out) {
         }
     }
     closeFile();
+    releaseMappedData();
     init();
 }
 
@@ -751,6 +757,8 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
 
             if (!parser_do_not_use_direct_dereference.empty()) {
                 ok = getParser().parse(ptr);
+                if (stream_callback)
+                    endStreamNodes(1);
                 if (ok) {
                     finalizeCollection(root_nodes);
 
@@ -1519,6 +1527,14 @@ uchar *FileStorage::Impl::reserveNodeSpace(FileNode &node, size_t sz) {
     if (shrinkBlock) {
         fs_data[shrinkBlockIdx]->resize(shrinkSize);
         fs_data_blksz[shrinkBlockIdx] = shrinkSize;
+
+        // the node has been moved, update its tracked copy
+        for (size_t i = 0; i < stream_path.size(); i++) {
+            if (stream_path[i].blockIdx == shrinkBlockIdx && stream_path[i].ofs == shrinkSize) {
+                stream_path[i].blockIdx = node.blockIdx;
+                stream_path[i].ofs = node.ofs;
+            }
+        }
     }
 
     return new_ptr;
@@ -1551,6 +1567,9 @@ FileNode FileStorage::Impl::addNode(FileNode &collection, const std::string &key
         }
     }
 
+    // may release the previous elements, so it must be called before getting any pointers
+    int stream_depth = stream_callback ? beginStreamNode(collection) : -1;
+
     uchar *cp = collection.ptr();
 
     size_t blockIdx = fs_data_ptrs.size() - 1;
@@ -1559,6 +1578,8 @@ FileNode FileStorage::Impl::addNode(FileNode &collection, const std::string &key
 
     size_t sz0 = 1 + (noname ? 0 : 4) + 8;
     uchar *ptr = reserveNodeSpace(node, sz0);
+    if (stream_depth >= 0)
+        stream_path.push_back(node);
 
     *ptr++ = (uchar) (elem_type | (noname ? 0 : FileNode::NAMED));
     if (elem_type == FileNode::NONE)
@@ -1571,7 +1592,7 @@ FileNode FileStorage::Impl::addNode(FileNode &collection, const std::string &key
 
     if (elem_type == FileNode::SEQ || elem_type == FileNode::MAP) {
         writeInt(ptr, 4);
-        writeInt(ptr, 0);
+        writeInt(ptr + 4, 0);
     }
 
     if (value)
@@ -1607,6 +1628,53 @@ void FileStorage::Impl::finalizeCollection(FileNode &collection) {
     writeInt(ptr, (int) rawSize);
 }
 
+namespace {
+struct StreamingStoppedByCallback {};
+}
+
+int FileStorage::Impl::beginStreamNode(const FileNode &collection) {
+    if (collection.blockIdx == 0 && collection.ofs == 0) {
+        // new stream, the root collection of the previous one is kept
+        endStreamNodes(1);
+        stream_path.clear();
+        return 0;
+    }
+    for (int i = (int) stream_path.size() - 1; i >= 0; i--) {
+        if (stream_path[i].blockIdx == collection.blockIdx && stream_path[i].ofs == collection.ofs) {
+            if (i >= stream_level)
+                return -1;
+            // all nodes after the collection are parsed completely
+            endStreamNodes(i + 1);
+            return i + 1;
+        }
+    }
+    return -1;
+}
+
+void FileStorage::Impl::endStreamNodes(size_t depth) {
+    CV_Assert(depth > 0);
+    while (stream_path.size() > depth) {
+        FileNode node = stream_path.back();
+        stream_path.pop_back();
+        FileNode &parent = stream_path.back();
+
+        // elements of upper level collections have been reported already
+        if ((int) stream_path.size() == stream_level || (!node.isMap() && !node.isSeq())) {
+            if (!stream_callback(node, parent))
+                throw StreamingStoppedByCallback();
+        }
+
+        // release the node with all its children
+        fs_data.resize(node.blockIdx + 1);
+        fs_data_ptrs.resize(node.blockIdx + 1);
+        fs_data_blksz.resize(node.blockIdx + 1);
+        freeSpaceOfs = node.ofs;
+
+        uchar *ptr = parent.ptr() + 1 + (parent.isNamed() ? 4 : 0);
+        writeInt(ptr + 4, 0);
+    }
+}
+
 void FileStorage::Impl::normalizeNodeOfs(size_t &blockIdx, size_t &ofs) const {
     while (ofs >= fs_data_blksz[blockIdx]) {
         if (blockIdx == fs_data_blksz.size() - 1) {
@@ -1978,6 +2046,25 @@ std::string FileStorage::getDefaultObjectName(const std::string& _filename)
     return name;
 }
 
+bool FileStorage::readStreaming(const String& filename, const NodeCallback& callback, int level,
+                                int flags, const String& encoding)
+{
+    CV_Assert(callback);
+    CV_Assert(level >= 1);
+    CV_Assert((flags & 3) == READ);
+
+    FileStorage fs;
+    fs.p->stream_callback = callback;
+    fs.p->stream_level = level;
+    try
+    {
+        return fs.p->open(filename.c_str(), flags, encoding.c_str());
+    }
+    catch (const StreamingStoppedByCallback&)
+    {
+        return false;
+    }
+}
 
 int FileStorage::getFormat() const
 {
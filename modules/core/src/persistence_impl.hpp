@@ -8,6 +8,7 @@
 #include "persistence.hpp"
 #include "persistence_base64_encoding.hpp"
 #include <unordered_map>
+#include <map>
 #include <iterator>
 
 
@@ -181,6 +182,24 @@ public:
 
     FileStorage* getFS();
 
+    // binary sidecar with matrices data (FileStorage::MAPPED_DATA), see persistence_mapped.cpp
+    class MappedDataFile;
+
+    bool isMappedDataEnabled() const;
+
+    // returns -1 if matrix should be written inline
+    int64 writeMappedData(const Mat& m, std::string& datafile);
+
+    Mat readMappedData(const std::string& datafile, int64 offset, int dims, const int* sizes, int type);
+
+    void releaseMappedData();
+
+    // incremental reading (FileStorage::readStreaming)
+    // returns nesting level of the new element of the collection or -1 if the element is not tracked
+    int beginStreamNode(const FileNode& collection);
+    // reports and releases tracked nodes with nesting level >= depth
+    void endStreamNodes(size_t depth);
+
     FileStorage* fs_ext;
 
     std::string filename;
@@ -242,6 +261,15 @@ public:
     size_t strbufsize;
     size_t strbufpos;
     int lineno;
+
+    FILE* mapped_data_file;
+    int64 mapped_data_size;
+    std::map<std::string, Ptr<MappedDataFile> > mapped_files;
+
+    // set by FileStorage::readStreaming() on a temporary storage, is not reset by init()
+    FileStorage::NodeCallback stream_callback;
+    int stream_level;
+    std::vector<FileNode> stream_path;  // stream root and the nodes being parsed, one per nesting level
 };
 
 }
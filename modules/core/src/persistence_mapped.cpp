@@ -0,0 +1,279 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "precomp.hpp"
+#include "persistence.hpp"
+#include "persistence_impl.hpp"
+
+#include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/logger.hpp>
+
+#if defined(_WIN32)
+#define OPENCV_HAVE_MAPPED_FILES 1
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define OPENCV_HAVE_MAPPED_FILES 1
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace cv
+{
+
+// Layout of "<filename>.bin" sidecar (FileStorage::MAPPED_DATA):
+// 64-byte header followed by raw matrix data blocks, each block is aligned on 64 bytes.
+// Data is stored in native byte order, offsets are referenced by "data_offset" nodes of matrices.
+static const char MAPPED_DATA_SIGNATURE[] = "OpenCV mapped data v1\n";
+static const size_t MAPPED_DATA_ALIGNMENT = 64;
+
+static size_t getMappedDataThreshold()
+{
+    static size_t param_threshold = utils::getConfigurationParameterSizeT("OPENCV_FILESTORAGE_MAPPED_DATA_THRESHOLD", 4096);
+    return param_threshold;
+}
+
+/** Read-only file mapping with copy-on-write pages.
+
+Matrices returned by FileStorage are views of this mapping: modification of their content doesn't change the file.
+*/
+class FileStorage::Impl::MappedDataFile
+{
+public:
+    explicit MappedDataFile(const std::string& path) :
+        ptr(NULL), len(0)
+#if defined(_WIN32)
+        , hFile(INVALID_HANDLE_VALUE), hMapping(NULL)
+#endif
+    {
+#if defined(_WIN32)
+        hFile = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (hFile == INVALID_HANDLE_VALUE)
+            CV_Error(Error::StsError, "FileStorage: can't open mapped data file: " + path);
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(hFile, &fileSize))
+            CV_Error(Error::StsError, "FileStorage: can't get size of mapped data file: " + path);
+        len = (size_t)fileSize.QuadPart;
+        if (len > 0)
+        {
+            hMapping = CreateFileMappingA(hFile, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+            if (hMapping)
+                ptr = (uchar*)MapViewOfFile(hMapping, FILE_MAP_COPY, 0, 0, 0);
+            if (!ptr)
+                CV_Error(Error::StsError, "FileStorage: can't map data file: " + path);
+        }
+#elif defined(OPENCV_HAVE_MAPPED_FILES)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            CV_Error(Error::StsError, "FileStorage: can't open mapped data file: " + path);
+        struct stat st;
+        if (fstat(fd, &st) != 0)
+        {
+            ::close(fd);
+            CV_Error(Error::StsError, "FileStorage: can't get size of mapped data file: " + path);
+        }
+        len = (size_t)st.st_size;
+        if (len > 0)
+        {
+            void* p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (p == MAP_FAILED)
+                CV_Error(Error::StsError, "FileStorage: can't map data file: " + path);
+            ptr = (uchar*)p;
+        }
+        else
+        {
+            ::close(fd);
+        }
+#else
+        FILE* f = fopen(path.c_str(), "rb");
+        if (!f)
+            CV_Error(Error::StsError, "FileStorage: can't open mapped data file: " + path);
+        fseek(f, 0, SEEK_END);
+        len = (size_t)ftell(f);
+        fseek(f, 0, SEEK_SET);
+        buffer.resize(len);
+        size_t n = len > 0 ? fread(&buffer[0], 1, len, f) : 0;
+        fclose(f);
+        if (n != len)
+            CV_Error(Error::StsError, "FileStorage: can't read data file: " + path);
+        ptr = len > 0 ? &buffer[0] : NULL;
+#endif
+        if (len < MAPPED_DATA_ALIGNMENT || memcmp(ptr, MAPPED_DATA_SIGNATURE, sizeof(MAPPED_DATA_SIGNATURE) - 1) != 0)
+        {
+            release();
+            CV_Error(Error::StsParseError, "FileStorage: invalid mapped data file: " + path);
+        }
+    }
+
+    ~MappedDataFile()
+    {
+        release();
+    }
+
+    uchar* data() const { return ptr; }
+    size_t size() const { return len; }
+
+protected:
+    void release()
+    {
+#if defined(_WIN32)
+        if (ptr)
+            UnmapViewOfFile(ptr);
+        if (hMapping)
+            CloseHandle(hMapping);
+        if (hFile != INVALID_HANDLE_VALUE)
+            CloseHandle(hFile);
+        hMapping = NULL;
+        hFile = INVALID_HANDLE_VALUE;
+#elif defined(OPENCV_HAVE_MAPPED_FILES)
+        if (ptr)
+            munmap(ptr, len);
+#else
+        buffer.clear();
+#endif
+        ptr = NULL;
+        len = 0;
+    }
+
+    uchar* ptr;
+    size_t len;
+#if defined(_WIN32)
+    HANDLE hFile;
+    HANDLE hMapping;
+#elif !defined(OPENCV_HAVE_MAPPED_FILES)
+    std::vector<uchar> buffer;
+#endif
+};
+
+// Keeps file mapping alive while there are Mat headers referencing it
+class MappedDataMatAllocator CV_FINAL : public MatAllocator
+{
+public:
+    typedef Ptr<FileStorage::Impl::MappedDataFile> MappedDataFilePtr;
+
+    UMatData* allocate(int, const int*, int, void*, size_t*, AccessFlag, UMatUsageFlags) const CV_OVERRIDE
+    {
+        CV_Error(Error::StsNotImplemented, "");
+    }
+
+    bool allocate(UMatData*, AccessFlag, UMatUsageFlags) const CV_OVERRIDE
+    {
+        return false;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if (!u)
+            return;
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        delete (MappedDataFilePtr*)u->userdata;
+        delete u;
+    }
+
+    static Mat wrap(const MappedDataFilePtr& file, size_t offset, int dims, const int* sizes, int type)
+    {
+        Mat m(dims, sizes, type, file->data() + offset);
+        UMatData* u = new UMatData(getInstance());
+        u->data = u->origdata = m.data;
+        u->size = m.total() * m.elemSize();
+        u->userdata = new MappedDataFilePtr(file);
+        u->refcount = 1;
+        m.u = u;
+        return m;
+    }
+
+    static MatAllocator* getInstance()
+    {
+        CV_SINGLETON_LAZY_INIT(MatAllocator, new MappedDataMatAllocator())
+    }
+};
+
+static std::string getDirectory(const std::string& path)
+{
+    size_t pos = path.find_last_of("/\\");
+    return pos == std::string::npos ? std::string() : path.substr(0, pos + 1);
+}
+
+bool FileStorage::Impl::isMappedDataEnabled() const
+{
+    return write_mode && !mem_mode && (flags & FileStorage::MAPPED_DATA) != 0;
+}
+
+int64 FileStorage::Impl::writeMappedData(const Mat& m, std::string& datafile)
+{
+    const size_t size = m.total() * m.elemSize();
+    if (!isMappedDataEnabled() || size < getMappedDataThreshold())
+        return -1;
+
+    const std::string path = filename + ".bin";
+    if (!mapped_data_file)
+    {
+        bool append = (flags & 3) == FileStorage::APPEND;
+        mapped_data_file = fopen(path.c_str(), append ? "ab" : "wb");
+        if (!mapped_data_file)
+            CV_Error(Error::StsError, "FileStorage: can't open mapped data file for writing: " + path);
+        fseek(mapped_data_file, 0, SEEK_END);
+        mapped_data_size = (int64)ftell(mapped_data_file);
+        if (mapped_data_size == 0)
+        {
+            char header[MAPPED_DATA_ALIGNMENT] = {0};
+            memcpy(header, MAPPED_DATA_SIGNATURE, sizeof(MAPPED_DATA_SIGNATURE) - 1);
+            fwrite(header, 1, sizeof(header), mapped_data_file);
+            mapped_data_size = (int64)sizeof(header);
+        }
+    }
+
+    const size_t padding = alignSize((size_t)mapped_data_size, MAPPED_DATA_ALIGNMENT) - (size_t)mapped_data_size;
+    if (padding > 0)
+    {
+        char zeros[MAPPED_DATA_ALIGNMENT] = {0};
+        fwrite(zeros, 1, padding, mapped_data_file);
+    }
+    const int64 offset = mapped_data_size + (int64)padding;
+
+    Mat src = m.isContinuous() ? m : m.clone();
+    if (fwrite(src.ptr(), 1, size, mapped_data_file) != size)
+        CV_Error(Error::StsError, "FileStorage: can't write mapped data file: " + path);
+    mapped_data_size = offset + (int64)size;
+
+    size_t pos = path.find_last_of("/\\");
+    datafile = pos == std::string::npos ? path : path.substr(pos + 1);
+    return offset;
+}
+
+Mat FileStorage::Impl::readMappedData(const std::string& datafile, int64 offset, int dims, const int* sizes, int type)
+{
+    CV_Assert(!datafile.empty());
+    std::string path = datafile;
+    if (path[0] != '/' && path[0] != '\\' && path.find(':') == std::string::npos)
+        path = getDirectory(filename) + datafile;
+
+    Ptr<MappedDataFile>& mapped = mapped_files[path];
+    if (!mapped)
+        mapped = makePtr<MappedDataFile>(path);
+
+    size_t total = CV_ELEM_SIZE(type);
+    for (int i = 0; i < dims; i++)
+        total *= (size_t)sizes[i];
+    if (offset < (int64)MAPPED_DATA_ALIGNMENT || (uint64)offset > mapped->size() || total > mapped->size() - (size_t)offset)
+        CV_Error(Error::StsParseError, cv::format("FileStorage: matrix data is out of mapped data file range: %s (offset=%lld size=%lld)",
+                                                  path.c_str(), (long long)offset, (long long)total));
+    return MappedDataMatAllocator::wrap(mapped, (size_t)offset, dims, sizes, type);
+}
+
+void FileStorage::Impl::releaseMappedData()
+{
+    if (mapped_data_file)
+    {
+        fclose(mapped_data_file);
+        mapped_data_file = NULL;
+    }
+    mapped_data_size = 0;
+    mapped_files.clear();
+}
+
+}
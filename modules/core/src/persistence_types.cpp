@@ -4,10 +4,23 @@
 
 #include "precomp.hpp"
 #include "persistence.hpp"
+#include "persistence_impl.hpp"
 
 namespace cv
 {
 
+// writes matrix data into binary sidecar file (FileStorage::MAPPED_DATA)
+static bool writeMappedMatData( FileStorage& fs, const Mat& m )
+{
+    std::string datafile;
+    int64 offset = fs.p->writeMappedData(m, datafile);
+    if( offset < 0 )
+        return false;
+    fs << "data_file" << datafile;
+    fs << "data_offset" << cv::format("%lld", (long long)offset);  // int values are limited by 32 bits
+    return true;
+}
+
 void write( FileStorage& fs, const String& name, const Mat& m )
 {
     char dt[22];
@@ -18,6 +31,11 @@ void write( FileStorage& fs, const String& name, const Mat& m )
         fs << "rows" << m.rows;
         fs << "cols" << m.cols;
         fs << "dt" << fs::encodeFormat( m.type(), dt, sizeof(dt) );
+        if( writeMappedMatData(fs, m) )
+        {
+            fs.endWriteStruct();
+            return;
+        }
         fs << "data" << "[:";
         for( int i = 0; i < m.rows; i++ )
             fs.writeRaw(dt, m.ptr(i), m.cols*m.elemSize());
@@ -31,6 +49,11 @@ void write( FileStorage& fs, const String& name, const Mat& m )
         fs.writeRaw( "i", m.size.p, m.dims*sizeof(int) );
         fs << "]";
         fs << "dt" << fs::encodeFormat( m.type(), dt, sizeof(dt) );
+        if( writeMappedMatData(fs, m) )
+        {
+            fs.endWriteStruct();
+            return;
+        }
         fs << "data" << "[:";
         const Mat* arrays[] = {&m, 0};
         uchar* ptrs[1] = {};
@@ -129,24 +152,37 @@ void read(const FileNode& node, Mat& m, const Mat& default_mat)
 
     elem_type = fs::decodeSimpleFormat( dt.c_str() );
 
+    int sizes[CV_MAX_DIM] = {0}, dims;
     read(node["rows"], rows, -1);
     if( rows >= 0 )
     {
         read(node["cols"], cols, -1);
-        m.create(rows, cols, elem_type);
+        dims = 2;
+        sizes[0] = rows;
+        sizes[1] = cols;
     }
     else
     {
-        int sizes[CV_MAX_DIM] = {0}, dims;
         FileNode sizes_node = node["sizes"];
         CV_Assert( !sizes_node.empty() );
 
         dims = (int)sizes_node.size();
         sizes_node.readRaw("i", sizes, dims*sizeof(sizes[0]));
+    }
 
-        m.create(dims, sizes, elem_type);
+    FileNode offset_node = node["data_offset"];
+    if( !offset_node.empty() )
+    {
+        std::string datafile, offset;
+        read(node["data_file"], datafile, std::string());
+        read(offset_node, offset, std::string());
+        CV_Assert( !offset.empty() );
+        m = node.fs->readMappedData(datafile, (int64)strtoll(offset.c_str(), NULL, 10), dims, sizes, elem_type);
+        return;
     }
 
+    m.create(dims, sizes, elem_type);
+
     FileNode data_node = node["data"];
     CV_Assert(!data_node.empty());
 
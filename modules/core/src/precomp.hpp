@@ -352,7 +352,8 @@ struct CoreTLSData
         oclExecutionContextInitialized(false), useOpenCL(-1),
 //#endif
         useIPP(-1),
-        useIPP_NE(-1)
+        useIPP_NE(-1),
+        matAllocator(NULL)
 #ifdef HAVE_OPENVX
         ,useOpenVX(-1)
 #endif
@@ -366,6 +367,7 @@ struct CoreTLSData
 //#endif
     int useIPP;    // 1 - use, 0 - do not use, -1 - auto/not initialized
     int useIPP_NE; // 1 - use, 0 - do not use, -1 - auto/not initialized
+    MatAllocator* matAllocator; // default Mat allocator of the thread (utils::MatAllocatorScope), NULL - not specified
 #ifdef HAVE_OPENVX
     int useOpenVX; // 1 - use, 0 - do not use, -1 - auto/not initialized
 #endif
@@ -373,6 +375,12 @@ struct CoreTLSData
 
 CoreTLSData& getCoreTlsData();
 
+namespace details {
+/// thread-specific default Mat allocator (utils::MatAllocatorScope), NULL if not specified
+MatAllocator* getThreadMatAllocator();
+void setThreadMatAllocator(MatAllocator* allocator);
+}
+
 #if defined(BUILD_SHARED_LIBS)
 #if defined _WIN32 || defined WINCE
 #define CL_RUNTIME_EXPORT __declspec(dllexport)
@@ -7,6 +7,7 @@
 #include <opencv2/core/utils/trace.hpp>
 #include <opencv2/core/utils/trace.private.hpp>
 #include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/metrics.hpp>
 
 #include <opencv2/core/opencl/ocl_defs.hpp>
 
@@ -15,6 +16,7 @@
 #include <sstream>
 #include <ostream>
 #include <fstream>
+#include <atomic>
 
 #if 0
 #define CV_LOG(...) CV_LOG_INFO(NULL, __VA_ARGS__)
@@ -80,6 +82,60 @@ static const cv::String& getParameterTraceLocation()
     return param_traceLocation;
 }
 
+enum TraceFormat
+{
+    TRACE_FORMAT_TXT = 0,      // OpenCV text trace files (see modules/ts/misc/trace_profiler.py)
+    TRACE_FORMAT_CHROME = 1    // Chrome trace event JSON (chrome://tracing, https://ui.perfetto.dev)
+};
+
+static TraceFormat getParameterTraceFormat()
+{
+    static TraceFormat param_traceFormat = TRACE_FORMAT_TXT;
+    static bool initialized = false;
+    if (!initialized)
+    {
+        std::string name = toUpperCase(utils::getConfigurationParameterString("OPENCV_TRACE_FORMAT", "TXT"));
+        if (name == "CHROME" || name == "JSON")
+            param_traceFormat = TRACE_FORMAT_CHROME;
+        else if (name != "TXT")
+            CV_LOG_WARNING(NULL, "OPENCV_TRACE_FORMAT: unknown value '" << name << "', TXT format is used");
+        initialized = true;
+    }
+    return param_traceFormat;
+}
+
+static size_t getParameterTraceEventBufferSize()
+{
+    static size_t param_traceEventBufferSize = utils::getConfigurationParameterSizeT("OPENCV_TRACE_EVENT_BUFFER_SIZE", 65536);
+    return param_traceEventBufferSize;
+}
+
+// -1: not initialized yet (see OPENCV_METRICS, OPENCV_METRICS_SAMPLING_PERIOD)
+static std::atomic<int> g_metricsEnabled(-1);
+static std::atomic<int> g_metricsSamplingPeriod(-1);
+
+static inline bool isMetricsEnabled()
+{
+    int enabled = g_metricsEnabled.load(std::memory_order_relaxed);
+    if (enabled < 0)
+    {
+        enabled = utils::getConfigurationParameterBool("OPENCV_METRICS", false) ? 1 : 0;
+        g_metricsEnabled.store(enabled, std::memory_order_relaxed);
+    }
+    return enabled != 0;
+}
+
+static inline int getMetricsSamplingPeriod()
+{
+    int period = g_metricsSamplingPeriod.load(std::memory_order_relaxed);
+    if (period < 0)
+    {
+        period = std::max(1, (int)utils::getConfigurationParameterSizeT("OPENCV_METRICS_SAMPLING_PERIOD", 1));
+        g_metricsSamplingPeriod.store(period, std::memory_order_relaxed);
+    }
+    return period;
+}
+
 #ifdef HAVE_OPENCL
 static bool param_synchronizeOpenCL = utils::getConfigurationParameterBool("OPENCV_TRACE_SYNC_OPENCL", false);
 #endif
@@ -223,11 +279,319 @@ static bool isITTEnabled()
 #endif
 
 
+/**
+ * Trace events (Chrome trace event format)
+ */
+struct TraceEvent
+{
+    enum Type {
+        REGION = 0,          // arg0: location flags
+        PARALLEL_STRIPE,     // arg0, arg1: stripe range
+        ALLOCATION,          // arg0: allocation size, arg1: total allocated memory
+        FLUSH
+    };
+    int type;
+    const char* name;        // static string (region location)
+    int64 timestamp;
+    int64 duration;
+    int64 arg0, arg1;
+
+    TraceEvent() : type(REGION), name(NULL), timestamp(0), duration(0), arg0(0), arg1(0) {}
+    TraceEvent(int type_, const char* name_, int64 timestamp_, int64 duration_, int64 arg0_ = 0, int64 arg1_ = 0) :
+        type(type_), name(name_), timestamp(timestamp_), duration(duration_), arg0(arg0_), arg1(arg1_)
+    {}
+};
+
+/** Single producer / single consumer ring buffer of trace events.
+ *
+ * Events are pushed by the owner thread without locks.
+ * Buffer is drained by TraceEventWriter under its mutex (on overflow or on trace finalization).
+ */
+class TraceEventBuffer
+{
+public:
+    const int threadID;
+
+    TraceEventBuffer(int threadID_, size_t capacity) :
+        threadID(threadID_), head(0), tail(0)
+    {
+        size_t n = 256;
+        while (n < capacity)
+            n *= 2;
+        events.resize(n);
+        mask = n - 1;
+    }
+
+    bool push(const TraceEvent& e)
+    {
+        const size_t h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) > mask)
+            return false;  // full
+        events[h & mask] = e;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename Fn>
+    void drain(Fn& fn)
+    {
+        const size_t h = head.load(std::memory_order_acquire);
+        size_t t = tail.load(std::memory_order_relaxed);
+        for (; t != h; t++)
+            fn(threadID, events[t & mask]);
+        tail.store(t, std::memory_order_release);
+    }
+
+protected:
+    std::vector<TraceEvent> events;
+    size_t mask;
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+};
+
+class TraceEventWriter
+{
+    std::ofstream out;
+    cv::Mutex mutex;
+    std::vector< cv::Ptr<TraceEventBuffer> > buffers;
+    bool isFirstEvent;
+    bool isClosed;
+public:
+    const std::string name;
+
+    TraceEventWriter(const std::string& filename) :
+        out(filename.c_str(), std::ios::trunc),
+        isFirstEvent(true), isClosed(false),
+        name(filename)
+    {
+        out << "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"version\":\"OpenCV " CV_VERSION "\"},\"traceEvents\":[";
+        beginEvent();
+        out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"OpenCV\"}}";
+    }
+    ~TraceEventWriter()
+    {
+        close();
+    }
+
+    cv::Ptr<TraceEventBuffer> createBuffer(int threadID)
+    {
+        cv::Ptr<TraceEventBuffer> buffer = makePtr<TraceEventBuffer>(threadID, getParameterTraceEventBufferSize());
+        cv::AutoLock l(mutex);
+        buffers.push_back(buffer);
+        beginEvent();
+        out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadID
+            << ",\"args\":{\"name\":\"" << cv::format("OpenCVThread-%03d", threadID) << "\"}}";
+        return buffer;
+    }
+
+    void put(TraceEventBuffer& buffer, const TraceEvent& e)
+    {
+        if (buffer.push(e))
+            return;
+        int64 flushBegin = getTimestampNS();
+        flush(buffer);
+        buffer.push(e);
+        buffer.push(TraceEvent(TraceEvent::FLUSH, "TraceEventWriter::flush", flushBegin, getTimestampNS() - flushBegin));
+    }
+
+    void flush(TraceEventBuffer& buffer)
+    {
+        cv::AutoLock l(mutex);
+        if (isClosed)
+            return;
+        buffer.drain(*this);
+        std::flush(out);
+    }
+
+    void close()
+    {
+        cv::AutoLock l(mutex);
+        if (isClosed)
+            return;
+        for (size_t i = 0; i < buffers.size(); i++)
+            buffers[i]->drain(*this);
+        out << "]}" << std::endl;
+        out.close();
+        isClosed = true;
+    }
+
+    // called by TraceEventBuffer::drain()
+    void operator()(int threadID, const TraceEvent& e)
+    {
+        beginEvent();
+        switch (e.type)
+        {
+        case TraceEvent::REGION:
+            out << "{\"name\":\"";
+            writeEscaped(e.name);
+            out << "\",\"cat\":\"" << getRegionCategory((int)e.arg0) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadID << ",\"ts\":";
+            writeTimestamp(e.timestamp);
+            out << ",\"dur\":";
+            writeTimestamp(e.duration);
+            out << "}";
+            break;
+        case TraceEvent::PARALLEL_STRIPE:
+            out << "{\"name\":\"" << e.name << "\",\"cat\":\"parallel\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadID << ",\"ts\":";
+            writeTimestamp(e.timestamp);
+            out << ",\"dur\":";
+            writeTimestamp(e.duration);
+            out << ",\"args\":{\"start\":" << e.arg0 << ",\"end\":" << e.arg1 << "}}";
+            break;
+        case TraceEvent::ALLOCATION:
+            out << "{\"name\":\"" << e.name << "\",\"cat\":\"memory\",\"ph\":\"C\",\"pid\":1,\"tid\":" << threadID << ",\"ts\":";
+            writeTimestamp(e.timestamp);
+            out << ",\"args\":{\"allocated\":" << e.arg1 << "}}";
+            break;
+        case TraceEvent::FLUSH:
+            out << "{\"name\":\"" << e.name << "\",\"cat\":\"trace\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadID << ",\"ts\":";
+            writeTimestamp(e.timestamp);
+            out << ",\"dur\":";
+            writeTimestamp(e.duration);
+            out << "}";
+            break;
+        default:
+            CV_DbgAssert(0 && "unknown trace event");
+        }
+    }
+
+protected:
+    void beginEvent()
+    {
+        if (!isFirstEvent)
+            out << ",\n";
+        isFirstEvent = false;
+    }
+
+    // JSON timestamps are in microseconds
+    void writeTimestamp(int64 ns)
+    {
+        CV_DbgAssert(ns >= 0);
+        out << (ns / 1000) << '.' << (char)('0' + (ns / 100) % 10) << (char)('0' + (ns / 10) % 10) << (char)('0' + ns % 10);
+    }
+
+    void writeEscaped(const char* str)
+    {
+        for (; *str; str++)
+        {
+            const char c = *str;
+            if (c == '"' || c == '\\')
+                out << '\\' << c;
+            else if ((unsigned char)c < 0x20)
+                out << ' ';
+            else
+                out << c;
+        }
+    }
+
+    static const char* getRegionCategory(int flags)
+    {
+        switch (flags & REGION_FLAG_IMPL_MASK)
+        {
+        case REGION_FLAG_IMPL_IPP: return "ipp";
+        case REGION_FLAG_IMPL_OPENCL: return "opencl";
+        case REGION_FLAG_IMPL_OPENVX: return "openvx";
+        default: break;
+        }
+        return (flags & REGION_FLAG_APP_CODE) ? "app" : "opencv";
+    }
+};
+
+TraceEventBuffer* TraceManagerThreadLocal::getEventBuffer() const
+{
+    if (events.empty())
+    {
+        TraceEventWriter* writer = getTraceManager().event_writer.get();
+        if (writer)
+            events = writer->createBuffer(threadID);
+    }
+    return events.get();
+}
+
+static void recordTraceEvent(TraceManagerThreadLocal& ctx, const TraceEvent& e)
+{
+    TraceEventBuffer* buffer = ctx.getEventBuffer();
+    if (buffer)
+        getTraceManager().event_writer->put(*buffer, e);
+}
+
+void traceParallelStripe(int64 beginTimestamp, int64 endTimestamp, int rangeStart, int rangeEnd)
+{
+    if (!TraceManager::isEventRecordingActivated())
+        return;
+    TraceManagerThreadLocal& ctx = getTraceManager().tls.getRef();
+    recordTraceEvent(ctx, TraceEvent(TraceEvent::PARALLEL_STRIPE, "parallel_for_ stripe",
+            beginTimestamp, endTimestamp - beginTimestamp, rangeStart, rangeEnd));
+}
+
+static std::atomic<int64> g_traceAllocatedMemory(0);
+
+void traceAllocation(int64 size)
+{
+    if (!TraceManager::isEventRecordingActivated())
+        return;
+    const int64 total = g_traceAllocatedMemory.fetch_add(size) + size;
+    TraceManagerThreadLocal& ctx = getTraceManager().tls.getRef();
+    recordTraceEvent(ctx, TraceEvent(TraceEvent::ALLOCATION, "Mat memory", getTimestampNS(), 0, size, total));
+}
+
+
+void RegionMetrics::reset()
+{
+    calls = 0;
+    sampledCalls = 0;
+    totalDuration = 0;
+    maxDuration = 0;
+    processedBytes = 0;
+    for (int i = 0; i < BUCKETS; i++)
+        histogram[i] = 0;
+}
+
+void RegionMetrics::addSample(int64 duration)
+{
+    sampledCalls.fetch_add(1, std::memory_order_relaxed);
+    totalDuration.fetch_add(duration, std::memory_order_relaxed);
+    histogram[getBucket(duration)].fetch_add(1, std::memory_order_relaxed);
+    int64 prevMax = maxDuration.load(std::memory_order_relaxed);
+    while (duration > prevMax && !maxDuration.compare_exchange_weak(prevMax, duration, std::memory_order_relaxed))
+        ;
+}
+
+/*static*/ int RegionMetrics::getBucket(int64 duration)
+{
+    if (duration < SUB_BUCKETS)
+        return duration > 0 ? (int)duration : 0;
+    if (duration >= ((int64)1 << MAX_DURATION_LOG2))
+        return BUCKETS - 1;
+    int msb = SUB_BUCKETS_LOG2;
+    while ((duration >> (msb + 1)) != 0)
+        msb++;
+    const int sub = (int)(duration >> (msb - SUB_BUCKETS_LOG2)) & (SUB_BUCKETS - 1);
+    return (msb - SUB_BUCKETS_LOG2 + 1) * SUB_BUCKETS + sub;
+}
+
+/*static*/ int64 RegionMetrics::getBucketValue(int bucket)
+{
+    if (bucket < SUB_BUCKETS)
+        return bucket;
+    const int msb = bucket / SUB_BUCKETS + SUB_BUCKETS_LOG2 - 1;
+    const int sub = bucket % SUB_BUCKETS;
+    const int64 width = (int64)1 << (msb - SUB_BUCKETS_LOG2);
+    return (SUB_BUCKETS + sub) * width + width / 2;
+}
+
+// locations with allocated LocationExtraData, guarded by cv::getInitializationMutex()
+static std::vector<const Region::LocationStaticStorage*>& getLocationsRegistry()
+{
+    static std::vector<const Region::LocationStaticStorage*> g_locations;
+    return g_locations;
+}
+
 Region::LocationExtraData::LocationExtraData(const LocationStaticStorage& location)
 {
     CV_UNUSED(location);
     static int g_location_id_counter = 0;
     global_location_id = CV_XADD(&g_location_id_counter, 1) + 1;
+    getLocationsRegistry().push_back(&location);
     CV_LOG("Register location: " << global_location_id << " (" << (void*)&location << ")"
             << std::endl << "    file: " << location.filename
             << std::endl << "    line: " << location.line
@@ -374,6 +738,11 @@ void Region::Impl::leaveRegion(TraceManagerThreadLocal& ctx)
         msg.formatRegionLeave(region, result);
         s->put(msg);
     }
+    if (TraceManager::isEventRecordingActivated())
+    {
+        recordTraceEvent(ctx, TraceEvent(TraceEvent::REGION, location.name,
+                beginTimestamp, endTimestamp - beginTimestamp, location.flags));
+    }
 
     if (location.flags & REGION_FLAG_FUNCTION)
     {
@@ -431,8 +800,13 @@ void RegionStatisticsStatus::checkResetSkipMode(int leaveDepth)
 
 Region::Region(const LocationStaticStorage& location) :
     pImpl(NULL),
-    implFlags(0)
+    implFlags(0),
+    metricsLocation(NULL),
+    metricsBeginTimestamp(-1)
 {
+    if (isMetricsEnabled() && (location.flags & REGION_FLAG_FUNCTION))
+        beginMetrics(location);
+
     // Checks:
     // - global enable flag
     // - parent region is disabled
@@ -586,8 +960,41 @@ Region::Region(const LocationStaticStorage& location) :
     }
 }
 
+void Region::beginMetrics(const LocationStaticStorage& location)
+{
+    LocationExtraData* extra = LocationExtraData::init(location);
+    const int64 callIndex = extra->metrics.calls.fetch_add(1, std::memory_order_relaxed);
+    metricsLocation = &location;
+    implFlags |= REGION_FLAG__METRICS;
+    const int period = getMetricsSamplingPeriod();
+    if (period == 1 || callIndex % period == 0)
+        metricsBeginTimestamp = getTimestampNS();
+}
+
+void Region::endMetrics()
+{
+    CV_DbgAssert(metricsLocation);
+    if (metricsBeginTimestamp >= 0)
+        (*metricsLocation->ppExtra)->metrics.addSample(getTimestampNS() - metricsBeginTimestamp);
+    metricsLocation = NULL;
+}
+
+void Region::addProcessedBytes_(int64 bytes) const
+{
+    CV_DbgAssert(metricsLocation);
+    (*metricsLocation->ppExtra)->metrics.processedBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
 void Region::destroy()
 {
+    if (implFlags & REGION_FLAG__METRICS)
+    {
+        endMetrics();
+        implFlags &= ~REGION_FLAG__METRICS;
+        if (implFlags == 0)
+            return;
+    }
+
     CV_DbgAssert(implFlags != 0);
 
     TraceManagerThreadLocal& ctx = getTraceManager().tls.getRef();
@@ -832,6 +1239,7 @@ TraceStorage* TraceManagerThreadLocal::getStorage() const
 
 static bool activated = false;
 static bool isInitialized = false;
+static bool eventRecordingActivated = false;
 
 TraceManager::TraceManager()
 {
@@ -844,7 +1252,17 @@ TraceManager::TraceManager()
     activated = getParameterTraceEnable();
 
     if (activated)
-        trace_storage.reset(new SyncTraceStorage(std::string(getParameterTraceLocation()) + ".txt"));
+    {
+        if (getParameterTraceFormat() == TRACE_FORMAT_CHROME)
+        {
+            event_writer.reset(new TraceEventWriter(std::string(getParameterTraceLocation()) + ".json"));
+            eventRecordingActivated = true;
+        }
+        else
+        {
+            trace_storage.reset(new SyncTraceStorage(std::string(getParameterTraceLocation()) + ".txt"));
+        }
+    }
 
 #ifdef OPENCV_WITH_ITT
     if (isITTEnabled())
@@ -865,6 +1283,13 @@ TraceManager::~TraceManager()
     }
 #endif
 
+    eventRecordingActivated = false;
+    if (event_writer)
+    {
+        event_writer->close();
+        CV_LOG_INFO(NULL, "Trace: trace events are written into " << event_writer->name);
+    }
+
     std::vector<TraceManagerThreadLocal*> threads_ctx;
     tls.gather(threads_ctx);
     size_t totalEvents = 0, totalSkippedEvents = 0;
@@ -911,6 +1336,11 @@ bool TraceManager::isActivated()
     return activated;
 }
 
+bool TraceManager::isEventRecordingActivated()
+{
+    return isActivated() && eventRecordingActivated;
+}
+
 
 static TraceManager* getTraceManagerCallOnce()
 {
@@ -1132,8 +1562,11 @@ void traceArg(const TraceArg& arg, double value)
 
 #else
 
-Region::Region(const LocationStaticStorage&) : pImpl(NULL), implFlags(0) {}
+Region::Region(const LocationStaticStorage&) : pImpl(NULL), implFlags(0), metricsLocation(NULL), metricsBeginTimestamp(-1) {}
 void Region::destroy() {}
+void Region::beginMetrics(const LocationStaticStorage&) {}
+void Region::endMetrics() {}
+void Region::addProcessedBytes_(int64) const {}
 
 void traceArg(const TraceArg&, const char*) {}
 void traceArg(const TraceArg&, int) {};
@@ -1143,3 +1576,117 @@ void traceArg(const TraceArg&, double) {};
 #endif
 
 }}}} // namespace
+
+namespace cv {
+namespace utils {
+namespace metrics {
+
+#ifdef OPENCV_TRACE
+
+using namespace cv::utils::trace::details;
+
+void setEnabled(bool enabled)
+{
+    g_metricsEnabled.store(enabled ? 1 : 0, std::memory_order_relaxed);
+}
+
+bool isEnabled()
+{
+    return isMetricsEnabled();
+}
+
+void setSamplingPeriod(int period)
+{
+    CV_Assert(period >= 1);
+    g_metricsSamplingPeriod.store(period, std::memory_order_relaxed);
+}
+
+int getSamplingPeriod()
+{
+    return getMetricsSamplingPeriod();
+}
+
+static double getPercentileMs(const std::vector<int64>& histogram, int64 count, double p, int64 maxDuration)
+{
+    const int64 rank = std::max((int64)1, (int64)std::ceil(p * count));
+    int64 acc = 0;
+    for (size_t i = 0; i < histogram.size(); i++)
+    {
+        acc += histogram[i];
+        if (acc >= rank)
+            return std::min(RegionMetrics::getBucketValue((int)i), maxDuration) * 1e-6;
+    }
+    return maxDuration * 1e-6;
+}
+
+static bool compareByTotalTime(const FunctionMetrics& a, const FunctionMetrics& b)
+{
+    return a.totalMs > b.totalMs;
+}
+
+void getSnapshot(std::vector<FunctionMetrics>& result, bool reset)
+{
+    result.clear();
+    std::vector<int64> histogram(RegionMetrics::BUCKETS);
+
+    cv::AutoLock lock(cv::getInitializationMutex());
+    const std::vector<const Region::LocationStaticStorage*>& locations = getLocationsRegistry();
+    for (size_t i = 0; i < locations.size(); i++)
+    {
+        const Region::LocationStaticStorage& location = *locations[i];
+        RegionMetrics& m = (*location.ppExtra)->metrics;
+        const int64 calls = m.calls.load(std::memory_order_relaxed);
+        if (calls == 0)
+            continue;
+
+        FunctionMetrics fm;
+        fm.name = location.name;
+        fm.filename = location.filename;
+        fm.line = location.line;
+        fm.calls = calls;
+        fm.processedBytes = m.processedBytes.load(std::memory_order_relaxed);
+        int64 sampledCalls = 0;
+        for (int b = 0; b < RegionMetrics::BUCKETS; b++)
+        {
+            histogram[b] = m.histogram[b].load(std::memory_order_relaxed);
+            sampledCalls += histogram[b];
+        }
+        fm.sampledCalls = sampledCalls;
+        if (sampledCalls > 0)
+        {
+            const int64 maxDuration = m.maxDuration.load(std::memory_order_relaxed);
+            fm.totalMs = m.totalDuration.load(std::memory_order_relaxed) * 1e-6;
+            fm.meanMs = fm.totalMs / sampledCalls;
+            fm.p50Ms = getPercentileMs(histogram, sampledCalls, 0.50, maxDuration);
+            fm.p90Ms = getPercentileMs(histogram, sampledCalls, 0.90, maxDuration);
+            fm.p99Ms = getPercentileMs(histogram, sampledCalls, 0.99, maxDuration);
+            fm.maxMs = maxDuration * 1e-6;
+        }
+        result.push_back(fm);
+
+        if (reset)
+            m.reset();
+    }
+    std::sort(result.begin(), result.end(), compareByTotalTime);
+}
+
+void reset()
+{
+    cv::AutoLock lock(cv::getInitializationMutex());
+    const std::vector<const Region::LocationStaticStorage*>& locations = getLocationsRegistry();
+    for (size_t i = 0; i < locations.size(); i++)
+        (*locations[i]->ppExtra)->metrics.reset();
+}
+
+#else
+
+void setEnabled(bool) {}
+bool isEnabled() { return false; }
+void setSamplingPeriod(int period) { CV_Assert(period >= 1); }
+int getSamplingPeriod() { return 1; }
+void getSnapshot(std::vector<FunctionMetrics>& result, bool) { result.clear(); }
+void reset() {}
+
+#endif
+
+}}} // namespace
@@ -0,0 +1,270 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "precomp.hpp"
+#include "matrix_expressions.hpp"
+
+namespace cv
+{
+
+ElementwiseOps& ElementwiseOps::addOp(int code, int i, double alpha, const Scalar& s)
+{
+    Op op;
+    op.code = code;
+    op.i = i;
+    op.alpha = alpha;
+    op.s = s;
+    ops_.push_back(op);
+    return *this;
+}
+
+ElementwiseOps& ElementwiseOps::scale(double alpha, double beta) { return addOp(OP_SCALE, -1, alpha, Scalar::all(beta)); }
+ElementwiseOps& ElementwiseOps::addInput(int i, double alpha) { return addOp(OP_ADD, i, alpha); }
+ElementwiseOps& ElementwiseOps::add(const Scalar& s) { return addOp(OP_SCALE, -1, 1, s); }
+ElementwiseOps& ElementwiseOps::subtractInput(int i) { return addOp(OP_ADD, i, -1); }
+ElementwiseOps& ElementwiseOps::subtract(const Scalar& s) { return addOp(OP_SCALE, -1, 1, -s); }
+ElementwiseOps& ElementwiseOps::multiplyInput(int i, double scale) { return addOp(OP_MUL, i, scale); }
+ElementwiseOps& ElementwiseOps::multiply(const Scalar& s) { return addOp(OP_MUL, -1, 1, s); }
+ElementwiseOps& ElementwiseOps::divideInput(int i, double scale) { return addOp(OP_DIV, i, scale); }
+ElementwiseOps& ElementwiseOps::reciprocal(double scale) { return addOp(OP_RECIP, -1, scale); }
+ElementwiseOps& ElementwiseOps::minInput(int i) { return addOp(OP_MIN, i, 1); }
+ElementwiseOps& ElementwiseOps::min(double value) { return addOp(OP_MIN, -1, value); }
+ElementwiseOps& ElementwiseOps::maxInput(int i) { return addOp(OP_MAX, i, 1); }
+ElementwiseOps& ElementwiseOps::max(double value) { return addOp(OP_MAX, -1, value); }
+ElementwiseOps& ElementwiseOps::absdiffInput(int i) { return addOp(OP_ABSDIFF, i, 1); }
+ElementwiseOps& ElementwiseOps::absdiff(const Scalar& s) { return addOp(OP_ABSDIFF, -1, 1, s); }
+ElementwiseOps& ElementwiseOps::abs() { return addOp(OP_ABSDIFF, -1, 1, Scalar()); }
+ElementwiseOps& ElementwiseOps::cast(int depth)
+{
+    CV_Assert(depth >= CV_8U && depth <= CV_64F && depth != CV_16F);
+    return addOp(OP_CAST, depth, 1);
+}
+
+namespace {
+
+// Compiles ElementwiseOps into nodes of element-wise program (see matrix_expressions.simd.hpp)
+class ElementwiseOpsCompiler
+{
+public:
+    ElementwiseOpsCompiler(int ninputs, int wdepth_) : inputNodes(ninputs, -1), wdepth(wdepth_) {}
+
+    int addNode(int code, int arg0, int arg1 = -1, double alpha = 1, double beta = 0, const Scalar& s = Scalar())
+    {
+        ElementwiseOp op;
+        op.code = code;
+        op.arg0 = arg0;
+        op.arg1 = arg1;
+        op.alpha = alpha;
+        op.beta = beta;
+        for( int c = 0; c < 4; c++ )
+            op.s[c] = s[c];
+        nodes.push_back(op);
+        return (int)nodes.size() - 1;
+    }
+
+    int input(int i)
+    {
+        CV_CheckGE(i, 0, "ElementwiseOps: invalid input index");
+        CV_CheckLT(i, (int)inputNodes.size(), "ElementwiseOps: invalid input index");
+        if( inputNodes[i] < 0 )
+            inputNodes[i] = addNode(ELEMWISE_INPUT, i);
+        return inputNodes[i];
+    }
+
+    int constant(const Scalar& s)
+    {
+        return addNode(ELEMWISE_CONST, -1, -1, 1, 0, s);
+    }
+
+    void compile(const std::vector<ElementwiseOps::Op>& ops)
+    {
+        int x = input(0);
+        for( size_t k = 0; k < ops.size(); k++ )
+        {
+            const ElementwiseOps::Op& op = ops[k];
+            switch( op.code )
+            {
+            case ElementwiseOps::OP_SCALE:
+                if( op.alpha != 1 )
+                    x = addNode(ELEMWISE_ADDW, x, -1, op.alpha);
+                if( op.s != Scalar() )
+                    x = addNode(ELEMWISE_ADDW, x, constant(op.s), 1, 1);
+                break;
+            case ElementwiseOps::OP_ADD:
+                x = addNode(ELEMWISE_ADDW, x, input(op.i), 1, op.alpha);
+                break;
+            case ElementwiseOps::OP_MUL:
+                x = addNode(ELEMWISE_MUL, x, op.i >= 0 ? input(op.i) : constant(op.s), op.alpha);
+                break;
+            case ElementwiseOps::OP_DIV:
+                x = addNode(ELEMWISE_DIV, x, input(op.i), op.alpha);
+                break;
+            case ElementwiseOps::OP_RECIP:
+                x = addNode(ELEMWISE_RECIP, x, -1, op.alpha);
+                break;
+            case ElementwiseOps::OP_MIN:
+                x = addNode(ELEMWISE_MIN, x, op.i >= 0 ? input(op.i) : constant(Scalar::all(op.alpha)));
+                break;
+            case ElementwiseOps::OP_MAX:
+                x = addNode(ELEMWISE_MAX, x, op.i >= 0 ? input(op.i) : constant(Scalar::all(op.alpha)));
+                break;
+            case ElementwiseOps::OP_ABSDIFF:
+                x = addNode(ELEMWISE_ABSDIFF, x, op.i >= 0 ? input(op.i) : constant(op.s));
+                break;
+            case ElementwiseOps::OP_CAST:
+                x = cast(x, op.i);
+                break;
+            default:
+                CV_Error(Error::StsBadArg, "ElementwiseOps: unknown operation");
+            }
+        }
+        // the last node is the result
+        if( nodes.size() == 1 || x != (int)nodes.size() - 1 )
+            addNode(ELEMWISE_ADDW, x, -1, 1);
+    }
+
+    int cast(int x, int depth)
+    {
+        static const double ranges[][2] = {
+            { 0, UCHAR_MAX }, { SCHAR_MIN, SCHAR_MAX }, { 0, USHRT_MAX }, { SHRT_MIN, SHRT_MAX },
+            { INT_MIN, INT_MAX }
+        };
+        if( depth == wdepth || depth == CV_64F )
+            return x;
+        if( depth == CV_32F )
+            return addNode(ELEMWISE_CAST, x, -1, 0, 0, Scalar(1));
+        double lo = ranges[depth][0], hi = ranges[depth][1];
+        if( depth == CV_32S && wdepth == CV_32F )
+            hi = 2147483520.;  // max float value below 2^31
+        return addNode(ELEMWISE_CAST, x, -1, lo, hi);
+    }
+
+    std::vector<ElementwiseOp> nodes;
+    std::vector<int> inputNodes;
+    int wdepth;
+};
+
+class TransformElementwiseInvoker : public ParallelLoopBody
+{
+public:
+    TransformElementwiseInvoker(const std::vector<Mat>& src_, Mat& dst_, const std::vector<ElementwiseOp>& nodes_,
+                                int wdepth_, int len_, int chunk_)
+        : src(src_), dst(dst_), nodes(nodes_), wdepth(wdepth_), len(len_), chunk(chunk_)
+    {
+        func = getElementwiseProgramFunc(wdepth);
+        CV_Assert(func);
+        for( size_t i = 0; i < src.size(); i++ )
+        {
+            BinaryFunc cvt = 0;
+            if( src[i].depth() != wdepth )
+            {
+                cvt = getConvertFunc(src[i].depth(), wdepth);
+                CV_Assert(cvt);
+            }
+            srcCvt.push_back(cvt);
+        }
+        dstCvt = 0;
+        if( dst.depth() != wdepth )
+        {
+            dstCvt = getConvertFunc(wdepth, dst.depth());
+            CV_Assert(dstCvt);
+        }
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        const int ninputs = (int)src.size(), cn = dst.channels();
+        const int nchunks = (len + chunk - 1) / chunk;
+        const size_t wsz = CV_ELEM_SIZE1(wdepth), dsz = dst.elemSize1();
+        // block buffers of the program, converted inputs and output
+        AutoBuffer<uchar> _buf((nodes.size()*ELEMWISE_BLOCK_SIZE + (ninputs + 1)*(size_t)chunk)*wsz);
+        uchar* progbuf = _buf.data();
+        uchar* cvtbuf = progbuf + nodes.size()*ELEMWISE_BLOCK_SIZE*wsz;
+        AutoBuffer<const uchar*, 16> sptr(ninputs);
+
+        for( int idx = range.start; idx < range.end; idx++ )
+        {
+            const int y = idx / nchunks, x = (idx % nchunks) * chunk;
+            const int n = std::min(chunk, len - x);
+            for( int i = 0; i < ninputs; i++ )
+            {
+                const uchar* sp = src[i].ptr(y) + x*src[i].elemSize1();
+                if( srcCvt[i] )
+                {
+                    uchar* buf = cvtbuf + (size_t)i*chunk*wsz;
+                    srcCvt[i](sp, 0, 0, 0, buf, 0, Size(n, 1), 0);
+                    sp = buf;
+                }
+                sptr[i] = sp;
+            }
+            uchar* dp = dst.ptr(y) + x*dsz;
+            uchar* wp = dstCvt ? cvtbuf + (size_t)ninputs*chunk*wsz : dp;
+            func(&nodes[0], (int)nodes.size(), sptr.data(), wp, n, cn, progbuf);
+            if( dstCvt )
+                dstCvt(wp, 0, 0, 0, dp, 0, Size(n, 1), 0);
+        }
+    }
+
+protected:
+    const std::vector<Mat>& src;
+    Mat& dst;
+    const std::vector<ElementwiseOp>& nodes;
+    int wdepth, len, chunk;
+    ElementwiseProgramFunc func;
+    std::vector<BinaryFunc> srcCvt;
+    BinaryFunc dstCvt;
+};
+
+} // namespace
+
+void transformElementwise(InputArrayOfArrays _src, OutputArray _dst, const ElementwiseOps& ops, int dtype)
+{
+    CV_INSTRUMENT_REGION();
+
+    std::vector<Mat> src;
+    if( _src.isMatVector() || _src.isUMatVector() || _src.kind() == _InputArray::STD_ARRAY_MAT )
+        _src.getMatVector(src);
+    else
+        src.push_back(_src.getMat());
+    CV_Assert(!src.empty() && !src[0].empty());
+    CV_Assert(src[0].dims <= 2);
+
+    const int cn = src[0].channels();
+    CV_CheckLE(cn, 4, "transformElementwise: up to 4 channels are supported");
+    bool has64f = false;
+    for( size_t i = 0; i < src.size(); i++ )
+    {
+        CV_Assert(src[i].size == src[0].size);
+        CV_CheckEQ(src[i].channels(), cn, "transformElementwise: input arrays must have the same number of channels");
+        CV_CheckNE(src[i].depth(), CV_16F, "transformElementwise: CV_16F is not supported");
+        has64f = has64f || src[i].depth() == CV_64F;
+    }
+    const int ddepth = dtype < 0 ? src[0].depth() : CV_MAT_DEPTH(dtype);
+    CV_CheckNE(ddepth, CV_16F, "transformElementwise: CV_16F is not supported");
+    const int wdepth = has64f || ddepth == CV_64F ? CV_64F : CV_32F;
+
+    ElementwiseOpsCompiler compiler((int)src.size(), wdepth);
+    compiler.compile(ops.getOps());
+
+    // output may be one of the inputs, keep input headers
+    _dst.create(src[0].size(), CV_MAKETYPE(ddepth, cn));
+    Mat dst = _dst.getMat();
+
+    bool continuous = dst.isContinuous();
+    for( size_t i = 0; i < src.size(); i++ )
+        continuous = continuous && src[i].isContinuous();
+    int rows = dst.rows, len = dst.cols*cn;
+    if( continuous )
+    {
+        len = (int)(dst.total()*cn);
+        rows = 1;
+    }
+    // converted inputs and output are kept in chunks of this size
+    const int chunk = ELEMWISE_BLOCK_SIZE*8;
+    const int nchunks = (len + chunk - 1) / chunk;
+    TransformElementwiseInvoker invoker(src, dst, compiler.nodes, wdepth, len, chunk);
+    parallel_for_(Range(0, rows*nchunks), invoker, (double)rows*len/(1 << 16));
+}
+
+} // namespace
@@ -2,6 +2,8 @@
 // It is subject to the license terms in the LICENSE file found in the top-level directory
 // of this distribution and at http://opencv.org/license.html.
 #include "test_precomp.hpp"
+#include "opencv2/core/utils/buffer_pool_allocator.hpp"
+#include "opencv2/core/utils/hugepages_allocator.hpp"
 
 namespace opencv_test { namespace {
 
@@ -141,4 +143,125 @@ TEST_F(AllocatorTest, DummyAllocator)
     EXPECT_EQ(2, DummyAllocator::deallocations);
 }
 
+TEST(Core_BufferPoolMatAllocator, reuse_released_buffers)
+{
+    cv::utils::BufferPoolMatAllocator pool(16 << 20);
+    cv::utils::AllocatorStatisticsInterface& stats = pool.getAllocatorStatistics();
+    const uchar* ptr = NULL;
+    {
+        cv::Mat m2;
+        m2.allocator = &pool;
+        m2.create(480, 640, CV_8UC3);
+        EXPECT_EQ(&pool, m2.u->currAllocator);
+        EXPECT_EQ(0u, (size_t)m2.data % CV_MALLOC_ALIGN);
+        EXPECT_EQ((uint64_t)m2.total() * m2.elemSize(), stats.getCurrentUsage());
+        ptr = m2.data;
+    }
+    EXPECT_EQ(0u, stats.getCurrentUsage());
+    EXPECT_LE((size_t)480 * 640 * 3, pool.getReservedSize());
+    {
+        cv::Mat m;
+        m.allocator = &pool;
+        m.create(480, 640, CV_8UC3);
+        EXPECT_EQ(ptr, m.data);  // reused
+        EXPECT_EQ(0u, pool.getReservedSize());
+    }
+    EXPECT_EQ(2u, stats.getNumberOfAllocations());
+    pool.freeAllReservedBuffers();
+    EXPECT_EQ(0u, pool.getReservedSize());
+}
+
+TEST(Core_BufferPoolMatAllocator, reserved_size_limit)
+{
+    cv::utils::BufferPoolMatAllocator pool(1 << 20);
+    {
+        cv::Mat big;
+        big.allocator = &pool;
+        big.create(1024, 1024, CV_8UC1);  // exceeds 1/8 of the limit
+    }
+    EXPECT_EQ(0u, pool.getReservedSize());
+    {
+        std::vector<cv::Mat> mats(20);
+        for (size_t i = 0; i < mats.size(); i++)
+        {
+            mats[i].allocator = &pool;
+            mats[i].create(256, 256, CV_8UC1);
+        }
+    }
+    EXPECT_LE(pool.getReservedSize(), pool.getMaxReservedSize());
+    EXPECT_GT(pool.getReservedSize(), 0u);
+
+    pool.setMaxReservedSize(0);
+    EXPECT_EQ(0u, pool.getReservedSize());
+}
+
+TEST(Core_BufferPoolMatAllocator, scope)
+{
+    cv::utils::BufferPoolMatAllocator pool;
+    cv::MatAllocator* defaultAllocator = cv::Mat::getDefaultAllocator();
+    cv::Mat src(256, 256, CV_32FC1, Scalar::all(1)), dst;
+    {
+        cv::utils::MatAllocatorScope scope(&pool);
+        EXPECT_EQ(&pool, cv::Mat::getDefaultAllocator());
+        {
+            cv::utils::MatAllocatorScope nested(NULL);
+            EXPECT_EQ(defaultAllocator, cv::Mat::getDefaultAllocator());
+        }
+        EXPECT_EQ(&pool, cv::Mat::getDefaultAllocator());
+
+        cv::Mat tmp = src * 2;
+        EXPECT_EQ(&pool, tmp.u->currAllocator);
+
+        // parallel_for_ bodies use allocator of the calling thread
+        std::vector<const cv::MatAllocator*> allocators(8, NULL);
+        parallel_for_(Range(0, (int)allocators.size()), [&](const Range& r)
+        {
+            for (int i = r.start; i < r.end; i++)
+            {
+                cv::Mat m(16, 16, CV_8UC1);
+                allocators[i] = m.u->currAllocator;
+            }
+        });
+        for (size_t i = 0; i < allocators.size(); i++)
+            EXPECT_EQ(&pool, allocators[i]) << i;
+
+        cv::add(tmp, src, dst);
+    }
+    EXPECT_EQ(defaultAllocator, cv::Mat::getDefaultAllocator());
+    EXPECT_EQ(0, cvtest::norm(dst, Mat(dst.size(), dst.type(), Scalar::all(3)), NORM_INF));
+    EXPECT_NE(0u, pool.getAllocatorStatistics().getCurrentUsage());  // dst is still alive
+    dst.release();
+    EXPECT_EQ(0u, pool.getAllocatorStatistics().getCurrentUsage());
+}
+
+TEST(Core_HugePagesMatAllocator, allocate)
+{
+    cv::MatAllocator* allocator = cv::utils::getHugePagesMatAllocator();
+    ASSERT_TRUE(allocator != NULL);
+    cv::utils::AllocatorStatisticsInterface& stats = cv::utils::getHugePagesAllocatorStatistics();
+    const uint64_t usage0 = stats.getCurrentUsage();
+    {
+        cv::Mat m;
+        m.allocator = allocator;
+        m.create(16, 16, CV_8UC3);
+        m.setTo(Scalar::all(7));
+        EXPECT_EQ(usage0, stats.getCurrentUsage());  // small buffers are not mapped
+        EXPECT_EQ(0, cvtest::norm(m, Mat(m.size(), m.type(), Scalar::all(7)), NORM_INF));
+
+        cv::Mat big;
+        big.allocator = allocator;
+        big.create(2048, 2048, CV_32FC1);  // 16Mb
+        EXPECT_EQ(allocator, big.u->currAllocator);
+        big.setTo(Scalar::all(3));
+        cv::Mat dst = big + 1;
+        EXPECT_EQ(0, cvtest::norm(dst, Mat(dst.size(), dst.type(), Scalar::all(4)), NORM_INF));
+        if (stats.getCurrentUsage() != usage0)
+        {
+            EXPECT_LE(usage0 + big.total() * big.elemSize(), stats.getCurrentUsage());
+            EXPECT_EQ(0u, (size_t)big.data % 4096);
+        }
+    }
+    EXPECT_EQ(usage0, stats.getCurrentUsage());
+}
+
 }} // namespace
@@ -2387,6 +2387,46 @@ INSTANTIATE_TEST_CASE_P(Arithm, TransposeND, testing::Combine(
     testing::Values(perf::MatType(CV_8UC1), CV_32FC1)
 ));
 
+typedef testing::TestWithParam<perf::MatType> TransposeTiled;
+
+TEST_P(TransposeTiled, accuracy)
+{
+    const int type = GetParam();
+    RNG& rng = theRNG();
+    // sizes are not multiples of tile or register block sizes, ROI rows are not continuous
+    const Size sizes[] = { Size(1, 7), Size(17, 3), Size(131, 67), Size(600, 517) };
+    for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++)
+    {
+        const Size sz = sizes[i];
+        SCOPED_TRACE(cv::format("%dx%d", sz.width, sz.height));
+        Mat big(sz.height + 2, sz.width + 3, type);
+        cvtest::randUni(rng, big, Scalar::all(0), Scalar::all(255));
+        Mat src = big(Rect(Point(1, 1), sz));
+        Mat dst, ref;
+
+        cv::transpose(src, dst);
+        cvtest::transpose(src, ref);
+        EXPECT_EQ(0, cvtest::norm(dst, ref, NORM_INF));
+
+        for (int code = ROTATE_90_CLOCKWISE; code <= ROTATE_90_COUNTERCLOCKWISE; code++)
+        {
+            cv::rotate(src, dst, code);
+            reference::rotate(src, ref, code);
+            EXPECT_EQ(0, cvtest::norm(dst, ref, NORM_INF)) << "rotateCode=" << code;
+        }
+
+        Mat sq = src(Rect(0, 0, std::min(sz.width, sz.height), std::min(sz.width, sz.height)));
+        cvtest::transpose(sq, ref);
+        cv::transpose(sq, sq);
+        EXPECT_EQ(0, cvtest::norm(sq, ref, NORM_INF));
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Arithm, TransposeTiled, testing::Values(
+    perf::MatType(CV_8UC1), CV_8UC2, CV_8UC3, CV_8UC4, CV_16UC1, CV_16UC2, CV_16UC3, CV_16UC4,
+    CV_32FC1, CV_32FC2, CV_32FC3, CV_32FC4, CV_64FC4
+));
+
 class FlipND : public testing::TestWithParam< tuple<std::vector<int>, perf::MatType> >
 {
 public:
@@ -3307,4 +3347,216 @@ TEST_P(Core_LUT, accuracy_multi)
 
 INSTANTIATE_TEST_CASE_P(/**/, Core_LUT, LutMatType::all());
 
+TEST(Core_TransformElementwise, chain_8u)
+{
+    Mat frame(121, 163, CV_8UC3), background(121, 163, CV_8UC3);
+    randu(frame, 0, 256);
+    randu(background, 0, 256);
+
+    Mat dst;
+    transformElementwise(std::vector<Mat>{frame, background}, dst,
+                         ElementwiseOps().scale(0.5).addInput(1, 0.25).add(Scalar(10, 20, 30)).min(200), CV_8U);
+
+    Mat t, ref;
+    frame.convertTo(t, CV_32F, 0.5);
+    Mat bg;
+    background.convertTo(bg, CV_32F);
+    cv::scaleAdd(bg, 0.25, t, t);
+    cv::add(t, Scalar(10, 20, 30), t);
+    cv::min(t, 200, t);
+    t.convertTo(ref, CV_8U);
+    EXPECT_EQ(CV_8UC3, dst.type());
+    EXPECT_LE(cvtest::norm(dst, ref, NORM_INF), 1);
+}
+
+TEST(Core_TransformElementwise, mixed_depths_and_cast)
+{
+    Mat a(64, 97, CV_16UC1), b(64, 97, CV_32FC1);
+    randu(a, 0, 1000);
+    randu(b, 1, 4);
+
+    // cast() saturates intermediate value
+    Mat dst;
+    transformElementwise(std::vector<Mat>{a, b}, dst,
+                         ElementwiseOps().divideInput(1).cast(CV_8U).subtract(Scalar(100)).multiply(Scalar(2)), CV_16S);
+
+    Mat t, ref;
+    a.convertTo(t, CV_32F);
+    cv::divide(t, b, t);
+    t.convertTo(t, CV_8U);
+    t.convertTo(t, CV_32F);
+    t = (t - 100) * 2;
+    t.convertTo(ref, CV_16S);
+    EXPECT_EQ(CV_16SC1, dst.type());
+    EXPECT_EQ(0, cvtest::norm(dst, ref, NORM_INF));
+}
+
+TEST(Core_TransformElementwise, double_precision_and_inplace)
+{
+    Mat a(33, 35, CV_64FC2), b(33, 35, CV_64FC2);
+    randu(a, -10, 10);
+    randu(b, -10, 10);
+    Mat ref;
+    cv::absdiff(a, b, ref);
+    cv::max(ref, 1, ref);
+    cv::divide(2, ref, ref);
+    cv::min(ref, b, ref);
+
+    transformElementwise(std::vector<Mat>{a, b}, a, ElementwiseOps().absdiffInput(1).max(1).reciprocal(2).minInput(1));
+    EXPECT_EQ(CV_64FC2, a.type());
+    EXPECT_LE(cvtest::norm(a, ref, NORM_INF), 1e-12);
+
+    // single input, no operations: conversion with saturation
+    Mat c(16, 16, CV_32FC1);
+    randu(c, -300, 300);
+    Mat d, d_ref;
+    transformElementwise(c, d, ElementwiseOps(), CV_8U);
+    c.convertTo(d_ref, CV_8U);
+    EXPECT_EQ(0, cvtest::norm(d, d_ref, NORM_INF));
+
+    EXPECT_THROW(transformElementwise(std::vector<Mat>{c}, d, ElementwiseOps().addInput(1), CV_8U), cv::Exception);
+}
+
+static void makeRandom16f(Mat& m16, Mat& m32, Size sz, int cn, double a, double b)
+{
+    Mat tmp(sz, CV_MAKETYPE(CV_32F, cn));
+    randu(tmp, a, b);
+    tmp.convertTo(m16, CV_16F);
+    m16.convertTo(m32, CV_32F); // exactly representable values
+}
+
+TEST(Core_Arithm16F, binary_ops)
+{
+    const Size sizes[] = { Size(1, 1), Size(7, 3), Size(33, 17), Size(320, 240) };
+    for (const Size& sz : sizes)
+    for (int cn = 1; cn <= 3; cn++)
+    {
+        SCOPED_TRACE(cv::format("size=%dx%d cn=%d", sz.width, sz.height, cn));
+        Mat a16, a32, b16, b32;
+        makeRandom16f(a16, a32, sz, cn, -100, 100);
+        makeRandom16f(b16, b32, sz, cn, -100, 100);
+
+        // the result of a single 32f operation rounded to 16f must be reproduced exactly
+        for (int op = 0; op < 5; op++)
+        {
+            SCOPED_TRACE(cv::format("op=%d", op));
+            Mat dst16, ref32, ref16;
+            switch (op)
+            {
+            case 0: cv::add(a16, b16, dst16); cv::add(a32, b32, ref32); break;
+            case 1: cv::subtract(a16, b16, dst16); cv::subtract(a32, b32, ref32); break;
+            case 2: cv::min(a16, b16, dst16); cv::min(a32, b32, ref32); break;
+            case 3: cv::max(a16, b16, dst16); cv::max(a32, b32, ref32); break;
+            case 4: cv::absdiff(a16, b16, dst16); cv::absdiff(a32, b32, ref32); break;
+            }
+            ASSERT_EQ(CV_MAKETYPE(CV_16F, cn), dst16.type());
+            ref32.convertTo(ref16, CV_16F);
+            Mat dst32;
+            dst16.convertTo(dst32, CV_32F);
+            ref16.convertTo(ref32, CV_32F);
+            EXPECT_EQ(0, cvtest::norm(dst32, ref32, NORM_INF));
+        }
+
+        Mat dst16, dst32, ref32;
+        cv::multiply(a16, b16, dst16, 0.25);
+        cv::multiply(a32, b32, ref32, 0.25);
+        ASSERT_EQ(CV_MAKETYPE(CV_16F, cn), dst16.type());
+        dst16.convertTo(dst32, CV_32F);
+        EXPECT_LE(cvtest::norm(dst32, ref32, NORM_INF), 1e-3 * cvtest::norm(ref32, NORM_INF));
+
+        cv::addWeighted(a16, 0.3, b16, -1.7, 5.0, dst16);
+        cv::addWeighted(a32, 0.3, b32, -1.7, 5.0, ref32);
+        ASSERT_EQ(CV_MAKETYPE(CV_16F, cn), dst16.type());
+        dst16.convertTo(dst32, CV_32F);
+        EXPECT_LE(cvtest::norm(dst32, ref32, NORM_INF), 1e-3 * cvtest::norm(ref32, NORM_INF));
+    }
+}
+
+TEST(Core_Arithm16F, mask_scalar_and_mixed_types)
+{
+    Mat a16, a32, b16, b32;
+    makeRandom16f(a16, a32, Size(61, 13), 3, -10, 10);
+    makeRandom16f(b16, b32, Size(61, 13), 3, -10, 10);
+    Mat mask(a16.size(), CV_8U);
+    randu(mask, 0, 2);
+
+    Mat dst16 = Mat::zeros(a16.size(), a16.type()), ref32 = Mat::zeros(a32.size(), a32.type()), dst32;
+    cv::add(a16, b16, dst16, mask);
+    cv::add(a32, b32, ref32, mask);
+    dst16.convertTo(dst32, CV_32F);
+    EXPECT_LE(cvtest::norm(dst32, ref32, NORM_INF), 1e-2);
+
+    cv::add(a16, Scalar(0.5, 1, -2), dst16);
+    cv::add(a32, Scalar(0.5, 1, -2), ref32);
+    EXPECT_EQ(a16.type(), dst16.type());
+    dst16.convertTo(dst32, CV_32F);
+    EXPECT_LE(cvtest::norm(dst32, ref32, NORM_INF), 1e-2);
+
+    cv::multiply(a16, Scalar::all(3), dst16);
+    cv::multiply(a32, Scalar::all(3), ref32);
+    dst16.convertTo(dst32, CV_32F);
+    EXPECT_LE(cvtest::norm(dst32, ref32, NORM_INF), 5e-2);
+
+    // 16f and 8u inputs with 32f output are computed in 32f
+    Mat c8u(a16.size(), CV_8UC3), c32;
+    randu(c8u, 0, 255);
+    c8u.convertTo(c32, CV_32F);
+    cv::add(a16, c8u, dst32, noArray(), CV_32F);
+    cv::add(a32, c32, ref32);
+    EXPECT_EQ(CV_32FC3, dst32.type());
+    EXPECT_EQ(0, cvtest::norm(dst32, ref32, NORM_INF));
+}
+
+TEST(Core_Arithm16F, minMaxLoc_and_norm)
+{
+    const Size sizes[] = { Size(5, 1), Size(37, 11), Size(640, 48) };
+    for (const Size& sz : sizes)
+    {
+        SCOPED_TRACE(cv::format("size=%dx%d", sz.width, sz.height));
+        Mat a16, a32, b16, b32;
+        makeRandom16f(a16, a32, sz, 1, -1000, 1000);
+        makeRandom16f(b16, b32, sz, 1, -1000, 1000);
+        Mat mask(sz, CV_8U);
+        randu(mask, 0, 2);
+        mask.at<uchar>(0, 0) = 1;
+
+        for (int useMask = 0; useMask < 2; useMask++)
+        {
+            SCOPED_TRACE(useMask ? "mask" : "no mask");
+            Mat m = useMask ? mask : Mat();
+            double minVal16 = 0, maxVal16 = 0, minVal32 = 0, maxVal32 = 0;
+            Point minLoc16, maxLoc16, minLoc32, maxLoc32;
+            cv::minMaxLoc(a16, &minVal16, &maxVal16, &minLoc16, &maxLoc16, m);
+            cv::minMaxLoc(a32, &minVal32, &maxVal32, &minLoc32, &maxLoc32, m);
+            EXPECT_EQ(minVal32, minVal16);
+            EXPECT_EQ(maxVal32, maxVal16);
+            EXPECT_EQ(minLoc32, minLoc16);
+            EXPECT_EQ(maxLoc32, maxLoc16);
+
+            const int normTypes[] = { NORM_INF, NORM_L1, NORM_L2, NORM_L2SQR };
+            for (int normType : normTypes)
+            {
+                SCOPED_TRACE(cv::format("normType=%d", normType));
+                double n32 = cv::norm(a32, normType, m);
+                EXPECT_NEAR(n32, cv::norm(a16, normType, m), n32 * 1e-5);
+                double d32 = cv::norm(a32, b32, normType, m);
+                EXPECT_NEAR(d32, cv::norm(a16, b16, normType, m), d32 * 1e-5);
+            }
+        }
+    }
+
+    // multichannel, non-continuous input
+    Mat big16, big32;
+    makeRandom16f(big16, big32, Size(100, 50), 3, -1, 1);
+    Rect roi(3, 2, 90, 41);
+    double n32 = cv::norm(big32(roi), NORM_L2);
+    EXPECT_NEAR(n32, cv::norm(big16(roi), NORM_L2), n32 * 1e-5);
+    double minVal = 0, maxVal = 0;
+    cv::minMaxIdx(big16(roi), &minVal, &maxVal);
+    double minRef = 0, maxRef = 0;
+    cv::minMaxIdx(big32(roi), &minRef, &maxRef);
+    EXPECT_EQ(minRef, minVal);
+    EXPECT_EQ(maxRef, maxVal);
+}
+
 }} // namespace
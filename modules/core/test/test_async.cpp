@@ -152,4 +152,108 @@ TEST(Core_Async, AsyncThread_DetachedResult)
 
 #endif
 
+TEST(Core_CpuStream, OrderAndResults)
+{
+    CpuStream stream;
+    Mat acc(4, 4, CV_32SC1, Scalar::all(0));
+    std::vector<AsyncArray> results;
+    for (int i = 0; i < 20; i++)
+    {
+        results.push_back(stream.enqueue([acc, i](OutputArray dst) mutable {
+            // operations of one stream are executed sequentially in order of submission
+            EXPECT_EQ(i * (i - 1) / 2, acc.at<int>(0, 0));
+            acc += Scalar::all(i);
+            acc.copyTo(dst);
+        }));
+    }
+    for (int i = 0; i < 20; i++)
+    {
+        Mat r;
+        results[i].get(r);
+        ASSERT_EQ(CV_32SC1, r.type());
+        EXPECT_EQ(i * (i + 1) / 2, r.at<int>(3, 3));
+    }
+    stream.waitForCompletion();
+    EXPECT_TRUE(stream.queryIfComplete());
+}
+
+TEST(Core_CpuStream, Exception)
+{
+    CpuStream stream;
+    AsyncArray r1 = stream.enqueue([](OutputArray) {
+        CV_Error(Error::StsBadArg, "Test: operation failure");
+    });
+    AsyncArray r2 = stream.enqueue([](OutputArray dst) {
+        Mat(Mat::eye(2, 2, CV_8U)).copyTo(dst);
+    });
+    // result of an operation may be ignored
+    stream.enqueue([](OutputArray dst) { Mat(Mat::ones(2, 2, CV_8U)).copyTo(dst); });
+
+    Mat m;
+    try
+    {
+        r1.get(m);
+        FAIL() << "Exception is expected";
+    }
+    catch (const cv::Exception& e)
+    {
+        EXPECT_EQ(Error::StsBadArg, e.code);
+    }
+    // the stream proceeds after a failed operation
+    r2.get(m);
+    EXPECT_EQ(0, cvtest::norm(m, Mat::eye(2, 2, CV_8U), NORM_INF));
+    stream.waitForCompletion();
+}
+
+#if !defined(OPENCV_DISABLE_THREAD_SUPPORT)
+
+TEST(Core_CpuStream, EventDependency)
+{
+    CpuStream producer, consumer;
+    CpuEvent ready;
+    EXPECT_TRUE(ready.queryIfComplete()); // nothing is recorded
+
+    Mat frame;
+    producer.enqueue([&frame](OutputArray) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        frame = Mat(16, 16, CV_8UC1, Scalar::all(7));
+    });
+    ready.record(producer);
+
+    consumer.waitEvent(ready);
+    AsyncArray r = consumer.enqueue([&frame](OutputArray dst) {
+        ASSERT_FALSE(frame.empty());
+        cv::add(frame, Scalar::all(1), dst);
+    });
+    EXPECT_FALSE(consumer.queryIfComplete());
+
+    Mat m;
+    r.get(m);
+    EXPECT_EQ(0, cvtest::norm(m, Mat(16, 16, CV_8UC1, Scalar::all(8)), NORM_INF));
+    EXPECT_TRUE(ready.queryIfComplete());
+    ready.waitForCompletion();
+}
+
+TEST(Core_CpuStream, ConcurrentStreams)
+{
+    const int N = 4;
+    std::vector<CpuStream> streams(N);
+    std::vector<AsyncArray> results;
+    for (int k = 0; k < 3; k++)
+        for (int i = 0; i < N; i++)
+            results.push_back(streams[i].enqueue([i, k](OutputArray dst) {
+                Mat src(64, 64, CV_32FC1, Scalar::all(i + k));
+                cv::multiply(src, src, dst);
+            }));
+    for (int k = 0; k < 3; k++)
+        for (int i = 0; i < N; i++)
+        {
+            Mat m;
+            results[k * N + i].get(m);
+            EXPECT_EQ((float)((i + k) * (i + k)), m.at<float>(10, 10));
+        }
+}
+
+#endif
+
 }} // namespace
@@ -983,4 +983,106 @@ protected:
 TEST(Core_DFT, reverse) { Core_DXTReverseTest test(Core_DXTReverseTest::ModeDFT); test.safe_run(); }
 TEST(Core_DCT, reverse) { Core_DXTReverseTest test(Core_DXTReverseTest::ModeDCT); test.safe_run(); }
 
+TEST(Core_DFT, blocked_parallel)
+{
+    const int prevThreads = cv::getNumThreads();
+    cv::setNumThreads(4);
+    const Size sizes[] = { Size(127, 131), Size(64, 200), Size(1, 97), Size(300, 4) };
+    const int flags[] = { 0, DFT_INVERSE, DFT_ROWS };
+    for (int depth = CV_32F; depth <= CV_64F; depth++)
+    {
+        const double eps = depth == CV_32F ? 1e-5 : 1e-12;
+        for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++)
+        {
+            SCOPED_TRACE(cv::format("depth=%d size=%dx%d", depth, sizes[i].width, sizes[i].height));
+            Mat src(sizes[i], CV_MAKETYPE(depth, 2)), dst, ref;
+            randu(src, -1., 1.);
+            for (size_t j = 0; j < sizeof(flags)/sizeof(flags[0]); j++)
+            {
+                cv::dft(src, dst, flags[j]);
+                DFT_2D(src, ref, flags[j]);
+                EXPECT_LE(cvtest::norm(dst, ref, NORM_L2 | NORM_RELATIVE), eps) << "flags=" << flags[j];
+            }
+
+            Mat re(sizes[i], depth), planes[] = { re, Mat::zeros(sizes[i], depth) }, spec, back;
+            randu(re, -1., 1.);
+            merge(planes, 2, src);
+            cv::dft(re, spec, DFT_COMPLEX_OUTPUT);
+            DFT_2D(src, ref, 0);
+            EXPECT_LE(cvtest::norm(spec, ref, NORM_L2 | NORM_RELATIVE), eps);
+            cv::dft(spec, back, DFT_INVERSE | DFT_SCALE | DFT_REAL_OUTPUT);
+            EXPECT_LE(cvtest::norm(back, re, NORM_L2 | NORM_RELATIVE), eps);
+        }
+    }
+    cv::setNumThreads(prevThreads);
+}
+
+TEST(Core_DFT, plan)
+{
+    const Size sizes[] = { Size(64, 64), Size(45, 30), Size(1, 50), Size(81, 1) };
+    const int types[] = { CV_32FC1, CV_32FC2, CV_64FC1, CV_64FC2 };
+    const int flags[] = { 0, DFT_COMPLEX_OUTPUT, DFT_INVERSE | DFT_SCALE, DFT_ROWS, DFT_ROWS | DFT_COMPLEX_OUTPUT };
+    for (size_t i = 0; i < sizeof(sizes)/sizeof(sizes[0]); i++)
+    for (size_t t = 0; t < sizeof(types)/sizeof(types[0]); t++)
+    for (size_t j = 0; j < sizeof(flags)/sizeof(flags[0]); j++)
+    {
+        SCOPED_TRACE(cv::format("size=%dx%d type=%d flags=%d", sizes[i].width, sizes[i].height, types[t], flags[j]));
+        Mat big(sizes[i].height + 4, sizes[i].width + 3, types[t]);
+        randu(big, -1., 1.);
+        Mat src = big(Rect(Point(1, 2), sizes[i]));
+        Mat srcCont = src.clone();
+
+        DFTPlan plan(sizes[i], types[t], flags[j]);
+        ASSERT_FALSE(plan.empty());
+        EXPECT_EQ(sizes[i], plan.size());
+        EXPECT_EQ(types[t], plan.type());
+        EXPECT_EQ(flags[j], plan.flags());
+
+        Mat ref, dst;
+        cv::dft(srcCont, ref, flags[j]);
+        for (int iter = 0; iter < 2; iter++)
+        {
+            plan.execute(srcCont, dst);
+            EXPECT_EQ(0, cvtest::norm(dst, ref, NORM_INF));
+        }
+        // ROI input uses a separately created context
+        plan.execute(src, dst);
+        EXPECT_LE(cvtest::norm(dst, ref, NORM_INF), 1e-5 * cvtest::norm(ref, NORM_INF));
+
+        if (ref.type() == types[t])
+        {
+            Mat inplace = srcCont.clone();
+            plan.execute(inplace, inplace);
+            EXPECT_LE(cvtest::norm(inplace, ref, NORM_INF), 1e-5 * cvtest::norm(ref, NORM_INF));
+        }
+    }
+
+    EXPECT_TRUE(DFTPlan().empty());
+    EXPECT_ANY_THROW(DFTPlan(Size(8, 8), CV_8UC1));
+    DFTPlan plan(Size(16, 16), CV_32FC2);
+    Mat wrong(Size(16, 8), CV_32FC2, Scalar::all(0)), dst;
+    EXPECT_ANY_THROW(plan.execute(wrong, dst));
+}
+
+TEST(Core_DFT, plan_concurrent)
+{
+    const Size sz(96, 80);
+    const int N = 16;
+    DFTPlan plan(sz, CV_32FC1, DFT_COMPLEX_OUTPUT);
+    std::vector<Mat> src(N), dst(N), ref(N);
+    for (int i = 0; i < N; i++)
+    {
+        src[i].create(sz, CV_32FC1);
+        randu(src[i], -1., 1.);
+        cv::dft(src[i], ref[i], DFT_COMPLEX_OUTPUT);
+    }
+    parallel_for_(Range(0, N), [&](const Range& r)
+    {
+        for (int i = r.start; i < r.end; i++)
+            plan.execute(src[i], dst[i]);
+    });
+    for (int i = 0; i < N; i++)
+        EXPECT_EQ(0, cvtest::norm(dst[i], ref[i], NORM_INF)) << "i=" << i;
+}
+
 }} // namespace
@@ -2003,4 +2003,129 @@ TEST(Core_InputOutput, FileStorage_invalid_attribute_value_regression_25946)
     ASSERT_EQ(0, std::remove(fileName.c_str()));
 }
 
+TEST(Core_InputOutput, filestorage_mapped_data)
+{
+    const char* suffixes[] = { ".xml", ".yml", ".json" };
+    for (size_t i = 0; i < sizeof(suffixes)/sizeof(suffixes[0]); i++)
+    {
+        SCOPED_TRACE(suffixes[i]);
+        const std::string fileName = cv::tempfile(suffixes[i]);
+        const std::string dataFileName = fileName + ".bin";
+
+        Mat big(512, 512, CV_32FC1), big3d, small(3, 3, CV_8UC1);
+        randu(big, -1, 1);
+        randu(small, 0, 255);
+        const int sizes[] = { 4, 32, 64 };
+        big3d.create(3, sizes, CV_16SC2);
+        randu(big3d, -1000, 1000);
+        {
+            FileStorage fs(fileName, FileStorage::WRITE | FileStorage::MAPPED_DATA);
+            fs << "big" << big;
+            fs << "small" << small;
+            fs << "big_roi" << big(Rect(10, 20, 100, 200));
+            fs << "big3d" << big3d;
+            fs.release();
+        }
+
+        Mat big_r, small_r, roi_r, big3d_r;
+        {
+            FileStorage fs(fileName, FileStorage::READ);
+            ASSERT_TRUE(fs.isOpened());
+            EXPECT_FALSE(fs["big"]["data_offset"].empty());
+            EXPECT_TRUE(fs["small"]["data_offset"].empty());
+            fs["big"] >> big_r;
+            fs["small"] >> small_r;
+            fs["big_roi"] >> roi_r;
+            fs["big3d"] >> big3d_r;
+        }  // mapped matrices outlive FileStorage
+
+        EXPECT_EQ(0, cvtest::norm(big, big_r, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(small, small_r, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(big(Rect(10, 20, 100, 200)), roi_r, NORM_INF));
+        EXPECT_EQ(0, cvtest::norm(big3d, big3d_r, NORM_INF));
+
+        // mapping is private: modification of the matrix doesn't change the file
+        big_r.setTo(Scalar::all(0));
+        {
+            FileStorage fs(fileName, FileStorage::READ);
+            Mat m;
+            fs["big"] >> m;
+            EXPECT_EQ(0, cvtest::norm(big, m, NORM_INF));
+        }
+
+        EXPECT_EQ(0, remove(fileName.c_str()));
+        EXPECT_EQ(0, remove(dataFileName.c_str()));
+    }
+}
+
+TEST(Core_InputOutput, filestorage_read_streaming)
+{
+    const char* suffixes[] = { ".xml", ".yml", ".json" };
+    const int N = 1000;
+    for (size_t i = 0; i < sizeof(suffixes)/sizeof(suffixes[0]); i++)
+    {
+        SCOPED_TRACE(suffixes[i]);
+        std::string content;
+        {
+            FileStorage fs(suffixes[i], FileStorage::WRITE | FileStorage::MEMORY);
+            fs << "version" << 3;
+            fs << "annotations" << "[";
+            for (int k = 0; k < N; k++)
+            {
+                fs << "{" << "id" << k << "bbox" << Mat(Matx14d(k, k + 1, 10, 20)) << "label" << cv::format("obj%d", k) << "}";
+            }
+            fs << "]";
+            fs << "tail" << "end";
+            content = fs.releaseAndGetString();
+        }
+        const int flags = FileStorage::READ | FileStorage::MEMORY;
+
+        // top-level nodes
+        std::vector<std::string> names;
+        EXPECT_TRUE(FileStorage::readStreaming(content, [&](const FileNode& node, const FileNode& parent) {
+            EXPECT_TRUE(parent.isMap());
+            names.push_back(node.name());
+            if (node.name() == "annotations")
+                EXPECT_EQ((size_t)N, node.size());
+            return true;
+        }, 1, flags));
+        ASSERT_EQ(3u, names.size());
+        EXPECT_EQ("version", names[0]);
+        EXPECT_EQ("annotations", names[1]);
+        EXPECT_EQ("tail", names[2]);
+
+        // elements of top-level sequence
+        int count = 0, version = 0;
+        std::string tail;
+        EXPECT_TRUE(FileStorage::readStreaming(content, [&](const FileNode& node, const FileNode& parent) {
+            if (node.isNamed() && node.name() == "version")
+                version = (int)node;
+            else if (node.isNamed() && node.name() == "tail")
+                tail = (std::string)node;
+            else
+            {
+                EXPECT_EQ("annotations", parent.name());
+                EXPECT_EQ(count, (int)node["id"]);
+                EXPECT_EQ(cv::format("obj%d", count), (std::string)node["label"]);
+                Mat bbox = node["bbox"].mat();
+                EXPECT_EQ(0, cvtest::norm(bbox, Mat(Matx14d(count, count + 1, 10, 20)), NORM_INF));
+                count++;
+            }
+            return true;
+        }, 2, flags));
+        EXPECT_EQ(3, version);
+        EXPECT_EQ(N, count);
+        EXPECT_EQ("end", tail);
+
+        // stop by callback
+        count = 0;
+        EXPECT_FALSE(FileStorage::readStreaming(content, [&](const FileNode&, const FileNode& parent) {
+            if (parent.isNamed() && parent.name() == "annotations")
+                count++;
+            return count < 10;
+        }, 2, flags));
+        EXPECT_EQ(10, count);
+    }
+}
+
 }} // namespace
@@ -2244,6 +2244,82 @@ TEST(Core_MatExpr, issue_16689)
     }
 }
 
+typedef testing::TestWithParam< tuple<perf::MatType, bool> > Core_MatExpr_Fused;
+
+TEST_P(Core_MatExpr_Fused, accuracy)
+{
+    const int type = get<0>(GetParam());
+    const bool useRoi = get<1>(GetParam());
+    const double eps = CV_MAT_DEPTH(type) == CV_32F ? 1e-5 : 1e-12;
+    RNG& rng = theRNG();
+    Mat a0(67, 103, type), b0(67, 103, type), c0(67, 103, type);
+    rng.fill(a0, RNG::UNIFORM, -10, 10);
+    rng.fill(b0, RNG::UNIFORM, -10, 10);
+    rng.fill(c0, RNG::UNIFORM, 1, 10);
+    Rect roi = useRoi ? Rect(3, 2, 97, 61) : Rect(0, 0, a0.cols, a0.rows);
+    Mat a = a0(roi), b = b0(roi), c = c0(roi);
+    Mat t1, t2, ref;
+
+    // abs(a - b) * 0.5 + c
+    cv::absdiff(a, b, t1);
+    cv::scaleAdd(t1, 0.5, c, ref);
+    EXPECT_LE(cvtest::norm(Mat(abs(a - b) * 0.5 + c), ref, NORM_INF), eps);
+
+    // (a + b).mul(c) / (c*2 + 1)
+    cv::add(a, b, t1);
+    cv::multiply(t1, c, t1);
+    c.convertTo(t2, -1, 2, 1);
+    cv::divide(t1, t2, ref);
+    EXPECT_LE(cvtest::norm(Mat((a + b).mul(c) / (c*2 + 1)), ref, NORM_INF), eps);
+
+    // 3 - min(a, b) * max(c, 5) + Scalar
+    cv::min(a, b, t1);
+    cv::max(c, 5, t2);
+    cv::multiply(t1, t2, t1);
+    cv::subtract(Scalar(3), t1, t1);  // Scalar(3) == (3, 0, 0, 0)
+    cv::add(t1, Scalar(1, 2, 3, 4), ref);
+    EXPECT_LE(cvtest::norm(Mat(3 - cv::min(a, b).mul(cv::max(c, 5)) + Scalar(1, 2, 3, 4)), ref, NORM_INF), eps);
+
+    // 1/(a*a + b*b + 1) - a.mul(b)*0.25
+    cv::multiply(a, a, t1);
+    cv::multiply(b, b, t2);
+    cv::add(t1, t2, t1);
+    cv::add(t1, Scalar(1), t1);
+    cv::divide(1, t1, t1);
+    cv::multiply(a, b, t2, 0.25);
+    cv::subtract(t1, t2, ref);
+    EXPECT_LE(cvtest::norm(Mat(1/(a.mul(a) + b.mul(b) + 1) - a.mul(b)*0.25), ref, NORM_INF), eps);
+
+    // sub-expressions, conversion and in-place assignment
+    MatExpr e = abs(a - b) * 0.5 + c;
+    cv::absdiff(a, b, t1);
+    cv::scaleAdd(t1, 0.5, c, ref);
+    EXPECT_EQ(a.size(), e.size());
+    EXPECT_EQ(type, e.type());
+    EXPECT_LE(cvtest::norm(Mat(e(Rect(1, 2, 30, 40))), ref(Rect(1, 2, 30, 40)), NORM_INF), eps);
+    Mat e_32s;
+    e.op->assign(e, e_32s, CV_MAKETYPE(CV_32S, a.channels()));
+    Mat ref_32s;
+    ref.convertTo(ref_32s, CV_32S);
+    EXPECT_EQ(0, cvtest::norm(e_32s, ref_32s, NORM_INF));
+    Mat d = a.clone();
+    d = abs(d - b) * 0.5 + c;
+    EXPECT_LE(cvtest::norm(d, ref, NORM_INF), eps);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_MatExpr_Fused, testing::Combine(
+    testing::Values(perf::MatType(CV_32FC1), CV_32FC3, CV_64FC1, CV_64FC4),
+    testing::Bool()
+));
+
+TEST(Core_MatExpr, fused_integer_types_saturation)
+{
+    // saturation of intermediate results is preserved
+    Mat a(4, 4, CV_8UC1, Scalar::all(10)), b(4, 4, CV_8UC1, Scalar::all(20)), c(4, 4, CV_8UC1, Scalar::all(5));
+    Mat r = (a - b) * 2 + c;
+    EXPECT_EQ(0, cvtest::norm(r, Mat(4, 4, CV_8UC1, Scalar::all(5)), NORM_INF));
+}
+
 #ifdef HAVE_EIGEN
 TEST(Core_Eigen, eigen2cv_check_Mat_type)
 {
@@ -2949,6 +2949,100 @@ TEST(Core_KMeans, compactness)
     }
 }
 
+// The labels returned after 3 iterations come from the pruned assignment step,
+// they must be the labels of the nearest centers found by brute force.
+TEST(Core_KMeans, pruned_assignment)
+{
+    const int K = 7;
+    const int N = 70000; // several chunks of the parallel centers update
+    const int dims_list[] = { 3, 20 };
+    RNG& rng = theRNG();
+    for (size_t d = 0; d < sizeof(dims_list)/sizeof(dims_list[0]); d++)
+    {
+        const int dims = dims_list[d];
+        SCOPED_TRACE(cv::format("dims=%d", dims));
+        Mat blobs(K, dims, CV_32F), data(N, dims, CV_32F), labels(N, 1, CV_32S);
+        rng.fill(blobs, RNG::UNIFORM, -10, 10);
+        rng.fill(data, RNG::NORMAL, 0, 3);
+        for (int i = 0; i < N; i++)
+        {
+            int k = rng.uniform(0, K);
+            cv::add(data.row(i), blobs.row(k), data.row(i));
+            labels.at<int>(i) = rng.uniform(0, 5) == 0 ? rng.uniform(0, K) : k;
+        }
+
+        // reference: means and brute-force assignments in double precision
+        Mat ref = labels.clone(), refCenters;
+        for (int iter = 0; iter < 3; iter++)
+        {
+            Mat sums(K, dims, CV_64F, Scalar(0));
+            std::vector<int> counts(K, 0);
+            for (int i = 0; i < N; i++)
+            {
+                int k = ref.at<int>(i);
+                for (int j = 0; j < dims; j++)
+                    sums.at<double>(k, j) += data.at<float>(i, j);
+                counts[k]++;
+            }
+            for (int k = 0; k < K; k++)
+            {
+                ASSERT_GT(counts[k], 0);
+                for (int j = 0; j < dims; j++)
+                    sums.at<double>(k, j) /= counts[k];
+            }
+            sums.convertTo(refCenters, CV_32F);
+            if (iter == 2)
+                break;
+            for (int i = 0; i < N; i++)
+            {
+                double best = DBL_MAX;
+                for (int k = 0; k < K; k++)
+                {
+                    double dist = cvtest::norm(data.row(i), refCenters.row(k), NORM_L2SQR);
+                    if (dist < best)
+                    {
+                        best = dist;
+                        ref.at<int>(i) = k;
+                    }
+                }
+            }
+        }
+
+        Mat centers;
+        kmeans(data, K, labels, TermCriteria(TermCriteria::COUNT, 3, 0), 1, KMEANS_USE_INITIAL_LABELS, centers);
+        // the reference centers are computed in double precision, this may move a few
+        // samples lying on the cluster boundaries
+        EXPECT_LE(countNonZero(labels != ref), 10);
+        EXPECT_LE(cvtest::norm(centers, refCenters, NORM_INF), 1e-3);
+    }
+}
+
+TEST(Core_KMeans, mini_batch)
+{
+    const int K = 5;
+    const int N = 20000;
+    const int dims = 2;
+    RNG& rng = theRNG();
+    Mat blobs(K, dims, CV_32F), data(N, dims, CV_32F);
+    rng.fill(blobs, RNG::UNIFORM, -100, 100);
+    rng.fill(data, RNG::NORMAL, 0, 1);
+    for (int i = 0; i < N; i++)
+        cv::add(data.row(i), blobs.row(rng.uniform(0, K)), data.row(i));
+
+    const TermCriteria crit(TermCriteria::COUNT + TermCriteria::EPS, 100, 0.01);
+    Mat labels, centers, labels0, centers0;
+    double compactness0 = kmeans(data, K, labels0, crit, 3, KMEANS_PP_CENTERS, centers0);
+    double compactness = kmeans(data, K, labels, crit, 3, KMEANS_PP_CENTERS | KMEANS_MINI_BATCH, centers);
+    ASSERT_EQ(N, labels.rows);
+    ASSERT_EQ(K, centers.rows);
+    EXPECT_LE(compactness, compactness0 * 1.05);
+
+    double expected = 0;
+    for (int i = 0; i < N; i++)
+        expected += cvtest::norm(data.row(i), centers.row(labels.at<int>(i)), NORM_L2SQR);
+    EXPECT_NEAR(expected, compactness, expected * 1e-6);
+}
+
 TEST(Core_KMeans, bad_input)
 {
     const int N = 100;
@@ -3228,6 +3322,141 @@ TEST(Core_Solve, Matx_4_4)
     EXPECT_LE(cvtest::norm(iA*A, Matx<float, 4, 4>::eye(), NORM_L2), 1e-3);
 }
 
+typedef testing::TestWithParam< tuple<MatType, int> > Core_Batched;
+
+static Mat batchElement(const Mat& m, int i)
+{
+    return Mat(m.size[1], m.size[2], m.type(), (void*)m.ptr(i), m.step[1]);
+}
+
+static Mat randomBatch(int N, int rows, int cols, int type, RNG& rng, double diag = 0)
+{
+    const int sizes[] = { N, rows, cols };
+    Mat m(3, sizes, type);
+    rng.fill(m, RNG::UNIFORM, -1, 1);
+    for (int i = 0; i < N && diag != 0; i++)
+    {
+        Mat mi = batchElement(m, i);
+        mi += Mat::eye(rows, cols, type) * diag;
+    }
+    return m;
+}
+
+TEST_P(Core_Batched, gemm)
+{
+    const int type = get<0>(GetParam()), n = get<1>(GetParam());
+    const double eps = type == CV_32F ? 1e-5 : 1e-12;
+    const int N = 37;
+    RNG& rng = theRNG();
+
+    Mat A = randomBatch(N, n, n + 1, type, rng);
+    Mat B = randomBatch(N, n, n + 1, type, rng);
+    Mat C = randomBatch(N, n, n, type, rng);
+    Mat B2 = randomBatch(1, n + 1, 2, type, rng).reshape(1, n + 1);  // the same for all matrices
+    Mat D, D2;
+    cv::gemmBatched(A, B, 0.5, C, 2, D, GEMM_2_T);
+    cv::gemmBatched(A, B2, 1, noArray(), 0, D2);
+    ASSERT_EQ(3, D.dims);
+    ASSERT_EQ(N, D.size[0]);
+
+    for (int i = 0; i < N; i++)
+    {
+        Mat ref, ref2;
+        cv::gemm(batchElement(A, i), batchElement(B, i), 0.5, batchElement(C, i), 2, ref, GEMM_2_T);
+        cv::gemm(batchElement(A, i), B2, 1, noArray(), 0, ref2);
+        EXPECT_LE(cvtest::norm(batchElement(D, i), ref, NORM_INF), eps * n) << i;
+        EXPECT_LE(cvtest::norm(batchElement(D2, i), ref2, NORM_INF), eps * n) << i;
+    }
+}
+
+TEST_P(Core_Batched, solve)
+{
+    const int type = get<0>(GetParam()), n = get<1>(GetParam());
+    const double eps = type == CV_32F ? 1e-4 : 1e-10;
+    const int N = 37, singularIdx = 5;
+    RNG& rng = theRNG();
+
+    Mat A = randomBatch(N, n, n, type, rng, n);
+    Mat B = randomBatch(N, n, 2, type, rng);
+    batchElement(A, singularIdx) = Scalar::all(0);
+    Mat X, status;
+    EXPECT_FALSE(cv::solveBatched(A, B, X, DECOMP_LU, status));
+    ASSERT_EQ(N, (int)status.total());
+
+    for (int i = 0; i < N; i++)
+    {
+        if (i == singularIdx)
+        {
+            EXPECT_EQ(0, status.at<uchar>(i));
+            EXPECT_EQ(0, cvtest::norm(batchElement(X, i), NORM_INF));
+            continue;
+        }
+        Mat ref;
+        EXPECT_NE(0, status.at<uchar>(i)) << i;
+        EXPECT_TRUE(cv::solve(batchElement(A, i), batchElement(B, i), ref, DECOMP_LU));
+        EXPECT_LE(cvtest::norm(batchElement(X, i), ref, NORM_INF), eps) << i;
+    }
+
+    // other methods are computed for each system
+    Mat X_svd;
+    batchElement(A, singularIdx) += Mat::eye(n, n, type);
+    EXPECT_TRUE(cv::solveBatched(A, B, X_svd, DECOMP_SVD));
+    for (int i = 0; i < N; i++)
+    {
+        if (i != singularIdx)
+            EXPECT_LE(cvtest::norm(batchElement(X_svd, i), batchElement(X, i), NORM_INF), eps) << i;
+    }
+}
+
+TEST_P(Core_Batched, invert)
+{
+    const int type = get<0>(GetParam()), n = get<1>(GetParam());
+    const double eps = type == CV_32F ? 1e-4 : 1e-10;
+    const int N = 37;
+    RNG& rng = theRNG();
+
+    Mat A = randomBatch(N, n, n, type, rng, n);
+    Mat Ainv, Ainv2 = A.clone();
+    EXPECT_TRUE(cv::invertBatched(A, Ainv));
+    EXPECT_TRUE(cv::invertBatched(Ainv2, Ainv2));  // in-place
+    EXPECT_EQ(0, cvtest::norm(Ainv, Ainv2, NORM_INF));
+
+    for (int i = 0; i < N; i++)
+    {
+        Mat ref;
+        cv::invert(batchElement(A, i), ref, DECOMP_LU);
+        EXPECT_LE(cvtest::norm(batchElement(Ainv, i), ref, NORM_INF), eps) << i;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_Batched, testing::Combine(
+    testing::Values(CV_32FC1, CV_64FC1),
+    testing::Values(2, 3, 4, 6, 12)  // 12 is not vectorized
+));
+
+TEST(Core_BatchedMatx, solve_invert)
+{
+    RNG& rng = theRNG();
+    std::vector<Matx33d> A(100), Ainv;
+    std::vector< Matx<double, 3, 1> > b_(A.size()), x_;
+    for (size_t i = 0; i < A.size(); i++)
+    {
+        rng.fill(A[i], RNG::UNIFORM, -1, 1);
+        A[i] += Matx33d::eye() * 3;
+        rng.fill(b_[i], RNG::UNIFORM, -1, 1);
+    }
+    EXPECT_TRUE(cv::invertBatched(A, Ainv));
+    EXPECT_TRUE(cv::solveBatched(A, b_, x_));
+    std::vector<Matx33d> I;
+    cv::gemmBatched(A, Ainv, I);
+    ASSERT_EQ(A.size(), I.size());
+    for (size_t i = 0; i < A.size(); i++)
+    {
+        EXPECT_LE(cvtest::norm(I[i], Matx33d::eye(), NORM_INF), 1e-12) << i;
+        EXPECT_LE(cvtest::norm(A[i] * x_[i], b_[i], NORM_INF), 1e-12) << i;
+    }
+}
+
 softdouble naiveExp(softdouble x)
 {
     int exponent = x.getExp();
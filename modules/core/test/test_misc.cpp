@@ -7,6 +7,7 @@
 #include "opencv2/core/utils/logger.hpp"
 
 #include <opencv2/core/utils/fp_control_utils.hpp>
+#include <opencv2/core/parallel/parallel_backend.hpp>
 
 #include <chrono>
 #include <thread>
@@ -304,6 +305,75 @@ TEST(Core_Parallel, propagate_fp_denormals_ignore_hint)
     }
 }
 
+class WorkStealingBackendScope
+{
+public:
+    WorkStealingBackendScope()
+    {
+        isAvailable = cv::parallel::setParallelForBackend("WORKSTEALING");
+    }
+    ~WorkStealingBackendScope()
+    {
+        cv::parallel::setParallelForBackend("");  // restore default backend
+    }
+    bool isAvailable;
+};
+
+class NestedParallelLoopBody : public cv::ParallelLoopBody
+{
+public:
+    NestedParallelLoopBody(cv::Mat& dst) : dst_(dst) {}
+    void operator()(const cv::Range& r) const CV_OVERRIDE
+    {
+        for (int i = r.start; i < r.end; i++)
+        {
+            Mat row = dst_.row(i);
+            parallel_for_(cv::Range(0, row.cols), [&](const cv::Range& c)
+            {
+                for (int j = c.start; j < c.end; j++)
+                    row.at<int>(j) += i + j;
+            }, 8);
+        }
+    }
+protected:
+    Mat dst_;
+};
+
+TEST(Core_Parallel, workstealing_backend_nested)
+{
+    WorkStealingBackendScope scope;
+    if (!scope.isAvailable)
+        throw SkipTestException("Work-stealing parallel backend is not available");
+    EXPECT_STREQ("workstealing", cv::currentParallelFramework());
+
+    for (int iter = 0; iter < 10; iter++)
+    {
+        Mat dst(64, 1000, CV_32SC1, Scalar::all(0));
+        ASSERT_NO_THROW(parallel_for_(cv::Range(0, dst.rows), NestedParallelLoopBody(dst)));
+        for (int i = 0; i < dst.rows; i++)
+            for (int j = 0; j < dst.cols; j++)
+                ASSERT_EQ(i + j, dst.at<int>(i, j)) << "iter=" << iter << " i=" << i << " j=" << j;
+    }
+}
+
+TEST(Core_Parallel, workstealing_backend_propagate_exceptions)
+{
+    WorkStealingBackendScope scope;
+    if (!scope.isAvailable)
+        throw SkipTestException("Work-stealing parallel backend is not available");
+
+    Mat dst1(1000, 100, CV_8SC1, Scalar::all(0));
+    ASSERT_NO_THROW({
+        parallel_for_(cv::Range(0, dst1.rows), ThrowErrorParallelLoopBody(dst1, -1));
+    });
+    EXPECT_EQ(0, cvtest::norm(dst1, Mat(dst1.size(), dst1.type(), Scalar::all(1)), NORM_INF));
+
+    Mat dst2(1000, 100, CV_8SC1, Scalar::all(0));
+    ASSERT_THROW({
+        parallel_for_(cv::Range(0, dst2.rows), ThrowErrorParallelLoopBody(dst2, dst2.rows / 2));
+    }, cv::Exception);
+}
+
 TEST(Core_Version, consistency)
 {
     // this test verifies that OpenCV version loaded in runtime
@@ -9,6 +9,7 @@
 #include "opencv2/core/utils/buffer_area.private.hpp"
 
 #include "opencv2/core/utils/filesystem.private.hpp"
+#include "opencv2/core/utils/metrics.hpp"
 
 #ifndef OPENCV_DISABLE_THREAD_SUPPORT
 #include "test_utils_tls.impl.hpp"
@@ -494,5 +495,60 @@ TEST_P(BufferArea, bad)
 
 INSTANTIATE_TEST_CASE_P(/**/, BufferArea, testing::Values(true, false));
 
+static const utils::metrics::FunctionMetrics* findFunctionMetrics(const std::vector<utils::metrics::FunctionMetrics>& snapshot, const std::string& name)
+{
+    for (size_t i = 0; i < snapshot.size(); i++)
+        if (snapshot[i].name.find(name) != std::string::npos)
+            return &snapshot[i];
+    return NULL;
+}
+
+TEST(Core_Metrics, calls_and_sampling)
+{
+    const bool prevEnabled = utils::metrics::isEnabled();
+    const int prevPeriod = utils::metrics::getSamplingPeriod();
+    utils::metrics::setEnabled(true);
+    utils::metrics::setSamplingPeriod(4);
+    utils::metrics::reset();
+
+    Mat src(64, 32, CV_8UC1, Scalar(1)), dst;
+    for (int i = 0; i < 10; i++)
+        cv::transpose(src, dst);
+
+    std::vector<utils::metrics::FunctionMetrics> snapshot;
+    utils::metrics::getSnapshot(snapshot, true);
+    utils::metrics::setEnabled(prevEnabled);
+    utils::metrics::setSamplingPeriod(prevPeriod);
+    if (snapshot.empty())
+        throw SkipTestException("Metrics are not available (trace is disabled)");
+
+    const utils::metrics::FunctionMetrics* m = findFunctionMetrics(snapshot, "cv::transpose");
+    ASSERT_TRUE(m != NULL);
+    EXPECT_EQ(10, m->calls);
+    EXPECT_EQ(3, m->sampledCalls);  // calls 0, 4, 8
+    EXPECT_GE(m->totalMs, 0.0);
+    EXPECT_LE(m->p50Ms, m->p99Ms);
+    EXPECT_LE(m->p99Ms, m->maxMs);
+
+    // reset by snapshot
+    utils::metrics::getSnapshot(snapshot);
+    EXPECT_TRUE(findFunctionMetrics(snapshot, "cv::transpose") == NULL);
+}
+
+TEST(Core_Metrics, disabled)
+{
+    const bool prevEnabled = utils::metrics::isEnabled();
+    utils::metrics::setEnabled(false);
+    utils::metrics::reset();
+
+    Mat src(64, 32, CV_8UC1, Scalar(1)), dst;
+    cv::transpose(src, dst);
+
+    std::vector<utils::metrics::FunctionMetrics> snapshot;
+    utils::metrics::getSnapshot(snapshot);
+    utils::metrics::setEnabled(prevEnabled);
+    EXPECT_TRUE(findFunctionMetrics(snapshot, "cv::transpose") == NULL);
+}
+
 
 }} // namespace
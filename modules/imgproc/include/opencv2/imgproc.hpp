@@ -1511,8 +1511,8 @@ In-place operation is supported.
 
 @note The median filter uses #BORDER_REPLICATE internally to cope with border pixels, see #BorderTypes
 
-@param src input 1-, 3-, or 4-channel image; when ksize is 3 or 5, the image depth should be
-CV_8U, CV_16U, or CV_32F, for larger aperture sizes, it can only be CV_8U.
+@param src input 1-, 3-, or 4-channel image; the image depth should be CV_8U, CV_16U, CV_16S or CV_32F.
+For CV_32F images with aperture sizes larger than 5 the aperture size must not exceed 255.
 @param dst destination array of the same size and type as src.
 @param ksize aperture linear size; it must be odd and greater than 1, for example: 3, 5, 7 ...
 @sa  bilateralFilter, blur, boxFilter, GaussianBlur
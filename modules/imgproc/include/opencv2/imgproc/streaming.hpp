@@ -0,0 +1,145 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_IMGPROC_STREAMING_HPP
+#define OPENCV_IMGPROC_STREAMING_HPP
+
+#include "opencv2/imgproc.hpp"
+
+#include <functional>
+
+namespace cv {
+
+/** @defgroup imgproc_streaming Row-streaming Filters
+@ingroup imgproc
+
+Filters which process an image row by row as it is delivered (e.g. by a decoder or a line-scan sensor).
+The source rows are pushed into the filter, the filtered rows are pulled from it as soon as they can be
+computed: a filter with the kernel height `k` and the anchor in the center lags `k/2` rows behind the input.
+Only `k + 3` intermediate rows are kept in the ring buffer of the filter.
+
+Several filters can be combined into a chain (e.g. blur, Sobel, threshold): the rows produced by a stage are
+passed to the next one immediately, so no intermediate frame is ever allocated.
+
+The result of the frame is the same as the result of the corresponding function applied to the whole image.
+
+@code
+    Ptr<StreamingFilter> f = createStreamingChain({
+        createStreamingGaussianFilter(CV_8UC1, Size(5, 5), 1.2),
+        createStreamingSobel(CV_8UC1, CV_16SC1, 1, 0),
+        createStreamingThreshold(CV_16SC1, 100, 255, THRESH_BINARY)
+    });
+    f->start(Size(width, height));
+    Mat out;
+    for (int y = 0; y < height; y++)
+    {
+        f->push(readNextRow());  // 1 x width matrix
+        for (int n = f->pull(out), i = 0; i < n; i++)
+            consumeRow(out.row(i));
+    }
+@endcode
+*/
+
+//! @addtogroup imgproc_streaming
+//! @{
+
+/** @brief Filter which processes images row by row
+*/
+class CV_EXPORTS StreamingFilter
+{
+public:
+    virtual ~StreamingFilter();
+
+    /** @brief Starts a new frame
+    @param frameSize size of the frame. The border extrapolation at the bottom of the frame starts
+    when frameSize.height rows are pushed.
+    */
+    virtual void start(Size frameSize) = 0;
+
+    /** @brief Passes the next rows of the frame to the filter
+    @param rows one or several rows of frameSize.width pixels of the source type
+    */
+    virtual void push(InputArray rows) = 0;
+
+    /** @brief Retrieves the filtered rows which are ready
+    @param rows output rows of the destination type, in the order of the frame rows
+    @return number of the retrieved rows, 0 if no rows are ready
+    */
+    virtual int pull(OutputArray rows) = 0;
+
+    //! returns true if all rows of the frame are produced and pulled
+    virtual bool finished() const = 0;
+
+    virtual int srcType() const = 0;
+    virtual int dstType() const = 0;
+
+    /** @brief Returns the maximum number of rows the output lags behind the input
+
+    After `n` rows are pushed at least `n - latency()` output rows are produced.
+    */
+    virtual int latency() const = 0;
+};
+
+/** @brief Creates a streaming version of cv::sepFilter2D
+@param srcType source type
+@param dstType destination type with the same number of channels
+@param kernelX coefficients for filtering each row
+@param kernelY coefficients for filtering each column
+@param anchor anchor position within the kernel
+@param delta value added to the filtered results
+@param borderType pixel extrapolation method, see cv::BorderTypes. BORDER_WRAP is not supported.
+*/
+CV_EXPORTS Ptr<StreamingFilter> createStreamingSepFilter2D(int srcType, int dstType,
+                                                           InputArray kernelX, InputArray kernelY,
+                                                           Point anchor = Point(-1, -1), double delta = 0,
+                                                           int borderType = BORDER_DEFAULT);
+
+/** @brief Creates a streaming Gaussian filter
+
+The parameters have the same meaning as in cv::GaussianBlur. The result is the same as the result of
+cv::sepFilter2D with the Gaussian kernels: it may differ from the bit-exact 8-bit cv::GaussianBlur by 1.
+*/
+CV_EXPORTS Ptr<StreamingFilter> createStreamingGaussianFilter(int type, Size ksize,
+                                                              double sigmaX, double sigmaY = 0,
+                                                              int borderType = BORDER_DEFAULT);
+
+//! Creates a streaming version of cv::Sobel. The destination type must have the same number of channels as the source type.
+CV_EXPORTS Ptr<StreamingFilter> createStreamingSobel(int srcType, int dstType, int dx, int dy, int ksize = 3,
+                                                     double scale = 1, double delta = 0,
+                                                     int borderType = BORDER_DEFAULT);
+
+//! Creates a streaming version of cv::boxFilter
+CV_EXPORTS Ptr<StreamingFilter> createStreamingBoxFilter(int srcType, int dstType, Size ksize,
+                                                         Point anchor = Point(-1, -1), bool normalize = true,
+                                                         int borderType = BORDER_DEFAULT);
+
+//! Creates a streaming version of cv::erode (MORPH_ERODE) or cv::dilate (MORPH_DILATE)
+CV_EXPORTS Ptr<StreamingFilter> createStreamingMorphologyFilter(int op, int type, InputArray kernel,
+                                                                Point anchor = Point(-1, -1),
+                                                                int borderType = BORDER_CONSTANT,
+                                                                const Scalar& borderValue = morphologyDefaultBorderValue());
+
+//! Creates a streaming version of cv::threshold. THRESH_OTSU and THRESH_TRIANGLE are not supported.
+CV_EXPORTS Ptr<StreamingFilter> createStreamingThreshold(int type, double thresh, double maxval, int thresholdType);
+
+/** @brief Creates a streaming filter from a pixel-wise operation
+@param srcType source type
+@param dstType destination type
+@param op operation, it is called for each portion of the pushed rows.
+dst is preallocated with the rows count of src and the destination type.
+*/
+CV_EXPORTS Ptr<StreamingFilter> createStreamingPointOperation(int srcType, int dstType,
+                                                              const std::function<void(const Mat& src, Mat& dst)>& op);
+
+/** @brief Combines several filters into a pipeline
+@param stages filters created by the createStreaming* functions. The source type of each stage must be the
+destination type of the previous stage.
+*/
+CV_EXPORTS Ptr<StreamingFilter> createStreamingChain(const std::vector<Ptr<StreamingFilter> >& stages);
+
+//! @}
+
+} // namespace cv
+
+#endif // OPENCV_IMGPROC_STREAMING_HPP
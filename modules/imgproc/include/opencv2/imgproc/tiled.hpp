@@ -0,0 +1,146 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#ifndef OPENCV_IMGPROC_TILED_HPP
+#define OPENCV_IMGPROC_TILED_HPP
+
+#include "opencv2/imgproc.hpp"
+
+#include <functional>
+
+namespace cv {
+
+/** @defgroup imgproc_tiled Out-of-core Tiled Processing
+@ingroup imgproc
+
+Processing of images which don't fit into memory. The image is kept in a file (TiledImage) and
+the operations are applied tile by tile: each tile is read together with the border ("halo")
+required by the operation, processed in memory and written back. Tiles are processed in parallel,
+only a few tiles per thread are held in memory at any time.
+
+The results are the same as the results of the corresponding functions applied to the whole image,
+except for the floating-point rounding of filters: tiles of different widths may be processed by
+different (vectorized or scalar) code paths.
+*/
+
+//! @addtogroup imgproc_tiled
+//! @{
+
+/** @brief Image stored in a file and accessed by rectangular regions
+
+The file contains a 64-byte header followed by the raw image rows (native byte order, no padding).
+Only the requested regions are loaded into memory, so the image may be much larger than RAM.
+
+Regions may be read and written concurrently from several threads. Copies of the object refer to the same file.
+*/
+class CV_EXPORTS TiledImage
+{
+public:
+    TiledImage();
+
+    /** @brief Creates a new image file (an existing file is overwritten)
+    @param filename path to the file
+    @param size image size
+    @param type image type
+    */
+    void create(const String& filename, Size size, int type);
+
+    /** @brief Opens an existing image file
+    @param filename path to the file
+    @param writable open the file for writing too
+    */
+    void open(const String& filename, bool writable = false);
+
+    //! Closes the file
+    void release();
+
+    bool empty() const;
+    Size size() const;
+    int type() const;
+
+    /** @brief Reads a region of the image
+    @param roi region to read. It may be partially or completely outside of the image, the outer
+    pixels are extrapolated the same way as cv::copyMakeBorder does it.
+    @param dst destination array of size roi.size() and the image type
+    @param borderType pixel extrapolation method, see cv::BorderTypes. BORDER_WRAP is not supported.
+    @param borderValue value used in case of a constant border
+    */
+    void read(const Rect& roi, OutputArray dst, int borderType = BORDER_CONSTANT, const Scalar& borderValue = Scalar()) const;
+
+    /** @brief Writes a region of the image
+    @param src data of the same type as the image
+    @param tl top-left corner of the region. The region must be inside of the image.
+    */
+    void write(InputArray src, Point tl);
+
+    struct Impl;
+protected:
+    Ptr<Impl> p;
+};
+
+/** @brief Tile operation of processTiles()
+
+@param src source tile. It is a submatrix of a bigger array which contains up to `halo` pixels
+of the neighbouring source data on each side (less at the image borders), so functions which
+handle ROIs (like cv::GaussianBlur or cv::Sobel without BORDER_ISOLATED) see the same context
+as with the whole image.
+@param dst destination tile to fill. It is preallocated with the destination image type.
+*/
+typedef std::function<void(const Mat& src, Mat& dst)> TileOperation;
+
+/** @brief Applies an operation to the image tile by tile
+
+@param src source image
+@param dst destination image. It must be created with the same size as src.
+@param op operation, it is called concurrently for different tiles
+@param halo number of the neighbouring pixels required by the operation on each side of the tile
+@param tileSize size of the tiles
+*/
+CV_EXPORTS void processTiles(const TiledImage& src, TiledImage& dst, const TileOperation& op,
+                             int halo = 0, Size tileSize = Size(512, 512));
+
+/** @brief Tiled version of cv::sepFilter2D
+
+dst must be created with the same size as src and with the required depth. The filter is applied
+with the FilterEngine row-band pipeline to each tile, using the real image size for border handling.
+BORDER_WRAP is not supported.
+*/
+CV_EXPORTS void tiledSepFilter2D(const TiledImage& src, TiledImage& dst,
+                                 InputArray kernelX, InputArray kernelY,
+                                 Point anchor = Point(-1, -1), double delta = 0,
+                                 int borderType = BORDER_DEFAULT, Size tileSize = Size(512, 512));
+
+//! Tiled version of cv::GaussianBlur. @sa tiledSepFilter2D
+CV_EXPORTS void tiledGaussianBlur(const TiledImage& src, TiledImage& dst, Size ksize,
+                                  double sigmaX, double sigmaY = 0,
+                                  int borderType = BORDER_DEFAULT, Size tileSize = Size(512, 512));
+
+/** @brief Tiled version of cv::warpAffine
+
+The destination size is dst.size(). For every destination tile only the source region which
+is mapped into it (plus the interpolation support) is read.
+*/
+CV_EXPORTS void tiledWarpAffine(const TiledImage& src, TiledImage& dst, InputArray M,
+                                int flags = INTER_LINEAR, int borderMode = BORDER_CONSTANT,
+                                const Scalar& borderValue = Scalar(), Size tileSize = Size(512, 512));
+
+/** @brief Tiled version of cv::cvtColor
+
+dst must be created with the type of the conversion result. Only pixel-wise conversions are supported
+(not demosaicing, not conversions between packed/planar YUV 4:2:x and other formats).
+*/
+CV_EXPORTS void tiledCvtColor(const TiledImage& src, TiledImage& dst, int code, Size tileSize = Size(512, 512));
+
+/** @brief Tiled version of cv::threshold
+
+THRESH_OTSU and THRESH_TRIANGLE are not supported: they require a histogram of the whole image.
+*/
+CV_EXPORTS void tiledThreshold(const TiledImage& src, TiledImage& dst, double thresh, double maxval,
+                               int type, Size tileSize = Size(512, 512));
+
+//! @}
+
+} // namespace cv
+
+#endif // OPENCV_IMGPROC_TILED_HPP
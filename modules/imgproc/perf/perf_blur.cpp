@@ -33,6 +33,28 @@ PERF_TEST_P(Size_MatType_kSize, medianBlur,
     SANITY_CHECK(dst);
 }
 
+PERF_TEST_P(Size_MatType_kSize, medianBlur_large,
+            testing::Combine(
+                testing::Values(szVGA, sz720p),
+                testing::Values(CV_8UC1, CV_16UC1, CV_16SC1, CV_32FC1),
+                testing::Values(9, 25, 51)
+                )
+            )
+{
+    Size size = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    int ksize = get<2>(GetParam());
+
+    Mat src(size, type);
+    Mat dst(size, type);
+
+    declare.in(src, WARMUP_RNG).out(dst).time(30);
+
+    TEST_CYCLE() medianBlur(src, dst, ksize);
+
+    SANITY_CHECK_NOTHING();
+}
+
 CV_ENUM(BorderType3x3, BORDER_REPLICATE, BORDER_CONSTANT)
 CV_ENUM(BorderType, BORDER_REPLICATE, BORDER_CONSTANT, BORDER_REFLECT, BORDER_REFLECT101)
 
@@ -197,6 +197,7 @@ void cvtColor( InputArray _src, OutputArray _dst, int code, int dcn, AlgorithmHi
         hint = cv::getDefaultAlgorithmHint();
 
     CV_Assert(!_src.empty());
+    CV_INSTRUMENT_PROCESSED_BYTES(_src.total() * CV_ELEM_SIZE(_src.type()));
 
     if(dcn <= 0)
             dcn = dstChannels(code);
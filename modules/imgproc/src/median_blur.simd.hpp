@@ -838,6 +838,262 @@ medianBlur_SortNet( const Mat& _src, Mat& _dst, int m )
     }
 }
 
+/*
+ * Median filter with large apertures for 16-bit and floating-point images.
+ *
+ * The window histogram has 2^16 bins grouped into 256 coarse bins. The window moves
+ * in the serpentine order over a band of rows, so every step removes one column (or row)
+ * of the aperture and adds another one, and the median is found by a short search
+ * starting from the previous median: the cost per pixel is 2*ksize histogram updates
+ * and does not depend on the histogram size.
+ *
+ * 32-bit floating-point images are processed by tiles: the values of a tile (together
+ * with the aperture margin) are replaced by their ranks within the tile, the ranks fit into
+ * 16 bits while the tile is not larger than 256x256 pixels.
+ */
+class MedianHist16
+{
+public:
+    explicit MedianHist16(int m) : hist(1 << 16, 0), coarse(256, 0), half(m*m/2), med(0), below(0) {}
+
+    void add(int v) { hist[v]++; coarse[v >> 8]++; below += v < med; }
+    void remove(int v) { hist[v]--; coarse[v >> 8]--; below -= v < med; }
+
+    // the value with the index m*m/2 in the sorted window
+    int median()
+    {
+        while( below > half )
+        {
+            med = prevNonZero(med);
+            below -= hist[med];
+        }
+        while( below + hist[med] <= half )
+        {
+            below += hist[med];
+            med = nextNonZero(med);
+        }
+        return med;
+    }
+
+private:
+    // the nearest values with non-zero counters, they exist by the choice of the median
+    int prevNonZero(int v) const
+    {
+        int u = v - 1, c = v >> 8;
+        for( ; u >= (c << 8); u-- )
+            if( hist[u] )
+                return u;
+        for( c--; coarse[c] == 0; c-- )
+            ;
+        for( u = (c << 8) + 255; hist[u] == 0; u-- )
+            ;
+        return u;
+    }
+
+    int nextNonZero(int v) const
+    {
+        int u = v + 1, c = v >> 8;
+        for( ; u < ((c + 1) << 8); u++ )
+            if( hist[u] )
+                return u;
+        for( c++; coarse[c] == 0; c++ )
+            ;
+        for( u = c << 8; hist[u] == 0; u++ )
+            ;
+        return u;
+    }
+
+    std::vector<int> hist, coarse;
+    int half, med, below;
+};
+
+// Computes the median of the channel c for the rows [y0, y1) and the columns [0, width) of the result.
+// src is the ushort image with the border of m/2 pixels on each side, sink(y, x, value) stores the result.
+template<class Sink> static void
+medianHist16Band( const Mat& src, int c, int m, int y0, int y1, int width, Sink& sink )
+{
+    const int cn = src.channels();
+    MedianHist16 h(m);
+    for( int i = 0; i < m; i++ )
+    {
+        const ushort* row = src.ptr<ushort>(y0 + i) + c;
+        for( int j = 0; j < m; j++ )
+            h.add(row[j*cn]);
+    }
+
+    int x = 0, dir = 1;
+    for( int y = y0; y < y1; y++, dir = -dir )
+    {
+        for( ;; )
+        {
+            sink(y, x, h.median());
+            int nx = x + dir;
+            if( nx < 0 || nx >= width )
+                break;
+            int rx = (dir > 0 ? x : x + m - 1)*cn + c;
+            int ax = (dir > 0 ? x + m : x - 1)*cn + c;
+            for( int i = 0; i < m; i++ )
+            {
+                const ushort* row = src.ptr<ushort>(y + i);
+                h.remove(row[rx]);
+                h.add(row[ax]);
+            }
+            x = nx;
+        }
+        if( y + 1 < y1 )
+        {
+            const ushort* top = src.ptr<ushort>(y) + x*cn + c;
+            const ushort* bottom = src.ptr<ushort>(y + m) + x*cn + c;
+            for( int j = 0; j < m; j++ )
+            {
+                h.remove(top[j*cn]);
+                h.add(bottom[j*cn]);
+            }
+        }
+    }
+}
+
+struct MedianSink16
+{
+    MedianSink16( Mat& _dst, int _c, ushort _bias ) : dst(_dst), c(_c), cn(_dst.channels()), bias(_bias) {}
+    void operator()( int y, int x, int v ) { dst.ptr<ushort>(y)[x*cn + c] = (ushort)(v ^ bias); }
+
+    Mat& dst;
+    int c, cn;
+    ushort bias;
+};
+
+class MedianBlur16Invoker : public ParallelLoopBody
+{
+public:
+    MedianBlur16Invoker( const Mat& _src, Mat& _dst, int _m, ushort _bias )
+        : src(_src), dst(_dst), m(_m), bias(_bias) {}
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        for( int c = 0; c < dst.channels(); c++ )
+        {
+            MedianSink16 sink(dst, c, bias);
+            medianHist16Band(src, c, m, range.start, range.end, dst.cols, sink);
+        }
+    }
+
+private:
+    const Mat& src;
+    Mat& dst;
+    int m;
+    ushort bias;
+};
+
+// monotonic mapping of floats to unsigned integers
+static inline unsigned medianFloatKey( float f )
+{
+    Cv32suf v;
+    v.f = f;
+    return (v.u & 0x80000000u) ? ~v.u : (v.u | 0x80000000u);
+}
+
+struct MedianSinkRank
+{
+    MedianSinkRank( Mat& _dst, Point _ofs, int _c, const std::vector<float>& _values )
+        : dst(_dst), ofs(_ofs), c(_c), cn(_dst.channels()), values(_values) {}
+    void operator()( int y, int x, int v ) { dst.ptr<float>(y + ofs.y)[(x + ofs.x)*cn + c] = values[v]; }
+
+    Mat& dst;
+    Point ofs;
+    int c, cn;
+    const std::vector<float>& values;
+};
+
+class MedianBlur32fInvoker : public ParallelLoopBody
+{
+public:
+    MedianBlur32fInvoker( const Mat& _src, Mat& _dst, int _m, int _tile )
+        : src(_src), dst(_dst), m(_m), tile(_tile) {}
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        const int cn = dst.channels(), tilesX = (dst.cols + tile - 1)/tile;
+        std::vector<uint64> keys;
+        std::vector<float> values;
+        Mat ranks;
+        for( int t = range.start; t < range.end; t++ )
+        {
+            Rect r((t % tilesX)*tile, (t / tilesX)*tile, tile, tile);
+            r &= Rect(0, 0, dst.cols, dst.rows);
+            Mat area = src(Rect(r.x, r.y, r.width + m - 1, r.height + m - 1));
+            const int n = area.rows*area.cols;
+            keys.resize(n);
+            ranks.create(area.size(), CV_16UC1);
+            for( int c = 0; c < cn; c++ )
+            {
+                for( int y = 0, k = 0; y < area.rows; y++ )
+                {
+                    const float* row = area.ptr<float>(y) + c;
+                    for( int x = 0; x < area.cols; x++, k++ )
+                        keys[k] = ((uint64)medianFloatKey(row[x*cn]) << 32) | (unsigned)k;
+                }
+                std::sort(keys.begin(), keys.end());
+
+                values.clear();
+                unsigned prev = 0;
+                ushort* rank = ranks.ptr<ushort>();
+                for( int k = 0; k < n; k++ )
+                {
+                    unsigned key = (unsigned)(keys[k] >> 32);
+                    int idx = (int)(keys[k] & 0xffffffffu);
+                    if( k == 0 || key != prev )
+                        values.push_back(area.ptr<float>(idx / area.cols)[(idx % area.cols)*cn + c]);
+                    prev = key;
+                    rank[idx] = (ushort)(values.size() - 1);
+                }
+
+                MedianSinkRank sink(dst, r.tl(), c, values);
+                medianHist16Band(ranks, 0, m, 0, r.height, r.width, sink);
+            }
+        }
+    }
+
+private:
+    const Mat& src;
+    Mat& dst;
+    int m, tile;
+};
+
+static void
+medianBlur_16u32f( const Mat& src0, Mat& dst, int m )
+{
+    CV_INSTRUMENT_REGION();
+
+    const int depth = src0.depth(), r = m/2;
+    CV_Assert( depth == CV_16U || depth == CV_16S || depth == CV_32F );
+
+    Mat src;
+    cv::copyMakeBorder( src0, src, r, r, r, r, BORDER_REPLICATE|BORDER_ISOLATED );
+
+    if( depth == CV_32F )
+    {
+        // the tile with its margin must not have more than 2^16 distinct values
+        CV_CheckLE( m, 255, "medianBlur: the aperture size of floating-point images must not exceed 255" );
+        int tile = std::min(std::max(dst.rows, dst.cols), 257 - m);
+        int ntiles = ((dst.cols + tile - 1)/tile)*((dst.rows + tile - 1)/tile);
+        parallel_for_(Range(0, ntiles), MedianBlur32fInvoker(src, dst, m, tile));
+        return;
+    }
+
+    ushort bias = 0;
+    if( depth == CV_16S )
+    {
+        // the signed values are shifted to the unsigned range preserving the order
+        bias = 0x8000;
+        Mat usrc(src.size(), CV_MAKETYPE(CV_16U, src.channels()), src.data, src.step);
+        cv::bitwise_xor(usrc, Scalar::all(bias), usrc);
+    }
+    // each band initializes its histogram with m*m values, so the bands should be much higher than m
+    double nstripes = std::max(1., std::min((double)getNumThreads()*4, (double)dst.rows/(2*m)));
+    parallel_for_(Range(0, dst.rows), MedianBlur16Invoker(src, dst, m, bias), nstripes);
+}
+
 } // namespace anon
 
 void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize)
@@ -873,6 +1129,12 @@ void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize)
     }
     else
     {
+        if( src0.depth() != CV_8U )
+        {
+            medianBlur_16u32f( src0, dst, ksize );
+            return;
+        }
+
         // TODO AVX guard (external call)
         cv::copyMakeBorder( src0, src, 0, 0, ksize/2, ksize/2, BORDER_REPLICATE|BORDER_ISOLATED);
 
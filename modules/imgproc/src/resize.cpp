@@ -4223,6 +4223,8 @@ void cv::resize( InputArray _src, OutputArray _dst, Size dsize,
     if (interpolation == INTER_LINEAR_EXACT && (_src.depth() == CV_32F || _src.depth() == CV_64F))
         interpolation = INTER_LINEAR; // If depth isn't supported fallback to generic resize
 
+    CV_INSTRUMENT_PROCESSED_BYTES((int64)ssize.area() * CV_ELEM_SIZE(_src.type()));
+
     CV_OCL_RUN(_src.dims() <= 2 && _dst.isUMat() && _src.cols() > 10 && _src.rows() > 10,
                ocl_resize(_src, _dst, dsize, inv_scale_x, inv_scale_y, interpolation))
 
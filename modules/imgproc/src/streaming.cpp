@@ -0,0 +1,324 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "filterengine.hpp"
+#include "opencv2/imgproc/streaming.hpp"
+
+namespace cv
+{
+
+StreamingFilter::~StreamingFilter()
+{
+}
+
+namespace {
+
+// Common part of the streaming filters: validation of the input and the queue of the produced rows
+class StreamingFilterImpl : public StreamingFilter
+{
+public:
+    StreamingFilterImpl(int _srcType, int _dstType)
+        : stype(_srcType), dtype(_dstType), inputRows(0), outputRows(0), pending(0) {}
+
+    void start(Size size) CV_OVERRIDE
+    {
+        CV_Assert(size.width > 0 && size.height > 0);
+        frameSize = size;
+        inputRows = outputRows = pending = 0;
+        if (outBuf.cols != size.width)
+            outBuf.release();
+        reset();
+    }
+
+    void push(InputArray _rows) CV_OVERRIDE
+    {
+        Mat rows = _rows.getMat();
+        if (rows.empty())
+            return;
+        CV_Assert(frameSize.width > 0 && "start() must be called before push()");
+        CV_CheckTypeEQ(rows.type(), stype, "StreamingFilter: unexpected type of the source rows");
+        CV_CheckEQ(rows.cols, frameSize.width, "StreamingFilter: unexpected width of the source rows");
+        CV_Assert(inputRows + rows.rows <= frameSize.height);
+        pushRows(rows);
+    }
+
+    int pull(OutputArray dst) CV_OVERRIDE
+    {
+        Mat rows = pendingRows();
+        if (rows.empty())
+        {
+            dst.release();
+            return 0;
+        }
+        rows.copyTo(dst);
+        clearPending();
+        return rows.rows;
+    }
+
+    bool finished() const CV_OVERRIDE
+    {
+        return frameSize.height > 0 && outputRows == frameSize.height && pending == 0;
+    }
+
+    int srcType() const CV_OVERRIDE { return stype; }
+    int dstType() const CV_OVERRIDE { return dtype; }
+
+    // the source rows are validated already
+    virtual void pushRows(const Mat& rows)
+    {
+        int count = maxOutputRows(rows.rows);
+        reserve(pending + count);
+        Mat dst = outBuf.rowRange(pending, pending + count);
+        int n = process(rows, dst);
+        inputRows += rows.rows;
+        pending += n;
+        outputRows += n;
+    }
+
+    // produced rows which are not pulled yet
+    virtual Mat pendingRows() const
+    {
+        return pending > 0 ? outBuf.rowRange(0, pending) : Mat();
+    }
+
+    virtual void clearPending()
+    {
+        pending = 0;
+    }
+
+protected:
+    //! prepares the filter for a new frame
+    virtual void reset() = 0;
+    //! the upper bound of the rows count produced from the next count source rows
+    virtual int maxOutputRows(int count) const = 0;
+    //! processes the source rows, returns the number of rows written to dst
+    virtual int process(const Mat& src, Mat& dst) = 0;
+
+    void reserve(int rows)
+    {
+        if (outBuf.rows >= rows)
+            return;
+        Mat buf(std::max(rows, outBuf.rows * 2), frameSize.width, dtype);
+        if (pending > 0)
+            outBuf.rowRange(0, pending).copyTo(buf.rowRange(0, pending));
+        outBuf = buf;
+    }
+
+    int stype, dtype;
+    Size frameSize;
+    int inputRows, outputRows;
+    int pending;
+    Mat outBuf;
+};
+
+class StreamingFilterEngine CV_FINAL : public StreamingFilterImpl
+{
+public:
+    StreamingFilterEngine(const Ptr<FilterEngine>& _engine)
+        : StreamingFilterImpl(_engine->srcType, _engine->dstType), engine(_engine) {}
+
+    int latency() const CV_OVERRIDE
+    {
+        return engine->ksize.height - 1 - engine->anchor.y;
+    }
+
+protected:
+    void reset() CV_OVERRIDE
+    {
+        engine->start(frameSize, frameSize, Point());
+    }
+
+    int maxOutputRows(int count) const CV_OVERRIDE
+    {
+        return std::min(engine->remainingOutputRows(), count + engine->ksize.height);
+    }
+
+    int process(const Mat& src, Mat& dst) CV_OVERRIDE
+    {
+        // the engine keeps the last ksize.height + 3 rows in its ring buffer
+        return engine->proceed(src.ptr(), (int)src.step, src.rows, dst.ptr(), (int)dst.step);
+    }
+
+    Ptr<FilterEngine> engine;
+};
+
+class StreamingPointOperation CV_FINAL : public StreamingFilterImpl
+{
+public:
+    StreamingPointOperation(int _srcType, int _dstType, const std::function<void(const Mat&, Mat&)>& _op)
+        : StreamingFilterImpl(_srcType, _dstType), op(_op) {}
+
+    int latency() const CV_OVERRIDE { return 0; }
+
+protected:
+    void reset() CV_OVERRIDE {}
+
+    int maxOutputRows(int count) const CV_OVERRIDE
+    {
+        return count;
+    }
+
+    int process(const Mat& src, Mat& dst) CV_OVERRIDE
+    {
+        uchar* data = dst.data;
+        op(src, dst);
+        CV_Assert(dst.data == data && "The operation must write to the preallocated destination");
+        return src.rows;
+    }
+
+    std::function<void(const Mat&, Mat&)> op;
+};
+
+class StreamingChain CV_FINAL : public StreamingFilterImpl
+{
+public:
+    StreamingChain(const std::vector<StreamingFilterImpl*>& _stages, const std::vector<Ptr<StreamingFilter> >& _refs)
+        : StreamingFilterImpl(_stages.front()->srcType(), _stages.back()->dstType()), stages(_stages), refs(_refs) {}
+
+    void start(Size size) CV_OVERRIDE
+    {
+        StreamingFilterImpl::start(size);
+        for (size_t i = 0; i < stages.size(); i++)
+            stages[i]->start(size);
+    }
+
+    bool finished() const CV_OVERRIDE
+    {
+        return stages.back()->finished();
+    }
+
+    int latency() const CV_OVERRIDE
+    {
+        int sum = 0;
+        for (size_t i = 0; i < stages.size(); i++)
+            sum += stages[i]->latency();
+        return sum;
+    }
+
+    void pushRows(const Mat& rows) CV_OVERRIDE
+    {
+        stages[0]->pushRows(rows);
+        for (size_t i = 1; i < stages.size(); i++)
+        {
+            // rows are passed from the output queue of the previous stage without copying
+            Mat prev = stages[i - 1]->pendingRows();
+            if (prev.empty())
+                break;
+            stages[i]->pushRows(prev);
+            stages[i - 1]->clearPending();
+        }
+        inputRows += rows.rows;
+    }
+
+    Mat pendingRows() const CV_OVERRIDE
+    {
+        return stages.back()->pendingRows();
+    }
+
+    void clearPending() CV_OVERRIDE
+    {
+        stages.back()->clearPending();
+    }
+
+protected:
+    void reset() CV_OVERRIDE {}
+    int maxOutputRows(int) const CV_OVERRIDE { return 0; }
+    int process(const Mat&, Mat&) CV_OVERRIDE { return 0; }
+
+    std::vector<StreamingFilterImpl*> stages;
+    std::vector<Ptr<StreamingFilter> > refs;
+};
+
+} // namespace
+
+Ptr<StreamingFilter> createStreamingSepFilter2D(int srcType, int dstType, InputArray kernelX, InputArray kernelY,
+                                                Point anchor, double delta, int borderType)
+{
+    CV_CheckEQ(CV_MAT_CN(srcType), CV_MAT_CN(dstType), "");
+    borderType &= ~BORDER_ISOLATED;
+    CV_Assert(borderType != BORDER_WRAP);
+    return makePtr<StreamingFilterEngine>(createSeparableLinearFilter(srcType, dstType, kernelX, kernelY,
+                                                                      anchor, delta, borderType));
+}
+
+Ptr<StreamingFilter> createStreamingGaussianFilter(int type, Size ksize, double sigma1, double sigma2, int borderType)
+{
+    borderType &= ~BORDER_ISOLATED;
+    CV_Assert(borderType != BORDER_WRAP);
+    return makePtr<StreamingFilterEngine>(createGaussianFilter(type, ksize, sigma1, sigma2, borderType));
+}
+
+Ptr<StreamingFilter> createStreamingSobel(int srcType, int dstType, int dx, int dy, int ksize,
+                                          double scale, double delta, int borderType)
+{
+    CV_CheckEQ(CV_MAT_CN(srcType), CV_MAT_CN(dstType), "");
+    // the same kernels as in Sobel()
+    int ktype = std::max(CV_32F, std::max(CV_MAT_DEPTH(dstType), CV_MAT_DEPTH(srcType)));
+    Mat kx, ky;
+    getDerivKernels(kx, ky, dx, dy, ksize, false, ktype);
+    if (scale != 1)
+    {
+        if (dx == 0)
+            kx *= scale;
+        else
+            ky *= scale;
+    }
+    return createStreamingSepFilter2D(srcType, dstType, kx, ky, Point(-1, -1), delta, borderType);
+}
+
+Ptr<StreamingFilter> createStreamingBoxFilter(int srcType, int dstType, Size ksize, Point anchor,
+                                              bool normalize, int borderType)
+{
+    CV_CheckEQ(CV_MAT_CN(srcType), CV_MAT_CN(dstType), "");
+    borderType &= ~BORDER_ISOLATED;
+    CV_Assert(borderType != BORDER_WRAP);
+    return makePtr<StreamingFilterEngine>(createBoxFilter(srcType, dstType, ksize, anchor, normalize, borderType));
+}
+
+Ptr<StreamingFilter> createStreamingMorphologyFilter(int op, int type, InputArray _kernel, Point anchor,
+                                                     int borderType, const Scalar& borderValue)
+{
+    CV_Assert(op == MORPH_ERODE || op == MORPH_DILATE);
+    borderType &= ~BORDER_ISOLATED;
+    CV_Assert(borderType != BORDER_WRAP);
+    Mat kernel = _kernel.getMat();
+    if (kernel.empty())
+        kernel = getStructuringElement(MORPH_RECT, Size(3, 3));
+    return makePtr<StreamingFilterEngine>(createMorphologyFilter(op, type, kernel, anchor,
+                                                                 borderType, borderType, borderValue));
+}
+
+Ptr<StreamingFilter> createStreamingThreshold(int type, double thresh, double maxval, int thresholdType)
+{
+    CV_Assert((thresholdType & (THRESH_OTSU | THRESH_TRIANGLE)) == 0);
+    return makePtr<StreamingPointOperation>(type, type, [=](const Mat& src, Mat& dst)
+    {
+        threshold(src, dst, thresh, maxval, thresholdType);
+    });
+}
+
+Ptr<StreamingFilter> createStreamingPointOperation(int srcType, int dstType,
+                                                   const std::function<void(const Mat& src, Mat& dst)>& op)
+{
+    CV_Assert(op);
+    return makePtr<StreamingPointOperation>(srcType, dstType, op);
+}
+
+Ptr<StreamingFilter> createStreamingChain(const std::vector<Ptr<StreamingFilter> >& stages)
+{
+    CV_Assert(!stages.empty());
+    std::vector<StreamingFilterImpl*> impls;
+    for (size_t i = 0; i < stages.size(); i++)
+    {
+        StreamingFilterImpl* impl = dynamic_cast<StreamingFilterImpl*>(stages[i].get());
+        CV_Assert(impl && "Stages must be created by the createStreaming* functions");
+        if (i > 0)
+            CV_CheckTypeEQ(impl->srcType(), impls.back()->dstType(), "Source type of the stage must be the destination type of the previous one");
+        impls.push_back(impl);
+    }
+    return makePtr<StreamingChain>(impls, stages);
+}
+
+} // namespace cv
@@ -0,0 +1,475 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "filterengine.hpp"
+#include "opencv2/imgproc/tiled.hpp"
+
+namespace cv
+{
+
+// Layout of the file: 64-byte header followed by raw rows without padding, native byte order.
+static const char TILED_IMAGE_SIGNATURE[] = "OpenCV tiled image v1\n";
+static const int64 TILED_IMAGE_HEADER_SIZE = 64;
+
+struct TiledImage::Impl
+{
+    Impl() : f(NULL), type(-1), esz(0), writable(false) {}
+    ~Impl() { close(); }
+
+    void close()
+    {
+        if (f)
+            fclose(f);
+        f = NULL;
+    }
+
+    void seek(int64 pos) const
+    {
+#if defined(_WIN32)
+        int res = _fseeki64(f, pos, SEEK_SET);
+#else
+        int res = fseeko(f, (off_t)pos, SEEK_SET);
+#endif
+        if (res != 0)
+            CV_Error(Error::StsError, "TiledImage: can't seek in file " + filename);
+    }
+
+    int64 rowOffset(int y, int x) const
+    {
+        return TILED_IMAGE_HEADER_SIZE + ((int64)y * size.width + x) * (int64)esz;
+    }
+
+    // reads part of the image row, the range must be inside of the image
+    void readRow(int y, int x, int count, uchar* dst) const
+    {
+        seek(rowOffset(y, x));
+        if (fread(dst, esz, count, f) != (size_t)count)
+            CV_Error(Error::StsError, "TiledImage: can't read file " + filename);
+    }
+
+    void writeRow(int y, int x, int count, const uchar* src)
+    {
+        seek(rowOffset(y, x));
+        if (fwrite(src, esz, count, f) != (size_t)count)
+            CV_Error(Error::StsError, "TiledImage: can't write file " + filename);
+    }
+
+    String filename;
+    FILE* f;
+    Size size;
+    int type;
+    size_t esz;
+    bool writable;
+    // file position is shared, so I/O requests are serialized
+    mutable Mutex mutex;
+};
+
+TiledImage::TiledImage()
+{
+}
+
+void TiledImage::create(const String& filename, Size size, int type)
+{
+    CV_Assert(size.width > 0 && size.height > 0);
+    Ptr<Impl> impl = makePtr<Impl>();
+    impl->filename = filename;
+    impl->size = size;
+    impl->type = CV_MAT_TYPE(type);
+    impl->esz = CV_ELEM_SIZE(type);
+    impl->writable = true;
+    impl->f = fopen(filename.c_str(), "w+b");
+    if (!impl->f)
+        CV_Error(Error::StsError, "TiledImage: can't create file " + filename);
+
+    char header[TILED_IMAGE_HEADER_SIZE] = {};
+    memcpy(header, TILED_IMAGE_SIGNATURE, sizeof(TILED_IMAGE_SIGNATURE) - 1);
+    int* params = (int*)(header + 32);
+    params[0] = size.width;
+    params[1] = size.height;
+    params[2] = impl->type;
+    if (fwrite(header, 1, sizeof(header), impl->f) != sizeof(header))
+        CV_Error(Error::StsError, "TiledImage: can't write file " + filename);
+
+    // extend the file to the full size, data pages are allocated by the file system on demand
+    int64 total = impl->rowOffset(size.height, 0);
+    impl->seek(total - 1);
+    if (fputc(0, impl->f) == EOF)
+        CV_Error(Error::StsError, "TiledImage: can't write file " + filename);
+    p = impl;
+}
+
+void TiledImage::open(const String& filename, bool writable)
+{
+    Ptr<Impl> impl = makePtr<Impl>();
+    impl->filename = filename;
+    impl->writable = writable;
+    impl->f = fopen(filename.c_str(), writable ? "r+b" : "rb");
+    if (!impl->f)
+        CV_Error(Error::StsError, "TiledImage: can't open file " + filename);
+
+    char header[TILED_IMAGE_HEADER_SIZE] = {};
+    if (fread(header, 1, sizeof(header), impl->f) != sizeof(header) ||
+        memcmp(header, TILED_IMAGE_SIGNATURE, sizeof(TILED_IMAGE_SIGNATURE) - 1) != 0)
+        CV_Error(Error::StsParseError, "TiledImage: invalid file " + filename);
+    const int* params = (const int*)(header + 32);
+    impl->size = Size(params[0], params[1]);
+    impl->type = params[2];
+    if (impl->size.width <= 0 || impl->size.height <= 0 || impl->type != CV_MAT_TYPE(impl->type))
+        CV_Error(Error::StsParseError, "TiledImage: invalid file " + filename);
+    impl->esz = CV_ELEM_SIZE(impl->type);
+    p = impl;
+}
+
+void TiledImage::release()
+{
+    p.release();
+}
+
+bool TiledImage::empty() const
+{
+    return !p;
+}
+
+Size TiledImage::size() const
+{
+    return p ? p->size : Size();
+}
+
+int TiledImage::type() const
+{
+    return p ? p->type : -1;
+}
+
+void TiledImage::read(const Rect& roi, OutputArray _dst, int borderType, const Scalar& borderValue) const
+{
+    CV_Assert(p);
+    CV_Assert(roi.width > 0 && roi.height > 0);
+    borderType &= ~BORDER_ISOLATED;
+    CV_Assert(borderType != BORDER_WRAP);
+
+    const Impl& impl = *p;
+    const size_t esz = impl.esz;
+    _dst.create(roi.size(), impl.type);
+    Mat dst = _dst.getMat();
+
+    Rect inner = roi & Rect(Point(), impl.size);
+    if (inner == roi)
+    {
+        AutoLock lock(impl.mutex);
+        for (int y = 0; y < roi.height; y++)
+            impl.readRow(roi.y + y, roi.x, roi.width, dst.ptr(y));
+        return;
+    }
+
+    if (borderType == BORDER_CONSTANT)
+    {
+        dst.setTo(borderValue);
+        if (inner.empty())
+            return;
+        AutoLock lock(impl.mutex);
+        for (int y = inner.y; y < inner.y + inner.height; y++)
+            impl.readRow(y, inner.x, inner.width, dst.ptr(y - roi.y) + (inner.x - roi.x) * esz);
+        return;
+    }
+
+    // extrapolated pixels: map each column and row into the image
+    std::vector<int> xofs(roi.width);
+    int x0 = INT_MAX, x1 = INT_MIN;
+    for (int x = 0; x < roi.width; x++)
+    {
+        int sx = borderInterpolate(roi.x + x, impl.size.width, borderType);
+        xofs[x] = sx;
+        x0 = std::min(x0, sx);
+        x1 = std::max(x1, sx);
+    }
+    std::vector<uchar> rowBuf((x1 - x0 + 1) * esz);
+    AutoLock lock(impl.mutex);
+    for (int y = 0; y < roi.height; y++)
+    {
+        int sy = borderInterpolate(roi.y + y, impl.size.height, borderType);
+        impl.readRow(sy, x0, x1 - x0 + 1, &rowBuf[0]);
+        uchar* D = dst.ptr(y);
+        for (int x = 0; x < roi.width; x++)
+            memcpy(D + x * esz, &rowBuf[(xofs[x] - x0) * esz], esz);
+    }
+}
+
+void TiledImage::write(InputArray _src, Point tl)
+{
+    CV_Assert(p);
+    Impl& impl = *p;
+    CV_Assert(impl.writable);
+    Mat src = _src.getMat();
+    CV_CheckTypeEQ(src.type(), impl.type, "TiledImage: type of the written data must be the same as the image type");
+    CV_Assert(src.dims <= 2);
+    Rect roi(tl, src.size());
+    CV_Assert((roi & Rect(Point(), impl.size)) == roi);
+
+    AutoLock lock(impl.mutex);
+    for (int y = 0; y < roi.height; y++)
+        impl.writeRow(roi.y + y, roi.x, roi.width, src.ptr(y));
+    // make the data visible to other TiledImage objects opened on the same file
+    fflush(impl.f);
+}
+
+//==================================================================================================
+
+typedef std::function<void(const Rect& dstRect)> TileBody;
+
+class TiledParallelBody : public ParallelLoopBody
+{
+public:
+    TiledParallelBody(Size _size, Size _tileSize, const TileBody& _body)
+        : size(_size), tileSize(_tileSize), body(_body)
+    {
+        tilesX = divUp(size.width, tileSize.width);
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        for (int i = range.start; i < range.end; i++)
+        {
+            Rect tile(Point((i % tilesX) * tileSize.width, (i / tilesX) * tileSize.height), tileSize);
+            body(tile & Rect(Point(), size));
+        }
+    }
+
+protected:
+    Size size;
+    Size tileSize;
+    int tilesX;
+    const TileBody& body;
+};
+
+static void forEachTile(Size size, Size tileSize, const TileBody& body)
+{
+    CV_Assert(tileSize.width > 0 && tileSize.height > 0);
+    int ntiles = divUp(size.width, tileSize.width) * divUp(size.height, tileSize.height);
+    parallel_for_(Range(0, ntiles), TiledParallelBody(size, tileSize, body));
+}
+
+// calls body(srcTile, dstTile, dstRect), where srcTile is a view of the source tile
+// with up to 'halo' neighbouring pixels available around it
+typedef std::function<void(const Mat& src, Mat& dst, const Rect& dstRect)> HaloTileBody;
+
+static void forEachHaloTile(const TiledImage& src, TiledImage& dst, int halo, Size tileSize,
+                            const HaloTileBody& body)
+{
+    CV_Assert(!src.empty() && !dst.empty());
+    CV_Assert(halo >= 0);
+    CV_CheckEQ(src.size(), dst.size(), "TiledImage: source and destination must have the same size");
+    const Size size = src.size();
+    const int dstType = dst.type();
+
+    forEachTile(size, tileSize, [&](const Rect& tile)
+    {
+        Rect outer(tile.x - halo, tile.y - halo, tile.width + halo * 2, tile.height + halo * 2);
+        outer &= Rect(Point(), size);
+        Mat buf;
+        src.read(outer, buf);
+        Mat srcTile = buf(Rect(tile.tl() - outer.tl(), tile.size()));
+        Mat dstTile(tile.size(), dstType);
+        body(srcTile, dstTile, tile);
+        CV_CheckEQ(dstTile.size(), tile.size(), "Tile operation must not change the tile size");
+        CV_CheckTypeEQ(dstTile.type(), dstType, "Tile operation must produce the destination type");
+        dst.write(dstTile, tile.tl());
+    });
+}
+
+void processTiles(const TiledImage& src, TiledImage& dst, const TileOperation& op, int halo, Size tileSize)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert(op);
+    forEachHaloTile(src, dst, halo, tileSize, [&](const Mat& srcTile, Mat& dstTile, const Rect&)
+    {
+        op(srcTile, dstTile);
+    });
+}
+
+void tiledSepFilter2D(const TiledImage& src, TiledImage& dst, InputArray _kernelX, InputArray _kernelY,
+                      Point anchor, double delta, int borderType, Size tileSize)
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat kernelX = _kernelX.getMat(), kernelY = _kernelY.getMat();
+    CV_Assert(!kernelX.empty() && !kernelY.empty());
+    CV_CheckEQ(CV_MAT_CN(src.type()), CV_MAT_CN(dst.type()), "");
+    borderType &= ~BORDER_ISOLATED;
+    CV_Assert(borderType != BORDER_WRAP);
+
+    int kx = (int)kernelX.total(), ky = (int)kernelY.total();
+    Point a(anchor.x < 0 ? kx / 2 : anchor.x, anchor.y < 0 ? ky / 2 : anchor.y);
+    int halo = std::max(std::max(a.x, kx - 1 - a.x), std::max(a.y, ky - 1 - a.y));
+    const Size wholeSize = src.size();
+    const int srcType = src.type(), dstType = dst.type();
+
+    forEachHaloTile(src, dst, halo, tileSize, [&](const Mat& srcTile, Mat& dstTile, const Rect& tile)
+    {
+        // the engine works with the coordinates of the whole image, so the borders are
+        // extrapolated at the image edges only, inside of the image the halo is used
+        Ptr<FilterEngine> engine = createSeparableLinearFilter(srcType, dstType, kernelX, kernelY,
+                                                               a, delta, borderType, borderType);
+        engine->apply(srcTile, dstTile, wholeSize, tile.tl());
+    });
+}
+
+void tiledGaussianBlur(const TiledImage& src, TiledImage& dst, Size ksize,
+                       double sigma1, double sigma2, int borderType, Size tileSize)
+{
+    CV_INSTRUMENT_REGION();
+
+    int depth = CV_MAT_DEPTH(src.type());
+    if (sigma2 <= 0)
+        sigma2 = sigma1;
+    // the same rule as in GaussianBlur()
+    if (ksize.width <= 0 && sigma1 > 0)
+        ksize.width = cvRound(sigma1 * (depth == CV_8U ? 3 : 4) * 2 + 1) | 1;
+    if (ksize.height <= 0 && sigma2 > 0)
+        ksize.height = cvRound(sigma2 * (depth == CV_8U ? 3 : 4) * 2 + 1) | 1;
+    CV_Assert(ksize.width > 0 && ksize.width % 2 == 1 &&
+              ksize.height > 0 && ksize.height % 2 == 1);
+    CV_CheckTypeEQ(src.type(), dst.type(), "");
+    borderType &= ~BORDER_ISOLATED;
+
+    // GaussianBlur handles submatrices the same way as the whole image,
+    // and it has a bit-exact 8u path which differs from the generic sepFilter2D
+    processTiles(src, dst, [&](const Mat& srcTile, Mat& dstTile)
+    {
+        GaussianBlur(srcTile, dstTile, ksize, sigma1, sigma2, borderType);
+    }, std::max(ksize.width, ksize.height) / 2, tileSize);
+}
+
+void tiledWarpAffine(const TiledImage& src, TiledImage& dst, InputArray _M,
+                     int flags, int borderMode, const Scalar& borderValue, Size tileSize)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert(!src.empty() && !dst.empty());
+    CV_CheckTypeEQ(src.type(), dst.type(), "");
+    Mat M0 = _M.getMat();
+    CV_Assert((M0.type() == CV_32F || M0.type() == CV_64F) && M0.rows == 2 && M0.cols == 3);
+    Matx23d M;
+    M0.convertTo(Mat(2, 3, CV_64F, M.val), CV_64F);
+    if (!(flags & WARP_INVERSE_MAP))
+        invertAffineTransform(M, M);
+
+    int interpolation = flags & INTER_MAX;
+    int support = interpolation == INTER_NEAREST ? 1 : interpolation == INTER_CUBIC ? 3 : interpolation == INTER_LANCZOS4 ? 5 : 2;
+    if (interpolation == INTER_AREA)
+        interpolation = INTER_LINEAR;
+    const Size srcSize = src.size(), dstSize = dst.size();
+    const int type = src.type();
+
+    const int AB_BITS = MAX(10, (int)INTER_BITS);
+    const int AB_SCALE = 1 << AB_BITS;
+    const int round_delta = interpolation == INTER_NEAREST ? AB_SCALE / 2 : AB_SCALE / INTER_TAB_SIZE / 2;
+    std::vector<int> adelta(dstSize.width), bdelta(dstSize.width);
+    for (int x = 0; x < dstSize.width; x++)
+    {
+        adelta[x] = saturate_cast<int>(M(0, 0) * x * AB_SCALE);
+        bdelta[x] = saturate_cast<int>(M(1, 0) * x * AB_SCALE);
+    }
+
+    forEachTile(dstSize, tileSize, [&](const Rect& tile)
+    {
+        // source area mapped into the tile
+        double xmin = DBL_MAX, ymin = DBL_MAX, xmax = -DBL_MAX, ymax = -DBL_MAX;
+        for (int k = 0; k < 4; k++)
+        {
+            double x = tile.x + ((k & 1) ? tile.width - 1 : 0);
+            double y = tile.y + ((k & 2) ? tile.height - 1 : 0);
+            double sx = M(0, 0) * x + M(0, 1) * y + M(0, 2);
+            double sy = M(1, 0) * x + M(1, 1) * y + M(1, 2);
+            xmin = std::min(xmin, sx); xmax = std::max(xmax, sx);
+            ymin = std::min(ymin, sy); ymax = std::max(ymax, sy);
+        }
+        // don't read more than the image with the border of interpolation support around it:
+        // constant and replicated borders beyond it are reproduced by remap itself.
+        // With the transparent border the pixels outside of the image must stay outside of the buffer.
+        const double lim = 1e9;
+        int x0 = cvFloor(std::max(xmin, -lim)) - support, x1 = cvCeil(std::min(xmax, lim)) + support + 1;
+        int y0 = cvFloor(std::max(ymin, -lim)) - support, y1 = cvCeil(std::min(ymax, lim)) + support + 1;
+        if (borderMode == BORDER_CONSTANT || borderMode == BORDER_REPLICATE || borderMode == BORDER_TRANSPARENT)
+        {
+            int margin = borderMode == BORDER_TRANSPARENT ? 0 : support;
+            x0 = std::min(std::max(x0, -margin), srcSize.width + margin - 1);
+            y0 = std::min(std::max(y0, -margin), srcSize.height + margin - 1);
+            x1 = std::max(std::min(x1, srcSize.width + margin), x0 + 1);
+            y1 = std::max(std::min(y1, srcSize.height + margin), y0 + 1);
+        }
+        Rect area(Point(x0, y0), Point(x1, y1));
+
+        Mat buf;
+        src.read(area, buf, borderMode == BORDER_TRANSPARENT ? BORDER_CONSTANT : borderMode, borderValue);
+        Mat dstTile;
+        if (borderMode == BORDER_TRANSPARENT)
+            dst.read(tile, dstTile);
+        else
+            dstTile.create(tile.size(), type);
+
+        // fixed-point coordinates are computed for the global destination position exactly as
+        // warpAffine() does it, so the result doesn't depend on the tiling
+        Mat XY(tile.size(), CV_16SC2), A;
+        if (interpolation != INTER_NEAREST)
+            A.create(tile.size(), CV_16UC1);
+        std::vector<short> xyrow(tile.width * 2);
+        for (int y = 0; y < tile.height; y++)
+        {
+            int X0 = saturate_cast<int>((M(0, 1) * (tile.y + y) + M(0, 2)) * AB_SCALE) + round_delta;
+            int Y0 = saturate_cast<int>((M(1, 1) * (tile.y + y) + M(1, 2)) * AB_SCALE) + round_delta;
+            int* ad = &adelta[tile.x];
+            int* bd = &bdelta[tile.x];
+            if (interpolation == INTER_NEAREST)
+                hal::warpAffineBlocklineNN(ad, bd, &xyrow[0], X0, Y0, tile.width);
+            else
+                hal::warpAffineBlockline(ad, bd, &xyrow[0], A.ptr<short>(y), X0, Y0, tile.width);
+            short* xy = XY.ptr<short>(y);
+            for (int x = 0; x < tile.width; x++)
+            {
+                xy[x * 2] = saturate_cast<short>(xyrow[x * 2] - area.x);
+                xy[x * 2 + 1] = saturate_cast<short>(xyrow[x * 2 + 1] - area.y);
+            }
+        }
+        remap(buf, dstTile, XY, A, interpolation, borderMode, borderValue);
+        dst.write(dstTile, tile.tl());
+    });
+}
+
+static bool isPixelwiseColorConversion(int code)
+{
+    return !((code >= COLOR_BayerBG2BGR && code <= COLOR_BayerGR2BGR) ||
+             (code >= COLOR_BayerBG2BGR_VNG && code <= COLOR_BayerGR2BGR_VNG) ||
+             (code >= COLOR_BayerBG2GRAY && code <= COLOR_BayerGR2GRAY) ||
+             (code >= COLOR_BayerBG2BGR_EA && code <= COLOR_BayerGR2BGRA) ||
+             (code >= COLOR_YUV2RGB_NV12 && code <= COLOR_YUV2GRAY_420) ||
+             (code >= COLOR_RGB2YUV_I420 && code <= COLOR_BGRA2YUV_YV12));
+}
+
+void tiledCvtColor(const TiledImage& src, TiledImage& dst, int code, Size tileSize)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert(isPixelwiseColorConversion(code) && "Demosaicing and YUV 4:2:0 conversions are not supported");
+    // 4:2:2 formats share chroma between pairs of pixels
+    tileSize.width = (tileSize.width + 1) & ~1;
+    processTiles(src, dst, [&](const Mat& srcTile, Mat& dstTile)
+    {
+        cvtColor(srcTile, dstTile, code);
+    }, 0, tileSize);
+}
+
+void tiledThreshold(const TiledImage& src, TiledImage& dst, double thresh, double maxval, int type, Size tileSize)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert((type & (THRESH_OTSU | THRESH_TRIANGLE)) == 0);
+    processTiles(src, dst, [&](const Mat& srcTile, Mat& dstTile)
+    {
+        threshold(srcTile, dstTile, thresh, maxval, type);
+    }, 0, tileSize);
+}
+
+} // namespace cv
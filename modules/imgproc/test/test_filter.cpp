@@ -2291,6 +2291,53 @@ TEST(Imgproc_MedianBlur, hires_regression_13409)
     ASSERT_EQ(0.0, cvtest::norm(dst_hires(Rect(516, 516, 1016, 1016)), dst_ref(Rect(4, 4, 1016, 1016)), NORM_INF));
 }
 
+template<typename T> static Mat medianBlurReference(const Mat& src, int ksize)
+{
+    const int cn = src.channels(), r = ksize / 2;
+    Mat padded, dst(src.size(), src.type());
+    cv::copyMakeBorder(src, padded, r, r, r, r, BORDER_REPLICATE);
+    std::vector<T> window(ksize * ksize);
+    for (int y = 0; y < src.rows; y++)
+        for (int x = 0; x < src.cols; x++)
+            for (int c = 0; c < cn; c++)
+            {
+                for (int i = 0, k = 0; i < ksize; i++)
+                    for (int j = 0; j < ksize; j++, k++)
+                        window[k] = padded.ptr<T>(y + i)[(x + j) * cn + c];
+                std::nth_element(window.begin(), window.begin() + window.size() / 2, window.end());
+                dst.ptr<T>(y)[x * cn + c] = window[window.size() / 2];
+            }
+    return dst;
+}
+
+TEST(Imgproc_MedianBlur, large_ksize_16u_16s_32f)
+{
+    RNG& rng = theRNG();
+    const int types[] = { CV_16UC1, CV_16UC3, CV_16SC1, CV_32FC1, CV_32FC3 };
+    for (int type : types)
+        for (int ksize : { 7, 15, 31 })
+            for (int range : { 10, 65536 })
+            {
+                SCOPED_TRACE(cv::format("type=%s ksize=%d range=%d", typeToString(type).c_str(), ksize, range));
+                const int depth = CV_MAT_DEPTH(type);
+                // the width exceeds the size of the tile used for the floating-point images
+                Mat src(Size(ksize == 31 ? 250 : 67, 45), type);
+                double lo = depth == CV_16U ? 0 : -range / 2;
+                rng.fill(src, RNG::UNIFORM, lo, lo + range);
+                if (depth == CV_32F)
+                    src *= 0.37;
+                Mat expected = depth == CV_16U ? medianBlurReference<ushort>(src, ksize) :
+                               depth == CV_16S ? medianBlurReference<short>(src, ksize) :
+                                                 medianBlurReference<float>(src, ksize);
+                Mat dst;
+                medianBlur(src, dst, ksize);
+                EXPECT_EQ(0, cvtest::norm(expected, dst, NORM_INF));
+
+                medianBlur(src, src, ksize);
+                EXPECT_EQ(0, cvtest::norm(expected, src, NORM_INF));
+            }
+}
+
 TEST(Imgproc_Sobel, s16_regression_13506)
 {
     Mat src = (Mat_<short>(8, 16) << 127, 138, 130, 102, 118,  97,  76,  84, 124,  90, 146,  63, 130,  87, 212,  85,
@@ -0,0 +1,136 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "test_precomp.hpp"
+#include "opencv2/imgproc/streaming.hpp"
+
+namespace opencv_test { namespace {
+
+// pushes the image by portions of random height, checks the latency and collects the output
+static Mat runStreaming(StreamingFilter& f, const Mat& src, RNG& rng, int maxPortion)
+{
+    f.start(src.size());
+    Mat dst(src.size(), f.dstType()), rows;
+    int y = 0, dy = 0;
+    while (y < src.rows)
+    {
+        int n = std::min(rng.uniform(1, maxPortion + 1), src.rows - y);
+        f.push(src.rowRange(y, y + n));
+        y += n;
+        for (int k = f.pull(rows); k > 0; k = f.pull(rows))
+        {
+            EXPECT_LE(dy + k, dst.rows);
+            rows.copyTo(dst.rowRange(dy, dy + k));
+            dy += k;
+        }
+        if (y < src.rows)
+        {
+            EXPECT_GE(dy, y - f.latency());
+        }
+    }
+    EXPECT_EQ(src.rows, dy);
+    EXPECT_TRUE(f.finished());
+    return dst;
+}
+
+typedef testing::TestWithParam<tuple<int, int> > Imgproc_StreamingFilter;
+
+TEST_P(Imgproc_StreamingFilter, accuracy)
+{
+    const int type = get<0>(GetParam());
+    const int borderType = get<1>(GetParam());
+    RNG& rng = theRNG();
+    Mat src(Size(97, 61), type);
+    rng.fill(src, RNG::UNIFORM, 0, 256);
+    const int depth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
+
+    for (int maxPortion : { 1, 4, 100 })
+    {
+        SCOPED_TRACE(cv::format("maxPortion=%d", maxPortion));
+        {
+            Ptr<StreamingFilter> f = createStreamingSobel(type, CV_MAKETYPE(CV_32F, cn), 1, 2, 5, 0.5, 1, borderType);
+            Mat expected;
+            Sobel(src, expected, CV_32F, 1, 2, 5, 0.5, 1, borderType);
+            EXPECT_LE(cvtest::norm(expected, runStreaming(*f, src, rng, maxPortion), NORM_INF), 1e-3);
+        }
+        {
+            Ptr<StreamingFilter> f = createStreamingGaussianFilter(type, Size(7, 5), 1.5, 0, borderType);
+            Mat expected;
+            GaussianBlur(src, expected, Size(7, 5), 1.5, 0, borderType);
+            EXPECT_LE(cvtest::norm(expected, runStreaming(*f, src, rng, maxPortion), NORM_INF), depth == CV_8U ? 1 : 1e-3);
+        }
+        {
+            Ptr<StreamingFilter> f = createStreamingBoxFilter(type, type, Size(5, 9), Point(1, 2), true, borderType);
+            Mat expected;
+            boxFilter(src, expected, -1, Size(5, 9), Point(1, 2), true, borderType);
+            EXPECT_LE(cvtest::norm(expected, runStreaming(*f, src, rng, maxPortion), NORM_INF), depth == CV_8U ? 0 : 1e-3);
+        }
+        {
+            Mat kernel = getStructuringElement(MORPH_ELLIPSE, Size(5, 5));
+            Ptr<StreamingFilter> f = createStreamingMorphologyFilter(MORPH_DILATE, type, kernel, Point(-1, -1), borderType);
+            Mat expected;
+            cv::dilate(src, expected, kernel, Point(-1, -1), 1, borderType);
+            EXPECT_EQ(0, cvtest::norm(expected, runStreaming(*f, src, rng, maxPortion), NORM_INF));
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_StreamingFilter, testing::Combine(
+    testing::Values(CV_8UC1, CV_8UC3, CV_32FC1),
+    testing::Values(BORDER_REPLICATE, BORDER_REFLECT_101, BORDER_CONSTANT)
+));
+
+TEST(Imgproc_StreamingChain, accuracy)
+{
+    RNG& rng = theRNG();
+    Mat src(Size(320, 240), CV_8UC1);
+    rng.fill(src, RNG::UNIFORM, 0, 256);
+
+    Ptr<StreamingFilter> f = createStreamingChain({
+        createStreamingGaussianFilter(CV_8UC1, Size(5, 5), 1.2),
+        createStreamingSobel(CV_8UC1, CV_16SC1, 1, 0),
+        createStreamingPointOperation(CV_16SC1, CV_8UC1, [](const Mat& s, Mat& d) { convertScaleAbs(s, d); }),
+        createStreamingThreshold(CV_8UC1, 100, 255, THRESH_BINARY)
+    });
+    EXPECT_EQ(CV_8UC1, f->srcType());
+    EXPECT_EQ(CV_8UC1, f->dstType());
+    EXPECT_EQ(3, f->latency());
+
+    Mat kx = getGaussianKernel(5, 1.2, CV_32F);
+    Mat blurred, dx, expected;
+    sepFilter2D(src, blurred, -1, kx, kx);
+    Sobel(blurred, dx, CV_16S, 1, 0);
+    convertScaleAbs(dx, expected);
+    cv::threshold(expected, expected, 100, 255, THRESH_BINARY);
+
+    // the same filter may be used for several frames
+    for (int iter = 0; iter < 2; iter++)
+    {
+        SCOPED_TRACE(cv::format("iter=%d", iter));
+        Mat actual = runStreaming(*f, src, rng, iter == 0 ? 1 : 17);
+        EXPECT_EQ(0, cvtest::norm(expected, actual, NORM_INF));
+    }
+
+    EXPECT_ANY_THROW(createStreamingChain({
+        createStreamingSobel(CV_8UC1, CV_16SC1, 1, 0),
+        createStreamingThreshold(CV_8UC1, 100, 255, THRESH_BINARY)
+    }));
+}
+
+TEST(Imgproc_StreamingChain, bad_input)
+{
+    Ptr<StreamingFilter> f = createStreamingBoxFilter(CV_8UC1, CV_8UC1, Size(3, 3));
+    f->start(Size(10, 5));
+    EXPECT_ANY_THROW(f->push(Mat(1, 11, CV_8UC1, Scalar(0))));
+    EXPECT_ANY_THROW(f->push(Mat(1, 10, CV_16SC1, Scalar(0))));
+    EXPECT_ANY_THROW(f->push(Mat(6, 10, CV_8UC1, Scalar(0))));
+    f->push(Mat(5, 10, CV_8UC1, Scalar(1)));
+    Mat out;
+    EXPECT_EQ(5, f->pull(out));
+    EXPECT_TRUE(f->finished());
+    EXPECT_EQ(0, f->pull(out));
+    EXPECT_TRUE(out.empty());
+}
+
+}} // namespace
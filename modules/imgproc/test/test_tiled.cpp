@@ -0,0 +1,201 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "test_precomp.hpp"
+#include "opencv2/imgproc/tiled.hpp"
+
+namespace opencv_test { namespace {
+
+struct TempTiledImage
+{
+    TempTiledImage(Size size, int type)
+    {
+        filename = cv::tempfile(".tiled");
+        image.create(filename, size, type);
+    }
+    TempTiledImage(const Mat& m)
+    {
+        filename = cv::tempfile(".tiled");
+        image.create(filename, m.size(), m.type());
+        image.write(m, Point());
+    }
+    ~TempTiledImage()
+    {
+        image.release();
+        remove(filename.c_str());
+    }
+    Mat load() const
+    {
+        Mat m;
+        image.read(Rect(Point(), image.size()), m);
+        return m;
+    }
+
+    String filename;
+    TiledImage image;
+};
+
+static Mat makeRandomImage(Size size, int type)
+{
+    Mat m(size, type);
+    theRNG().fill(m, RNG::UNIFORM, 0, 256);
+    return m;
+}
+
+TEST(Imgproc_TiledImage, read_write)
+{
+    Mat src = makeRandomImage(Size(101, 67), CV_8UC3);
+    String filename;
+    {
+        TempTiledImage img(src.size(), src.type());
+        filename = img.filename;
+        // write by blocks of an odd size
+        for (int y = 0; y < src.rows; y += 20)
+            for (int x = 0; x < src.cols; x += 33)
+            {
+                Rect r = Rect(x, y, 33, 20) & Rect(Point(), src.size());
+                img.image.write(src(r), r.tl());
+            }
+
+        TiledImage reopened;
+        reopened.open(filename);
+        ASSERT_EQ(src.size(), reopened.size());
+        ASSERT_EQ(src.type(), reopened.type());
+
+        Mat whole;
+        reopened.read(Rect(Point(), src.size()), whole);
+        EXPECT_EQ(0, cvtest::norm(src, whole, NORM_INF));
+
+        const int borders[] = { BORDER_CONSTANT, BORDER_REPLICATE, BORDER_REFLECT, BORDER_REFLECT_101 };
+        const Rect rois[] = { Rect(-5, -7, 30, 20), Rect(90, 60, 20, 15), Rect(-3, 10, 110, 5), Rect(200, 200, 4, 4) };
+        for (int border : borders)
+            for (const Rect& roi : rois)
+            {
+                SCOPED_TRACE(cv::format("border=%d roi=(%d, %d, %d, %d)", border, roi.x, roi.y, roi.width, roi.height));
+                if (border != BORDER_CONSTANT && (roi & Rect(Point(), src.size())).empty())
+                    continue;
+                const Scalar value(1, 2, 3);
+                Mat expected;
+                int pad = 200;
+                cv::copyMakeBorder(src, expected, pad, pad, pad, pad, border, value);
+                expected = expected(roi + Point(pad, pad));
+                Mat actual;
+                reopened.read(roi, actual, border, value);
+                EXPECT_EQ(0, cvtest::norm(expected, actual, NORM_INF));
+            }
+        EXPECT_ANY_THROW(reopened.write(src, Point()));
+    }
+    TiledImage missing;
+    EXPECT_ANY_THROW(missing.open(filename));
+}
+
+typedef testing::TestWithParam<tuple<int, Size> > Imgproc_Tiled_Filter;
+
+TEST_P(Imgproc_Tiled_Filter, sepFilter2D_and_GaussianBlur)
+{
+    const int type = get<0>(GetParam());
+    const Size tileSize = get<1>(GetParam());
+    Mat src = makeRandomImage(Size(153, 97), type);
+    TempTiledImage tsrc(src);
+
+    {
+        Mat kx = (Mat_<float>(1, 5) << 0.1f, 0.2f, 0.4f, 0.2f, 0.1f);
+        Mat ky = (Mat_<float>(1, 3) << -1.f, 0.f, 1.f);
+        TempTiledImage tdst(src.size(), CV_MAKETYPE(CV_32F, src.channels()));
+        tiledSepFilter2D(tsrc.image, tdst.image, kx, ky, Point(-1, -1), 3, BORDER_REFLECT, tileSize);
+        Mat expected;
+        sepFilter2D(src, expected, CV_32F, kx, ky, Point(-1, -1), 3, BORDER_REFLECT);
+        EXPECT_LE(cvtest::norm(expected, tdst.load(), NORM_INF), 1e-3);
+    }
+    for (int border : { BORDER_REPLICATE, BORDER_REFLECT_101 })
+    {
+        SCOPED_TRACE(cv::format("border=%d", border));
+        TempTiledImage tdst(src.size(), type);
+        tiledGaussianBlur(tsrc.image, tdst.image, Size(0, 0), 2.5, 1.5, border, tileSize);
+        Mat expected;
+        GaussianBlur(src, expected, Size(0, 0), 2.5, 1.5, border);
+        EXPECT_LE(cvtest::norm(expected, tdst.load(), NORM_INF), CV_MAT_DEPTH(type) == CV_8U ? 1 : 1e-3);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_Tiled_Filter, testing::Combine(
+    testing::Values(CV_8UC1, CV_8UC3, CV_32FC1),
+    testing::Values(Size(37, 29), Size(64, 64), Size(512, 512))
+));
+
+TEST(Imgproc_Tiled, cvtColor_threshold)
+{
+    Mat src = makeRandomImage(Size(150, 81), CV_8UC3);
+    TempTiledImage tsrc(src);
+
+    {
+        TempTiledImage tdst(src.size(), CV_8UC1);
+        tiledCvtColor(tsrc.image, tdst.image, COLOR_BGR2GRAY, Size(33, 17));
+        Mat expected;
+        cvtColor(src, expected, COLOR_BGR2GRAY);
+        EXPECT_EQ(0, cvtest::norm(expected, tdst.load(), NORM_INF));
+    }
+    {
+        TempTiledImage tdst(src.size(), CV_8UC3);
+        tiledCvtColor(tsrc.image, tdst.image, COLOR_BGR2HSV, Size(40, 40));
+        Mat expected;
+        cvtColor(src, expected, COLOR_BGR2HSV);
+        EXPECT_EQ(0, cvtest::norm(expected, tdst.load(), NORM_INF));
+    }
+    {
+        TempTiledImage tdst(src.size(), CV_8UC2);
+        tiledCvtColor(tsrc.image, tdst.image, COLOR_BGR2YUV_YUY2, Size(33, 17));
+        Mat expected;
+        cvtColor(src, expected, COLOR_BGR2YUV_YUY2);
+        EXPECT_EQ(0, cvtest::norm(expected, tdst.load(), NORM_INF));
+    }
+    {
+        TempTiledImage tdst(src.size(), CV_8UC3);
+        tiledThreshold(tsrc.image, tdst.image, 100, 200, THRESH_BINARY, Size(33, 17));
+        Mat expected;
+        cv::threshold(src, expected, 100, 200, THRESH_BINARY);
+        EXPECT_EQ(0, cvtest::norm(expected, tdst.load(), NORM_INF));
+
+        EXPECT_ANY_THROW(tiledThreshold(tsrc.image, tdst.image, 0, 255, THRESH_BINARY | THRESH_OTSU));
+        EXPECT_ANY_THROW(tiledCvtColor(tsrc.image, tdst.image, COLOR_BayerBG2BGR));
+    }
+}
+
+TEST(Imgproc_Tiled, warpAffine)
+{
+    Mat src = makeRandomImage(Size(120, 90), CV_8UC3);
+    TempTiledImage tsrc(src);
+    const Size dsize(140, 100);
+    Mat M = getRotationMatrix2D(Point2f(60, 45), 30, 1.2);
+    M.at<double>(0, 2) += 10;
+
+    const int interpolations[] = { INTER_NEAREST, INTER_LINEAR, INTER_CUBIC };
+    const int borders[] = { BORDER_CONSTANT, BORDER_REPLICATE, BORDER_REFLECT, BORDER_TRANSPARENT };
+    for (int interpolation : interpolations)
+        for (int border : borders)
+        {
+            SCOPED_TRACE(cv::format("interpolation=%d border=%d", interpolation, border));
+            TempTiledImage tdst(dsize, src.type());
+            tiledWarpAffine(tsrc.image, tdst.image, M, interpolation, border, Scalar(10, 20, 30), Size(32, 24));
+            Mat expected = Mat::zeros(dsize, src.type());  // the new TiledImage is zero-filled
+            warpAffine(src, expected, M, dsize, interpolation, border, Scalar(10, 20, 30));
+            EXPECT_EQ(0, cvtest::norm(expected, tdst.load(), NORM_INF));
+        }
+}
+
+TEST(Imgproc_Tiled, processTiles)
+{
+    Mat src = makeRandomImage(Size(100, 70), CV_8UC1);
+    TempTiledImage tsrc(src);
+    TempTiledImage tdst(src.size(), CV_16SC1);
+    processTiles(tsrc.image, tdst.image, [](const Mat& s, Mat& d)
+    {
+        Sobel(s, d, CV_16S, 1, 1, 5);
+    }, 2, Size(30, 20));
+    Mat expected;
+    Sobel(src, expected, CV_16S, 1, 1, 5);
+    EXPECT_EQ(0, cvtest::norm(expected, tdst.load(), NORM_INF));
+}
+
+}} // namespace